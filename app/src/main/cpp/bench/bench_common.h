@@ -0,0 +1,19 @@
+#ifndef NATIVE_ACTIVITY_BENCH_COMMON_H
+#define NATIVE_ACTIVITY_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <time.h>
+
+// 单调时钟（纳秒）
+static inline int64_t bench_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// 防止编译器把基准结果当作死代码删除：空的内联汇编声明读了 value，不产生任何指令
+static inline void bench_consume(float value) {
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+#endif //NATIVE_ACTIVITY_BENCH_COMMON_H
@@ -0,0 +1,67 @@
+#ifndef NATIVE_ACTIVITY_BENCH_EGL_H
+#define NATIVE_ACTIVITY_BENCH_EGL_H
+
+// 宿主机上的离屏 GLES 上下文（Mesa llvmpipe 等软件实现即可）
+
+#include <EGL/egl.h>
+#include <cstdio>
+#include <cstdlib>
+
+struct BenchEgl {
+    EGLDisplay display;
+    EGLSurface surface;
+    EGLContext context;
+};
+
+// 依次尝试 ES 3.2/3.1/3.0，创建 width x height 的 pbuffer 并设为当前，成功返回 true
+static inline bool bench_egl_init(BenchEgl *egl, int width, int height) {
+    // 没有窗口系统的 CI 机器上让 Mesa 走 surfaceless 平台
+    setenv("EGL_PLATFORM", "surfaceless", 0);
+    egl->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (egl->display == EGL_NO_DISPLAY || !eglInitialize(egl->display, nullptr, nullptr)) {
+        fprintf(stderr, "eglInitialize failed\n");
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, 0x0040, // EGL_OPENGL_ES3_BIT
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(egl->display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        fprintf(stderr, "no ES3 pbuffer config\n");
+        return false;
+    }
+    egl->context = EGL_NO_CONTEXT;
+    const EGLint minors[] = {2, 1, 0};
+    for (EGLint minor : minors) {
+        const EGLint contextAttribs[] = {
+            0x3098, 3,     // EGL_CONTEXT_MAJOR_VERSION
+            0x30FB, minor, // EGL_CONTEXT_MINOR_VERSION
+            EGL_NONE
+        };
+        egl->context = eglCreateContext(egl->display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (egl->context != EGL_NO_CONTEXT) {
+            break;
+        }
+    }
+    if (egl->context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "eglCreateContext failed\n");
+        return false;
+    }
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+    egl->surface = eglCreatePbufferSurface(egl->display, config, surfaceAttribs);
+    return eglMakeCurrent(egl->display, egl->surface, egl->surface, egl->context) == EGL_TRUE;
+}
+
+static inline void bench_egl_term(BenchEgl *egl) {
+    eglMakeCurrent(egl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(egl->display, egl->surface);
+    eglDestroyContext(egl->display, egl->context);
+    eglTerminate(egl->display);
+}
+
+#endif //NATIVE_ACTIVITY_BENCH_EGL_H
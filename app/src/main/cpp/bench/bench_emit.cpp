@@ -0,0 +1,101 @@
+// 发射器基准：原逐粒子 explode（rand + cosf/sinf + 逐个写入）vs 批量圆形爆发
+// 同时校验 SIMD sincos 相对 libm 的最大误差。
+// 用法：bench_emit [每次爆炸粒子数]
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "particle_emitter.h"
+#include "particle_spawn.h"
+
+#define EXPLOSIONS 2000
+
+// 原 main.cpp 中的 explode（写入发射缓冲的版本）
+static void legacy_explode(ParticleSpawnBuffer *buffer, int count, float x, float y) {
+    for (int i = 0; i < count; i++) {
+        Particle p;
+        p.x = x;
+        p.y = y;
+        float angle = ((float) rand() / RAND_MAX) * 2.0f * M_PI;
+        float speed = ((float) rand() / RAND_MAX) * 1.5f + 0.5f;
+        p.vx = cosf(angle) * speed;
+        p.vy = sinf(angle) * speed;
+        p.ax = 0.0f;
+        p.ay = 0.5f;
+        p.r = p.g = p.b = 1.0f;
+        p.a = 1.0f;
+        p.size = ((float) rand() / RAND_MAX) * 6.0f + 4.0f;
+        p.life = ((float) rand() / RAND_MAX) * 1.5f + 0.8f;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = 1.0f;
+        p.type = PARTICLE_EXPLOSION;
+        particle_spawn_push(buffer, &p);
+    }
+}
+
+static float sincos_error(float lo, float hi, int samples) {
+    std::vector<float> angles(samples), sines(samples), cosines(samples);
+    for (int i = 0; i < samples; i++) {
+        angles[i] = lo + (hi - lo) * (float) i / (float) samples;
+    }
+    particle_sincos(angles.data(), sines.data(), cosines.data(), samples);
+    double maxError = 0.0;
+    for (int i = 0; i < samples; i++) {
+        maxError = fmax(maxError, fabs(sines[i] - sin((double) angles[i])));
+        maxError = fmax(maxError, fabs(cosines[i] - cos((double) angles[i])));
+    }
+    return (float) maxError;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 350;
+
+    ParticleSpawnBuffer buffer;
+    if (particle_spawn_init(&buffer, count) != 0) {
+        fprintf(stderr, "alloc failed\n");
+        return 1;
+    }
+
+    srand(1);
+    int64_t start = bench_now_ns();
+    for (int e = 0; e < EXPLOSIONS; e++) {
+        particle_spawn_reset(&buffer);
+        legacy_explode(&buffer, count, 0.1f, 0.2f);
+    }
+    double legacyNs = (double) (bench_now_ns() - start) / EXPLOSIONS;
+    bench_consume(buffer.staged.vx[count - 1]);
+
+    ParticleEmitter emitter = {0.1f, 0.2f, 0.0f, 0.0f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f,
+                               4.0f, 10.0f, 0.8f, 2.3f, 1.0f, 1.0f, PARTICLE_EXPLOSION};
+    ParticleRandom rng;
+    particle_random_seed(&rng, 1, 0);
+    start = bench_now_ns();
+    for (int e = 0; e < EXPLOSIONS; e++) {
+        particle_spawn_reset(&buffer);
+        particle_emit_burst(&buffer, &emitter, 0.5f, 2.0f, count, &rng);
+    }
+    double batchNs = (double) (bench_now_ns() - start) / EXPLOSIONS;
+    bench_consume(buffer.staged.vx[count - 1]);
+
+    // 速度方向应为单位向量乘 [0.5, 2) 的速度
+    int bad = 0;
+    for (int i = 0; i < buffer.staged.count; i++) {
+        float speed = sqrtf(buffer.staged.vx[i] * buffer.staged.vx[i] + buffer.staged.vy[i] * buffer.staged.vy[i]);
+        bad += !(speed >= 0.5f - 1e-5f && speed < 2.0f + 1e-5f);
+    }
+
+    float errorTurn = sincos_error(0.0f, 6.2831853f, 1 << 20);
+    float errorWide = sincos_error(-1000.0f, 1000.0f, 1 << 22);
+
+    printf("%d particles per explosion\n", count);
+    printf("%-16s %10.2f us/explosion %8.2f ns/particle\n", "legacy", legacyNs * 1e-3, legacyNs / count);
+    printf("%-16s %10.2f us/explosion %8.2f ns/particle  (%.1fx)\n", "batched burst", batchNs * 1e-3,
+           batchNs / count, legacyNs / batchNs);
+    printf("sincos max abs error: [0, 2pi] %.2e  [-1000, 1000] %.2e  speed out of range %d\n",
+           errorTurn, errorWide, bad);
+    particle_spawn_free(&buffer);
+    return (bad == 0 && errorTurn < 3e-7f && errorWide < 3e-7f) ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// 满池压力基准：发射量超过容量时，原线性扫描替换 vs 过期时间桶环替换
+// 每帧：积分 + 移除死亡粒子 + 发射 N 个新粒子，输出每帧耗时和每次发射的耗时。
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "legacy_particles.h"
+#include "particle_pool.h"
+
+#define CAPACITY     8000
+#define WARMUP_FRAMES 60
+
+static uint32_t rng_state = 12345;
+
+static float frand() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float) (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static Particle make_particle() {
+    Particle p;
+    p.x = frand() * 2.0f - 1.0f;
+    p.y = frand() * 2.0f - 1.0f;
+    p.vx = frand() - 0.5f;
+    p.vy = frand() - 0.5f;
+    p.ax = 0.0f;
+    p.ay = 0.5f;
+    p.r = p.g = p.b = p.a = 1.0f;
+    p.size = 4.0f;
+    p.life = frand() * 2.6f + 0.4f;
+    p.maxLife = p.life;
+    p.alphaScale = 1.0f;
+    p.sizeDecay = 1.0f;
+    p.type = PARTICLE_EXPLOSION;
+    return p;
+}
+
+// 校验过期链表：每个存活粒子恰好出现在一个桶里
+static bool check_expiry_index(const ParticlePool *pool) {
+    int linked = 0;
+    for (int b = 0; b < PARTICLE_EXPIRY_BUCKETS; b++) {
+        int prev = -1;
+        for (int i = pool->expiryHeads[b]; i >= 0; i = pool->expiryNext[i]) {
+            if (i >= pool->count || pool->expiryPrev[i] != prev || pool->expiryBucket[i] != b) {
+                return false;
+            }
+            prev = i;
+            linked++;
+        }
+    }
+    return linked == pool->count;
+}
+
+static double run_legacy(int emitPerFrame, int frames) {
+    const float dt = 1.0f / 60.0f;
+    std::vector<LegacyParticle> particles(CAPACITY);
+    int count = 0;
+    int64_t total = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++) {
+        int64_t start = bench_now_ns();
+        legacy_update(particles.data(), &count, dt);
+        for (int i = 0; i < emitPerFrame; i++) {
+            legacy_add(particles.data(), &count, CAPACITY, legacy_from(make_particle()));
+        }
+        if (frame >= WARMUP_FRAMES) {
+            total += bench_now_ns() - start;
+        }
+    }
+    bench_consume(particles[0].x);
+    return (double) total / frames;
+}
+
+static double run_pool(int emitPerFrame, int frames, int *evictions) {
+    const float dt = 1.0f / 60.0f;
+    ParticlePool pool;
+    if (particle_pool_init(&pool, CAPACITY) != 0) {
+        fprintf(stderr, "pool alloc failed\n");
+        exit(1);
+    }
+    int64_t total = 0;
+    for (int frame = 0; frame < WARMUP_FRAMES + frames; frame++) {
+        int64_t start = bench_now_ns();
+        particle_integrate(&pool, dt);
+        for (int i = pool.count - 1; i >= 0; i--) {
+            if (pool.life[i] <= 0.0f) {
+                particle_pool_remove(&pool, i);
+            }
+        }
+        for (int i = 0; i < emitPerFrame; i++) {
+            Particle p = make_particle();
+            particle_pool_emit(&pool, &p);
+        }
+        if (frame >= WARMUP_FRAMES) {
+            total += bench_now_ns() - start;
+        }
+    }
+    if (!check_expiry_index(&pool)) {
+        fprintf(stderr, "expiry index corrupted\n");
+        exit(1);
+    }
+    *evictions = pool.evictions;
+    bench_consume(pool.x[0]);
+    particle_pool_free(&pool);
+    return (double) total / frames;
+}
+
+int main() {
+    printf("capacity %d\n", CAPACITY);
+    printf("%10s  %12s  %12s  %12s  %12s  %10s\n",
+           "emit/frame", "legacy ms/f", "ring ms/f", "legacy ns/e", "ring ns/e", "evictions");
+    const int rates[] = {100, 1000, 4000, 8000, 16000, 32000};
+    for (int rate : rates) {
+        // 线性扫描在高发射量下每帧代价很高，减少帧数
+        int frames = rate >= 4000 ? 20 : 200;
+        int evictions = 0;
+        double legacy = run_legacy(rate, frames);
+        double ring = run_pool(rate, frames, &evictions);
+        printf("%10d  %12.3f  %12.3f  %12.1f  %12.1f  %10d\n", rate,
+               legacy * 1e-6, ring * 1e-6, legacy / rate, ring / rate, evictions);
+    }
+    return 0;
+}
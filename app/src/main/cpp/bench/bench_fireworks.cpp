@@ -0,0 +1,176 @@
+// 无界面烟花场景基准：用固定种子、固定步长跑完整场景（火箭 → 爆炸 → 文字），不需要设备和 GL
+// 用法：bench_fireworks [帧数=700] [种子=1] [线程数=0(全部核心)] [点云.gpc 或 -] [期望校验和]
+// 输出各阶段（发射 / 更新 / 打包 / 打包 + 剔除合并）每帧耗时分布、剔除统计、粒子数随时间的曲线和最终状态的校验和。
+// 给出期望校验和时不一致则返回 1，可直接在 CI 上捕捉行为变化；耗时只用于人工比较。
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_common.h"
+#include "fireworks_sim.h"
+
+// 与 main.cpp 保持一致
+#define MAX_PARTICLES 8000
+#define SPAWN_BUDGET  2048
+#define SIM_DT        (1.0f / 60.0f)
+#define ASPECT        (1080.0f / 2400.0f)   // 竖屏手机
+#define HEIGHT_PX     2400.0f
+#define CURVE_POINTS  24
+
+enum { PHASE_SPAWN, PHASE_UPDATE, PHASE_PACK, PHASE_CULL, PHASE_COUNT };
+static const char *kPhaseNames[PHASE_COUNT] = {"spawn", "update", "pack", "pack+lod"};
+
+static double percentile(std::vector<int64_t> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    size_t index = (size_t) (p * (double) (samples.size() - 1) + 0.5);
+    return (double) samples[index] * 1e-3;
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 700; // 停在文字阶段中段，校验和覆盖文字粒子
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    const char *cloudPath = argc > 4 && strcmp(argv[4], "-") != 0 ? argv[4] : nullptr;
+    const char *expected = argc > 5 ? argv[5] : nullptr;
+    if (frames <= 0) {
+        fprintf(stderr, "frame count must be positive\n");
+        return 1;
+    }
+
+    JobSystem *jobs = job_system_create(threads);
+    FireworksSim sim;
+    if (jobs == nullptr || fireworks_sim_init(&sim, MAX_PARTICLES, MAX_PARTICLES, SPAWN_BUDGET, jobs, seed) != 0) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+    sim.aspect = ASPECT;
+
+    // 点云用 mmap 零拷贝加载，与设备上 AAsset_getBuffer 的访问方式相同
+    void *mapped = nullptr;
+    size_t mappedSize = 0;
+    if (cloudPath != nullptr) {
+        int fd = open(cloudPath, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "cannot open %s\n", cloudPath);
+            return 1;
+        }
+        mappedSize = (size_t) st.st_size;
+        mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        GlyphCloud cloud;
+        if (mapped == MAP_FAILED || glyph_cloud_view(mapped, mappedSize, &cloud) != 0) {
+            fprintf(stderr, "%s is not a glyph cloud\n", cloudPath);
+            return 1;
+        }
+        fireworks_sim_set_text_cloud(&sim, &cloud);
+    }
+
+    std::vector<ParticleVertex> vertices(MAX_PARTICLES);
+    std::vector<int64_t> phaseNs[PHASE_COUNT];
+    for (auto &samples : phaseNs) {
+        samples.reserve(frames);
+    }
+    std::vector<int> counts(frames);
+    int textFrame = -1, finishedFrame = -1, peak = 0;
+
+    // 与 main.cpp 的 merge 模式相同的剔除参数
+    ParticleCullParams cull = {-ASPECT, ASPECT, -1.0f, 1.0f, HEIGHT_PX * 0.5f, 1.0f, 0.5f / 255.0f, 8.0f};
+    ParticleCullStats cullStats = {};
+    std::vector<ParticleVertex> culled(MAX_PARTICLES);
+
+    const int64_t start = bench_now_ns();
+    for (int frame = 0; frame < frames; frame++) {
+        int64_t t0 = bench_now_ns();
+        int events = fireworks_sim_spawn(&sim, SIM_DT);
+        int64_t t1 = bench_now_ns();
+        fireworks_sim_update(&sim, SIM_DT);
+        int64_t t2 = bench_now_ns();
+        fireworks_sim_pack(&sim, 1.0f, nullptr, vertices.data(), nullptr);
+        int64_t t3 = bench_now_ns();
+        fireworks_sim_pack(&sim, 1.0f, &cull, culled.data(), &cullStats);
+        int64_t t4 = bench_now_ns();
+
+        phaseNs[PHASE_SPAWN].push_back(t1 - t0);
+        phaseNs[PHASE_UPDATE].push_back(t2 - t1);
+        phaseNs[PHASE_PACK].push_back(t3 - t2);
+        phaseNs[PHASE_CULL].push_back(t4 - t3);
+        counts[frame] = sim.particles.count;
+        peak = std::max(peak, sim.particles.count);
+        if (events & FIREWORKS_EVENT_TEXT) {
+            textFrame = frame;
+        }
+        if (events & FIREWORKS_EVENT_FINISHED) {
+            finishedFrame = frame;
+        }
+    }
+    // 剔除阶段不影响模拟状态，总时间里只计一种打包方式
+    int64_t cullNs = 0;
+    for (int64_t ns : phaseNs[PHASE_CULL]) {
+        cullNs += ns;
+    }
+    const double totalMs = (double) (bench_now_ns() - start - cullNs) * 1e-6;
+    if (sim.particles.count > 0) {
+        bench_consume((float) vertices[sim.particles.count - 1].size);
+    }
+
+    printf("fireworks: %d frames at %.4f s, seed %" PRIu64 ", %d threads, text %s\n", frames, SIM_DT, seed,
+           job_system_thread_count(jobs), sim.textCloud.count > 0 ? "glyph cloud" : "procedural");
+    printf("%-8s %10s %10s %10s %10s   (us/frame)\n", "phase", "mean", "p50", "p95", "max");
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        const std::vector<int64_t> &samples = phaseNs[phase];
+        int64_t sum = 0;
+        for (int64_t ns : samples) {
+            sum += ns;
+        }
+        printf("%-8s %10.2f %10.2f %10.2f %10.2f\n", kPhaseNames[phase], (double) sum / frames * 1e-3,
+               percentile(samples, 0.50), percentile(samples, 0.95), percentile(samples, 1.0));
+    }
+    printf("total %.2f ms (%.2f us/frame)\n", totalMs, totalMs * 1e3 / frames);
+    double input = cullStats.input > 0 ? (double) cullStats.input : 1.0;
+    printf("lod: %lld particles -> %lld vertices (%.1f%%): offscreen %lld, faint %lld, tiny %lld -> %lld aggregates\n\n",
+           (long long) cullStats.input, (long long) cullStats.output, 100.0 * cullStats.output / input,
+           (long long) cullStats.offscreen, (long long) cullStats.faint, (long long) cullStats.tiny,
+           (long long) cullStats.aggregates);
+
+    // 粒子数曲线：每段取段内最大值，条形按峰值归一化
+    printf("%8s %8s %8s\n", "frame", "time", "count");
+    int segment = (frames + CURVE_POINTS - 1) / CURVE_POINTS;
+    for (int begin = 0; begin < frames; begin += segment) {
+        int end = std::min(begin + segment, frames), segmentPeak = 0;
+        for (int frame = begin; frame < end; frame++) {
+            segmentPeak = std::max(segmentPeak, counts[frame]);
+        }
+        char bar[41];
+        int width = peak > 0 ? segmentPeak * 40 / peak : 0;
+        memset(bar, '#', width);
+        bar[width] = '\0';
+        printf("%8d %7.2fs %8d %s\n", end - 1, (float) end * SIM_DT, segmentPeak, bar);
+    }
+    printf("peak %d particles, text at frame %d, finished at frame %d\n", peak, textFrame, finishedFrame);
+    printf("spawn requests dropped %d, pool evictions %d\n", sim.spawns.dropped, sim.particles.evictions);
+
+    uint64_t checksum = fireworks_sim_checksum(&sim);
+    printf("checksum %016" PRIx64 " (%d particles)\n", checksum, sim.particles.count);
+
+    int status = 0;
+    if (expected != nullptr && strtoull(expected, nullptr, 16) != checksum) {
+        fprintf(stderr, "checksum mismatch: expected %s\n", expected);
+        status = 1;
+    }
+
+    fireworks_sim_free(&sim);
+    job_system_destroy(jobs);
+    if (mapped != nullptr) {
+        munmap(mapped, mappedSize);
+    }
+    return status;
+}
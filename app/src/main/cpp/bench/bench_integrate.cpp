@@ -0,0 +1,101 @@
+// 粒子积分基准：原 AoS 循环 vs SoA 标量 vs SoA SIMD
+// 输出每个粒子的平均耗时（ns/particle）。
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "legacy_particles.h"
+#include "particle_pool.h"
+
+static Particle make_particle(int i) {
+    Particle p;
+    p.x = (float) (i % 97) * 0.01f;
+    p.y = (float) (i % 89) * 0.01f;
+    p.vx = 0.1f;
+    p.vy = 0.2f;
+    p.ax = 0.0f;
+    p.ay = 0.5f;
+    p.r = p.g = p.b = p.a = 1.0f;
+    p.size = 4.0f;
+    p.life = 1.0e6f;
+    p.maxLife = 1.0e6f;
+    p.type = (i % 3 == 0) ? PARTICLE_TRAIL : PARTICLE_EXPLOSION;
+    p.alphaScale = p.type == PARTICLE_TRAIL ? 0.8f : 1.0f;
+    p.sizeDecay = p.type == PARTICLE_TRAIL ? 0.95f : 1.0f;
+    return p;
+}
+
+// 每轮 64 步后重置数据（不计时），避免尾迹尺寸反复 *0.95 衰减成非规格化数
+#define STEPS_PER_ROUND 64
+
+static int rounds_for(int count) {
+    // 每个规模大约处理 2 亿次粒子更新
+    int rounds = 200000000 / STEPS_PER_ROUND / count;
+    return rounds < 2 ? 2 : rounds;
+}
+
+static void reset(std::vector<LegacyParticle> &legacy, ParticlePool *pool, int count) {
+    particle_pool_clear(pool);
+    for (int i = 0; i < count; i++) {
+        Particle p = make_particle(i);
+        legacy[i] = legacy_from(p);
+        particle_pool_emit(pool, &p);
+    }
+}
+
+static void run(int count) {
+    const float dt = 1.0f / 60.0f;
+    int rounds = rounds_for(count);
+
+    std::vector<LegacyParticle> legacy(count);
+    int legacyCount = count;
+    ParticlePool pool;
+    if (particle_pool_init(&pool, count) != 0) {
+        fprintf(stderr, "pool alloc failed (%d)\n", count);
+        exit(1);
+    }
+
+    int64_t aosNs = 0, scalarNs = 0, simdNs = 0;
+    for (int round = 0; round < rounds; round++) {
+        reset(legacy, &pool, count);
+        int64_t start = bench_now_ns();
+        for (int step = 0; step < STEPS_PER_ROUND; step++) {
+            legacy_update(legacy.data(), &legacyCount, dt);
+        }
+        aosNs += bench_now_ns() - start;
+        bench_consume(legacy[count / 2].x);
+
+        reset(legacy, &pool, count);
+        start = bench_now_ns();
+        for (int step = 0; step < STEPS_PER_ROUND; step++) {
+            particle_integrate_scalar(&pool, dt);
+        }
+        scalarNs += bench_now_ns() - start;
+        bench_consume(pool.x[count / 2]);
+
+        reset(legacy, &pool, count);
+        start = bench_now_ns();
+        for (int step = 0; step < STEPS_PER_ROUND; step++) {
+            particle_integrate(&pool, dt);
+        }
+        simdNs += bench_now_ns() - start;
+        bench_consume(pool.x[count / 2]);
+    }
+
+    double updates = (double) rounds * STEPS_PER_ROUND * count;
+    double aos = (double) aosNs / updates;
+    double soaScalar = (double) scalarNs / updates;
+    double soaSimd = (double) simdNs / updates;
+    printf("%9d  %10.3f  %10.3f  %10.3f  %6.2fx\n", count, aos, soaScalar, soaSimd, aos / soaSimd);
+    particle_pool_free(&pool);
+}
+
+int main() {
+    printf("%9s  %10s  %10s  %10s  %7s\n", "particles", "aos ns/p", "soa ns/p", "simd ns/p", "speedup");
+    const int counts[] = {8000, 100000, 1000000};
+    for (int count : counts) {
+        run(count);
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+// 交互力基准：均匀网格碰撞、触摸吸引点和边缘反弹（宿主机）
+// 用 5 万个爆炸粒子（四团火花加均匀分布的背景）跑模拟的更新步骤，分别测：
+//   plain      只积分
+//   attract    4 个吸引/排斥点
+//   full       4 个吸引点 + 火花碰撞（每步重建网格）+ 边缘反弹
+// 各配置先单线程（对应“一个中端核心”）再用全部核心，输出每步耗时和相对 60 Hz 帧预算的占比，
+// 另外单独给出网格重建的耗时。单线程与多线程的最终状态校验和必须一致，否则返回 1。
+// 用法：bench_interact [粒子数=50000] [步数=300]
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "fireworks_sim.h"
+
+#define SIM_DT        (1.0f / 60.0f)
+#define FRAME_BUDGET_US (1e6 / 60.0)
+#define ASPECT        (1080.0f / 2400.0f)
+#define HEIGHT_PX     2400.0f
+
+// 与 main.cpp 的 full 模式相同
+#define COLLISION_RADIUS    (8.0f / (HEIGHT_PX * 0.5f))
+#define COLLISION_STIFFNESS 4.0f
+#define RESTITUTION         0.6f
+
+enum { MODE_PLAIN, MODE_ATTRACT, MODE_FULL, MODE_COUNT };
+static const char *kModeNames[MODE_COUNT] = {"plain", "attract", "full"};
+
+static uint32_t rng_state;
+
+static float frand() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float) (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// 四团火花（各占 20%，半径 0.15 内密度向中心增大）加 20% 均匀背景
+static void fill(ParticlePool *pool, int count) {
+    static const float kCenters[4][2] = {{-0.2f, 0.5f}, {0.25f, 0.3f}, {-0.1f, -0.2f}, {0.2f, -0.6f}};
+    particle_pool_clear(pool);
+    rng_state = 11;
+    for (int i = 0; i < count; i++) {
+        Particle p;
+        int cluster = i % 5;
+        if (cluster < 4) {
+            float angle = frand() * 6.2831853f, radius = frand() * frand() * 0.15f;
+            p.x = kCenters[cluster][0] + cosf(angle) * radius;
+            p.y = kCenters[cluster][1] + sinf(angle) * radius;
+            p.vx = cosf(angle) * radius * 2.0f;
+            p.vy = sinf(angle) * radius * 2.0f;
+        } else {
+            p.x = (frand() * 2.0f - 1.0f) * ASPECT;
+            p.y = frand() * 2.0f - 1.0f;
+            p.vx = (frand() - 0.5f) * 0.2f;
+            p.vy = (frand() - 0.5f) * 0.2f;
+        }
+        p.ax = 0.0f;
+        p.ay = -0.1f;
+        p.r = frand();
+        p.g = frand();
+        p.b = frand();
+        p.a = 1.0f;
+        p.size = 4.0f + frand() * 6.0f;
+        p.life = 100.0f;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = 1.0f;
+        p.type = PARTICLE_EXPLOSION;
+        particle_pool_emit(pool, &p);
+    }
+}
+
+static void interaction_for(int mode, FireworksInteraction *interaction) {
+    static const ParticleAttractor kAttractors[4] = {
+        {-0.25f, 0.4f, 0.3f, 2.0f},
+        {0.2f, 0.2f, 0.3f, 2.0f},
+        {0.0f, -0.3f, 0.25f, -3.0f},   // 松手后的排斥
+        {0.15f, -0.7f, 0.3f, 2.0f},
+    };
+    *interaction = {};
+    if (mode >= MODE_ATTRACT) {
+        for (int a = 0; a < 4; a++) {
+            interaction->attractors[a] = kAttractors[a];
+        }
+        interaction->attractorCount = 4;
+    }
+    if (mode == MODE_FULL) {
+        interaction->collisionRadius = COLLISION_RADIUS;
+        interaction->collisionStiffness = COLLISION_STIFFNESS;
+        interaction->bounce = 1;
+        interaction->restitution = RESTITUTION;
+    }
+}
+
+struct RunResult {
+    double meanUs, p95Us, gridUs;
+    uint64_t checksum;
+};
+
+static bool run(int threads, int mode, int count, int steps, RunResult *result) {
+    JobSystem *jobs = job_system_create(threads);
+    FireworksSim sim;
+    if (jobs == nullptr || fireworks_sim_init(&sim, count, count, 1, jobs, 1) != 0) {
+        return false;
+    }
+    sim.aspect = ASPECT;
+    fill(&sim.particles, count);
+    FireworksInteraction interaction;
+    interaction_for(mode, &interaction);
+    fireworks_sim_set_interaction(&sim, &interaction);
+
+    std::vector<int64_t> samples((size_t) steps);
+    for (int step = 0; step < steps; step++) {
+        int64_t start = bench_now_ns();
+        fireworks_sim_update(&sim, SIM_DT);
+        samples[(size_t) step] = bench_now_ns() - start;
+    }
+    int64_t sum = 0;
+    for (int64_t ns : samples) {
+        sum += ns;
+    }
+    std::sort(samples.begin(), samples.end());
+    result->meanUs = (double) sum / steps * 1e-3;
+    result->p95Us = (double) samples[(size_t) ((steps - 1) * 0.95 + 0.5)] * 1e-3;
+    result->checksum = fireworks_sim_checksum(&sim);
+
+    // 网格重建单独计时（与更新里的调用参数相同）
+    result->gridUs = 0.0;
+    if (mode == MODE_FULL) {
+        ParticleGrid grid = {};
+        const int repeats = 50;
+        int64_t start = bench_now_ns();
+        for (int i = 0; i < repeats; i++) {
+            particle_grid_build(&grid, &sim.particles, -ASPECT, -1.0f, ASPECT, 1.0f, COLLISION_RADIUS,
+                                1u << PARTICLE_EXPLOSION);
+        }
+        result->gridUs = (double) (bench_now_ns() - start) * 1e-3 / repeats;
+        printf("  grid %dx%d cells (%.4f units), %d particles\n", grid.cols, grid.rows, grid.cellSize, grid.count);
+        particle_grid_free(&grid);
+    }
+    fireworks_sim_free(&sim);
+    job_system_destroy(jobs);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 50000;
+    int steps = argc > 2 ? atoi(argv[2]) : 300;
+    if (count <= 0 || steps <= 0) {
+        fprintf(stderr, "particle and step counts must be positive\n");
+        return 1;
+    }
+
+    bool consistent = true;
+    printf("%d particles, %d steps\n", count, steps);
+    printf("%-8s %8s %10s %10s %10s %8s  %s\n", "mode", "threads", "mean us", "p95 us", "grid us", "budget",
+           "checksum");
+    for (int mode = 0; mode < MODE_COUNT; mode++) {
+        RunResult single, all;
+        if (!run(1, mode, count, steps, &single) || !run(0, mode, count, steps, &all)) {
+            fprintf(stderr, "init failed\n");
+            return 1;
+        }
+        const RunResult *results[2] = {&single, &all};
+        for (int k = 0; k < 2; k++) {
+            const RunResult *r = results[k];
+            printf("%-8s %8s %10.1f %10.1f %10.1f %7.1f%%  %016" PRIx64 "\n", kModeNames[mode],
+                   k == 0 ? "1" : "all", r->meanUs, r->p95Us, r->gridUs, 100.0 * r->meanUs / FRAME_BUDGET_US,
+                   r->checksum);
+        }
+        if (single.checksum != all.checksum) {
+            printf("%s: checksum differs between 1 and all threads\n", kModeNames[mode]);
+            consistent = false;
+        }
+    }
+    return consistent ? 0 : 1;
+}
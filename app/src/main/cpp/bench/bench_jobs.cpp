@@ -0,0 +1,119 @@
+// 任务系统扩展性基准：1..N 个线程分块执行粒子积分 + 顶点打包
+// 用法：bench_jobs [最大线程数] [粒子数]
+// 每个线程数都输出每帧耗时、加速比和结果校验和，校验和必须完全一致。
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "particle_pack.h"
+#include "particle_pool.h"
+
+#define FRAMES 120
+#define GRAIN  1024
+
+struct FrameCtx {
+    ParticlePool *pool;
+    ParticleVertex *vertices;
+    float dt;
+};
+
+static void integrate_job(void *ctx, int begin, int end) {
+    auto *frame = (FrameCtx *) ctx;
+    particle_integrate_range(frame->pool, begin, end, frame->dt);
+}
+
+static void pack_job(void *ctx, int begin, int end) {
+    auto *frame = (FrameCtx *) ctx;
+    particle_pack_range(frame->pool, begin, end, 1.0f, frame->vertices);
+}
+
+static void fill(ParticlePool *pool, int count) {
+    particle_pool_clear(pool);
+    uint32_t state = 7;
+    for (int i = 0; i < count; i++) {
+        Particle p;
+        state = state * 1664525u + 1013904223u;
+        float u = (float) (state >> 8) * (1.0f / 16777216.0f);
+        p.x = u * 2.0f - 1.0f;
+        p.y = 1.0f - u;
+        p.vx = u - 0.5f;
+        p.vy = 0.5f - u;
+        p.ax = 0.0f;
+        p.ay = 0.5f;
+        p.r = u;
+        p.g = 1.0f - u;
+        p.b = 0.5f;
+        p.a = 1.0f;
+        p.size = 4.0f + u;
+        p.life = 100.0f + u;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = (i % 3 == 0) ? 0.999f : 1.0f;
+        p.type = PARTICLE_EXPLOSION;
+        particle_pool_emit(pool, &p);
+    }
+}
+
+static uint64_t checksum(const ParticleVertex *data, size_t count) {
+    uint64_t hash = 1469598103934665603ULL;
+    const unsigned char *bytes = (const unsigned char *) data;
+    for (size_t i = 0; i < count * sizeof(ParticleVertex); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+int main(int argc, char **argv) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int) std::thread::hardware_concurrency();
+    int count = argc > 2 ? atoi(argv[2]) : 1000000;
+    if (maxThreads <= 0) {
+        maxThreads = 1;
+    }
+
+    ParticlePool pool;
+    if (particle_pool_init(&pool, count) != 0) {
+        fprintf(stderr, "pool alloc failed\n");
+        return 1;
+    }
+    std::vector<ParticleVertex> vertices((size_t) count);
+
+    printf("%d particles, %d frames\n", count, FRAMES);
+    printf("%7s  %10s  %8s  %16s\n", "threads", "ms/frame", "speedup", "checksum");
+    double baseline = 0.0;
+    uint64_t expected = 0;
+    bool deterministic = true;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        JobSystem *jobs = job_system_create(threads);
+        fill(&pool, count);
+        FrameCtx frame = {&pool, vertices.data(), 1.0f / 60.0f};
+
+        int64_t start = bench_now_ns();
+        for (int f = 0; f < FRAMES; f++) {
+            job_system_parallel_for(jobs, pool.count, GRAIN, integrate_job, &frame);
+            particle_pool_advance(&pool, frame.dt);
+            job_system_parallel_for(jobs, pool.count, GRAIN, pack_job, &frame);
+        }
+        double ms = (double) (bench_now_ns() - start) * 1e-6 / FRAMES;
+        job_system_destroy(jobs);
+
+        uint64_t sum = checksum(vertices.data(), vertices.size());
+        if (threads == 1) {
+            baseline = ms;
+            expected = sum;
+        } else if (sum != expected) {
+            deterministic = false;
+        }
+        printf("%7d  %10.3f  %7.2fx  %016llx\n", threads, ms, baseline / ms, (unsigned long long) sum);
+    }
+    particle_pool_free(&pool);
+
+    if (!deterministic) {
+        fprintf(stderr, "results differ between thread counts\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,238 @@
+// 降分辨率粒子渲染的耗时与画质（宿主机，Mesa llvmpipe 即可）
+// 在手机尺寸的 pbuffer 上画一批大而重叠的点精灵（填充率受限的情形），分别在全分辨率、1/2、1/4
+// 和两种放大滤波下计时，并与全分辨率画面逐像素比较平均误差。
+// 支持 GL_EXT_disjoint_timer_query 时同时给出 GPU 计时，否则只有 glFinish 包围的墙钟时间。
+// 直接画到默认帧缓冲时光栅化推迟到 flush/交换（llvmpipe 和设备上的 tiler 都是如此），落在查询之外，
+// 因此全分辨率另跑一行 offscreen 测量模式：同样画进离屏纹理再合成，GPU 加速比以这一行为基准；
+// 墙钟加速比以直接绘制的全分辨率为基准，误差也以它的画面为参照。
+// 用法：bench_lowres [粒子数=20000] [帧数=20] [宽=1080] [高=2400]
+#include <GLES3/gl3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "bench_egl.h"
+#include "gl_utils.h"
+#include "gpu_timer.h"
+#include "particle_target.h"
+
+// 与 main.cpp 的粒子着色器一致：圆形渐变、SRC_ALPHA 混合
+static const char POINT_VS[] =
+        "#version 300 es\n"
+        "uniform float uSizeScale;\n"
+        "layout(location = 0) in vec2 aPosition;\n"
+        "layout(location = 1) in vec4 aColor;\n"
+        "layout(location = 2) in float aSize;\n"
+        "out vec4 vColor;\n"
+        "void main() {\n"
+        "    gl_Position = vec4(aPosition, 0.0, 1.0);\n"
+        "    gl_PointSize = aSize * uSizeScale;\n"
+        "    vColor = aColor;\n"
+        "}\n";
+
+static const char POINT_FS[] =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "in vec4 vColor;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    float d = 1.0 - min(length(gl_PointCoord * 2.0 - 1.0), 1.0);\n"
+        "    fragColor = vec4(vColor.rgb, vColor.a * d * d);\n"
+        "}\n";
+
+struct PointVertex {
+    float x, y;
+    float r, g, b, a;
+    float size;
+};
+
+static uint32_t rng_state = 1;
+
+static float frand() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float) (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+struct Scene {
+    GLuint program;
+    GLint uSizeScale;
+    GLuint vao, vbo;
+    int count;
+};
+
+static bool scene_init(Scene *scene, int count) {
+    scene->program = gl_link_program(gl_compile_shader(GL_VERTEX_SHADER, POINT_VS),
+                                     gl_compile_shader(GL_FRAGMENT_SHADER, POINT_FS), nullptr, 0);
+    if (scene->program == 0) {
+        return false;
+    }
+    scene->uSizeScale = glGetUniformLocation(scene->program, "uSizeScale");
+    std::vector<PointVertex> vertices((size_t) count);
+    for (PointVertex &v : vertices) {
+        // 集中在屏幕中部的一团爆炸，大小 8~64 像素
+        float angle = frand() * 6.2831853f;
+        float radius = sqrtf(frand()) * 0.8f;
+        v.x = cosf(angle) * radius;
+        v.y = sinf(angle) * radius * 0.5f;
+        v.r = 0.5f + frand() * 0.5f;
+        v.g = frand();
+        v.b = frand() * 0.5f;
+        v.a = 0.2f + frand() * 0.8f;
+        v.size = 8.0f + frand() * 56.0f;
+    }
+    scene->count = count;
+    glGenVertexArrays(1, &scene->vao);
+    glGenBuffers(1, &scene->vbo);
+    glBindVertexArray(scene->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, scene->vbo);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (vertices.size() * sizeof(PointVertex)), vertices.data(),
+                 GL_STATIC_DRAW);
+    const GLsizei stride = sizeof(PointVertex);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void *) offsetof(PointVertex, x));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void *) offsetof(PointVertex, r));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void *) offsetof(PointVertex, size));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+static void scene_free(Scene *scene) {
+    glDeleteBuffers(1, &scene->vbo);
+    glDeleteVertexArrays(1, &scene->vao);
+    glDeleteProgram(scene->program);
+}
+
+// 与 engine_draw_frame 相同的顺序：清屏、（离屏）画粒子、合成
+static void draw_frame(const Scene *scene, const ParticleTarget *target) {
+    glClear(GL_COLOR_BUFFER_BIT);
+    particle_target_begin(target);
+    glUseProgram(scene->program);
+    glUniform1f(scene->uSizeScale, 1.0f / (float) target->divisor);
+    glBindVertexArray(scene->vao);
+    glDrawArrays(GL_POINTS, 0, scene->count);
+    glBindVertexArray(0);
+    particle_target_end(target);
+}
+
+static void read_frame(int width, int height, std::vector<uint8_t> *pixels) {
+    pixels->resize((size_t) width * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+}
+
+// 平均每通道绝对误差（0~255）
+static double mean_error(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        if ((i & 3) != 3) {
+            sum += abs((int) a[i] - (int) b[i]);
+        }
+    }
+    return (double) sum / (double) (a.size() / 4 * 3);
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 20000;
+    int frames = argc > 2 ? atoi(argv[2]) : 20;
+    int width = argc > 3 ? atoi(argv[3]) : 1080;
+    int height = argc > 4 ? atoi(argv[4]) : 2400;
+
+    BenchEgl egl;
+    if (!bench_egl_init(&egl, width, height)) {
+        return 1;
+    }
+    printf("renderer: %s, %dx%d, %d particles, %d frames\n", glGetString(GL_RENDERER), width, height, count,
+           frames);
+
+    Scene scene;
+    ParticleTarget target;
+    GpuTimer timer;
+    if (!scene_init(&scene, count) || particle_target_init(&target) != 0) {
+        fprintf(stderr, "shader init failed\n");
+        return 1;
+    }
+    if (gpu_timer_init(&timer) != 0) {
+        printf("GL_EXT_disjoint_timer_query unavailable, wall clock only\n");
+    }
+    glViewport(0, 0, width, height);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    struct Config {
+        int divisor;
+        int filter;
+        int offscreen;
+    };
+    const Config configs[] = {
+            {1, PARTICLE_UPSAMPLE_BILINEAR, 0},
+            {1, PARTICLE_UPSAMPLE_BILINEAR, 1},
+            {2, PARTICLE_UPSAMPLE_BILINEAR, 1},
+            {2, PARTICLE_UPSAMPLE_BICUBIC,  1},
+            {4, PARTICLE_UPSAMPLE_BILINEAR, 1},
+            {4, PARTICLE_UPSAMPLE_BICUBIC,  1},
+    };
+    static const char *filterNames[] = {"bilinear", "bicubic"};
+    std::vector<uint8_t> reference, pixels;
+    double fullMs = 0.0;
+    double fullGpuMs = 0.0;
+    printf("%-18s %10s %10s %12s %12s %12s\n", "target", "wall ms", "gpu ms", "wall speedup", "gpu speedup",
+           "mean error");
+    for (const Config &config : configs) {
+        target.filter = config.filter;
+        target.offscreen = config.offscreen;
+        if (particle_target_resize(&target, width, height, config.divisor) != 0) {
+            fprintf(stderr, "1/%d target unavailable\n", config.divisor);
+            continue;
+        }
+        // 预热一帧（着色器编译、纹理分配）
+        draw_frame(&scene, &target);
+        glFinish();
+        timer.totalMs = 0.0;
+        timer.samples = 0;
+        int64_t start = bench_now_ns();
+        for (int f = 0; f < frames; f++) {
+            gpu_timer_begin(&timer);
+            draw_frame(&scene, &target);
+            gpu_timer_end(&timer);
+            glFinish();
+            gpu_timer_poll(&timer);
+        }
+        double wallMs = (double) (bench_now_ns() - start) * 1e-6 / frames;
+        read_frame(width, height, &pixels);
+        double gpuMs = timer.samples > 0 ? timer.totalMs / timer.samples : 0.0;
+        if (config.divisor == 1 && !config.offscreen) {
+            reference = pixels;
+            fullMs = wallMs;
+        }
+        if (config.divisor == 1 && config.offscreen) {
+            fullGpuMs = gpuMs;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "1/%d %s", config.divisor,
+                 config.divisor > 1 ? filterNames[config.filter] : config.offscreen ? "offscreen" : "direct");
+        // 直接绘制的查询覆盖不到光栅化，不给 GPU 时间
+        char gpu[16] = "-";
+        char gpuSpeedup[16] = "-";
+        if (config.offscreen && gpuMs > 0.0) {
+            snprintf(gpu, sizeof(gpu), "%.3f", gpuMs);
+            if (fullGpuMs > 0.0) {
+                snprintf(gpuSpeedup, sizeof(gpuSpeedup), "%.2fx", fullGpuMs / gpuMs);
+            }
+        }
+        printf("%-18s %10.3f %10s %11.2fx %12s %12.3f\n", name, wallMs, gpu, fullMs / wallMs, gpuSpeedup,
+               mean_error(reference, pixels));
+    }
+
+    gpu_timer_free(&timer);
+    particle_target_free(&target);
+    scene_free(&scene);
+    bench_egl_term(&egl);
+    return 0;
+}
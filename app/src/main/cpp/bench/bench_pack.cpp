@@ -0,0 +1,126 @@
+// 顶点打包基准：原 7 float（28 字节）格式 vs 压缩 12 字节格式
+// 输出每个粒子的上传字节数、打包耗时（ns/particle），并用标量路径校验 SIMD 结果和量化误差。
+// 用法：bench_pack [粒子数]
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_common.h"
+#include "legacy_particles.h"
+#include "particle_pack.h"
+#include "particle_pool.h"
+
+#define ROUNDS 200
+
+static float half_to_float(uint16_t h) {
+    int exponent = (h >> 10) & 0x1f;
+    int mantissa = h & 0x3ff;
+    float value;
+    if (exponent == 0) {
+        value = ldexpf((float) mantissa, -24);
+    } else {
+        value = ldexpf((float) (mantissa | 0x400), exponent - 25);
+    }
+    return (h & 0x8000) ? -value : value;
+}
+
+static void fill(ParticlePool *pool, int count) {
+    uint32_t state = 11;
+    for (int i = 0; i < count; i++) {
+        float u[6];
+        for (float &value : u) {
+            state = state * 1664525u + 1013904223u;
+            value = (float) (state >> 8) * (1.0f / 16777216.0f);
+        }
+        Particle p;
+        p.x = u[0] * 2.4f - 1.2f;
+        p.y = u[1] * 2.4f - 1.2f;
+        p.vx = p.vy = p.ax = p.ay = 0.0f;
+        p.r = u[2];
+        p.g = u[3];
+        p.b = u[4];
+        p.a = u[5];
+        p.size = u[0] * 30.0f;
+        p.life = p.maxLife = 1.0f;
+        p.alphaScale = p.sizeDecay = 1.0f;
+        p.type = PARTICLE_EXPLOSION;
+        particle_pool_emit(pool, &p);
+        // 上一步位置：位移覆盖 8 位运动量的范围和截断
+        pool->px[i] = p.x - (u[1] - 0.5f) * 0.08f;
+        pool->py[i] = p.y - (u[2] - 0.5f) * 0.08f;
+    }
+}
+
+// 与标量路径相同的运动量换算（向零截断到 ±127）
+static int8_t expected_motion(float delta) {
+    float value = fmaxf(fminf(delta * PARTICLE_MOTION_SCALE, 127.0f), -127.0f);
+    return (int8_t) value;
+}
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+
+    ParticlePool pool;
+    if (particle_pool_init(&pool, count) != 0) {
+        fprintf(stderr, "pool alloc failed\n");
+        return 1;
+    }
+    fill(&pool, count);
+
+    std::vector<float> legacy((size_t) count * LEGACY_VERTEX_FLOATS);
+    std::vector<ParticleVertex> packed((size_t) count);
+
+    int64_t start = bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        legacy_pack(&pool, 0, count, legacy.data());
+        bench_consume(legacy[(size_t) r % legacy.size()]);
+    }
+    double legacyNs = (double) (bench_now_ns() - start) / ((double) ROUNDS * count);
+
+    start = bench_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        particle_pack_range(&pool, 0, count, 1.0f, packed.data());
+        bench_consume((float) packed[(size_t) r % packed.size()].x);
+    }
+    double packedNs = (double) (bench_now_ns() - start) / ((double) ROUNDS * count);
+
+    // 校验：SIMD 路径与逐字段标量换算一致，量化误差在格式精度以内
+    int mismatches = 0;
+    float maxPosError = 0.0f, maxColorError = 0.0f, maxSizeError = 0.0f;
+    for (int i = 0; i < count; i++) {
+        const ParticleVertex &v = packed[i];
+        if (v.x != particle_float_to_half(pool.x[i]) || v.y != particle_float_to_half(pool.y[i]) ||
+            v.mx != expected_motion(pool.x[i] - pool.px[i]) || v.my != expected_motion(pool.y[i] - pool.py[i])) {
+            mismatches++;
+        }
+        maxPosError = fmaxf(maxPosError, fabsf(half_to_float(v.x) - pool.x[i]));
+        maxPosError = fmaxf(maxPosError, fabsf(half_to_float(v.y) - pool.y[i]));
+        const float color[] = {pool.r[i], pool.g[i], pool.b[i], pool.a[i]};
+        const uint8_t quantized[] = {v.r, v.g, v.b, v.a};
+        for (int k = 0; k < 4; k++) {
+            maxColorError = fmaxf(maxColorError, fabsf(quantized[k] / 255.0f - color[k]));
+        }
+        maxSizeError = fmaxf(maxSizeError, fabsf(v.size / PARTICLE_SIZE_SCALE - pool.size[i]));
+    }
+
+    printf("%d particles\n", count);
+    printf("%-10s %8s %14s %12s\n", "format", "B/part", "upload/frame", "pack ns/p");
+    printf("%-10s %8zu %11.2f MB %12.3f\n", "float7", LEGACY_VERTEX_FLOATS * sizeof(float),
+           (double) count * LEGACY_VERTEX_FLOATS * sizeof(float) / 1e6, legacyNs);
+    printf("%-10s %8zu %11.2f MB %12.3f\n", "quantized", sizeof(ParticleVertex),
+           (double) count * sizeof(ParticleVertex) / 1e6, packedNs);
+    printf("max error: position %.2e  color %.2e  size %.2e px  simd/scalar mismatches %d\n",
+           maxPosError, maxColorError, maxSizeError, mismatches);
+    particle_pool_free(&pool);
+
+    // 坐标在 ±1.2 以内，半精度步长不超过 2^-10，就近舍入误差不超过半个步长
+    bool ok = mismatches == 0 && maxPosError <= 1.0f / 1024.0f && maxColorError <= 0.5f / 255.0f + 1e-6f &&
+              maxSizeError <= 0.5f / PARTICLE_SIZE_SCALE + 1e-5f;
+    if (!ok) {
+        fprintf(stderr, "quantization check failed\n");
+        return 1;
+    }
+    return 0;
+}
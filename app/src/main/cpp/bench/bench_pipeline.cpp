@@ -0,0 +1,190 @@
+// 模拟与渲染的串行/流水线对比（宿主机）
+// 用固定种子和固定步长跑烟花场景（开启触摸吸引、碰撞和边缘反弹，让模拟有分量），渲染线程每帧：
+//   把顶点拷进“流式缓冲”（普通内存）→ 忙等 draw 毫秒模拟提交绘制的 CPU 开销 → 睡 swap 毫秒模拟交换缓冲的阻塞
+// 串行模式在渲染线程上推进 + 打包；流水线模式由 SimPipeline 的模拟线程推进下一帧。
+// 模拟线程每帧另外忙等 sim 毫秒，模拟更重的场景或更慢的设备（场景本身每帧只要零点几毫秒）。
+// 不等垂直同步，输出能达到的帧率、输入到交换完成的延迟、每帧模拟 + 打包和渲染线程等待的时间。
+// 两种模式画出的帧应逐位相同（流水线晚一帧），模拟结束时的校验和也相同，不一致时返回 1。
+// 用法：bench_pipeline [帧数=600] [sim 毫秒=4] [draw 毫秒=2] [swap 毫秒=4] [线程数=0(全部核心)]
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <time.h>
+
+#include "bench_common.h"
+#include "fireworks_sim.h"
+#include "sim_pipeline.h"
+
+// 与 main.cpp 保持一致
+#define MAX_PARTICLES 8000
+#define SPAWN_BUDGET  2048
+#define SIM_DT        (1.0f / 60.0f)
+#define ASPECT        (1080.0f / 2400.0f)
+#define HEIGHT_PX     2400.0f
+
+struct Scene {
+    FireworksSim sim;
+    ParticleCullParams cull;
+    int frame;            // 已推进的帧数，驱动触摸点移动
+    double extraSimMs;
+};
+
+static void busy_wait(double ms) {
+    int64_t end = bench_now_ns() + (int64_t) (ms * 1e6);
+    while (bench_now_ns() < end) {
+    }
+}
+
+// 一根手指绕圈拖动，每 90 帧松开一次
+static void set_touch(Scene *scene) {
+    FireworksInteraction interaction = {};
+    float t = (float) scene->frame * SIM_DT;
+    ParticleAttractor &touch = interaction.attractors[0];
+    touch.x = 0.25f * cosf(t * 2.0f);
+    touch.y = 0.3f + 0.25f * sinf(t * 2.0f);
+    touch.radius = 0.35f;
+    touch.strength = scene->frame % 90 < 70 ? 2.0f : -3.0f;
+    interaction.attractorCount = 1;
+    interaction.collisionRadius = 8.0f * 2.0f / HEIGHT_PX;
+    interaction.collisionStiffness = 4.0f;
+    interaction.bounce = 1;
+    interaction.restitution = 0.6f;
+    fireworks_sim_set_interaction(&scene->sim, &interaction);
+}
+
+// 推进一帧并打包（串行模式在渲染线程上、流水线模式在模拟线程上调用）
+static void produce(void *ctx, SimFrame *frame) {
+    auto *scene = (Scene *) ctx;
+    frame->events = fireworks_sim_step(&scene->sim, SIM_DT);
+    scene->frame++;
+    busy_wait(scene->extraSimMs);
+    frame->vertexCount = 0;
+    if (sim_frame_reserve(frame, scene->sim.particles.count) == 0) {
+        frame->vertexCount = fireworks_sim_pack(&scene->sim, 1.0f, &scene->cull, frame->vertices, nullptr);
+    }
+}
+
+static void sleep_ms(double ms) {
+    struct timespec ts = {(time_t) (ms / 1000.0), (long) ((ms - (double) (int64_t) (ms / 1000.0) * 1000.0) * 1e6)};
+    nanosleep(&ts, nullptr);
+}
+
+static uint64_t hash_frame(const SimFrame *frame) {
+    const auto *bytes = (const unsigned char *) frame->vertices;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < (size_t) frame->vertexCount * sizeof(ParticleVertex); i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+struct RunResult {
+    SimPipelineStats stats;
+    std::vector<uint64_t> frameHashes;   // 画出的每一帧（流水刚开始时重复的一帧不计）
+    uint64_t checksum;
+};
+
+static bool run(bool pipelined, int frames, double simMs, double drawMs, double swapMs, int threads,
+                RunResult *result) {
+    JobSystem *jobs = job_system_create(threads);
+    Scene scene = {};
+    if (jobs == nullptr ||
+        fireworks_sim_init(&scene.sim, MAX_PARTICLES, MAX_PARTICLES, SPAWN_BUDGET, jobs, 1) != 0) {
+        return false;
+    }
+    scene.sim.aspect = ASPECT;
+    scene.extraSimMs = simMs;
+    scene.cull = {-ASPECT, ASPECT, -1.0f, 1.0f, HEIGHT_PX * 0.5f, 1.0f, 0.5f / 255.0f, 0.0f};
+    SimPipeline *pipeline = pipelined ? sim_pipeline_create(produce, &scene) : nullptr;
+    if (pipelined && pipeline == nullptr) {
+        return false;
+    }
+
+    std::vector<ParticleVertex> stream(MAX_PARTICLES);
+    SimFrame serialFrame = {};
+    result->stats = {};
+    result->frameHashes.clear();
+    int64_t lastInputNs = -1;
+    for (int i = 0; i < frames; i++) {
+        int64_t now = bench_now_ns();
+        const SimFrame *frame;
+        if (pipeline != nullptr) {
+            result->stats.waitNs += sim_pipeline_acquire(pipeline);
+            set_touch(&scene);   // 模拟线程空闲，可以修改模拟状态
+            frame = sim_pipeline_submit(pipeline, now, (uint32_t) i);
+        } else {
+            set_touch(&scene);
+            produce(&scene, &serialFrame);
+            serialFrame.inputNs = now;
+            serialFrame.produceNs = bench_now_ns() - now;
+            result->stats.waitNs += serialFrame.produceNs;
+            frame = &serialFrame;
+        }
+        bool fresh = frame->inputNs != lastInputNs;
+
+        memcpy(stream.data(), frame->vertices, (size_t) frame->vertexCount * sizeof(ParticleVertex));
+        busy_wait(drawMs);
+        sleep_ms(swapMs);
+        if (fresh) {
+            sim_pipeline_stats_present(&result->stats, frame->inputNs, bench_now_ns());
+            result->stats.produceNs += frame->produceNs;
+            result->frameHashes.push_back(hash_frame(frame));
+            lastInputNs = frame->inputNs;
+        }
+    }
+    sim_pipeline_destroy(pipeline);   // 等最后提交的一帧做完，两种模式推进的帧数相同
+    result->checksum = fireworks_sim_checksum(&scene.sim);
+    free(serialFrame.vertices);
+    fireworks_sim_free(&scene.sim);
+    job_system_destroy(jobs);
+    return true;
+}
+
+static void print_result(const char *name, const RunResult *result) {
+    const SimPipelineStats *stats = &result->stats;
+    double frames = (double) stats->frames;
+    double seconds = (double) (stats->lastPresentNs - stats->firstPresentNs) * 1e-9;
+    printf("%-10s %7.1f %9.2f %9.2f %9.2f %9.2f  %016" PRIx64 "\n", name,
+           seconds > 0.0 ? (frames - 1.0) / seconds : 0.0, stats->latencyNs * 1e-6 / frames,
+           stats->maxLatencyNs * 1e-6, stats->produceNs * 1e-6 / frames, stats->waitNs * 1e-6 / frames,
+           result->checksum);
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+    double simMs = argc > 2 ? atof(argv[2]) : 4.0;
+    double drawMs = argc > 3 ? atof(argv[3]) : 2.0;
+    double swapMs = argc > 4 ? atof(argv[4]) : 4.0;
+    int threads = argc > 5 ? atoi(argv[5]) : 0;
+    if (frames < 2) {
+        fprintf(stderr, "need at least 2 frames\n");
+        return 1;
+    }
+
+    RunResult serial, pipelined;
+    if (!run(false, frames, simMs, drawMs, swapMs, threads, &serial) ||
+        !run(true, frames, simMs, drawMs, swapMs, threads, &pipelined)) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+
+    printf("%d frames, sim +%.1f ms, draw %.1f ms (busy), swap %.1f ms (blocked) per frame\n", frames, simMs,
+           drawMs, swapMs);
+    printf("%-10s %7s %9s %9s %9s %9s  %s\n", "mode", "fps", "lat ms", "max ms", "sim ms", "wait ms", "checksum");
+    print_result("serial", &serial);
+    print_result("pipelined", &pipelined);
+
+    // 流水线画出的帧是串行的前缀（最后提交的一帧没来得及画）
+    bool framesMatch = pipelined.frameHashes.size() + 1 == serial.frameHashes.size();
+    for (size_t i = 0; framesMatch && i < pipelined.frameHashes.size(); i++) {
+        framesMatch = pipelined.frameHashes[i] == serial.frameHashes[i];
+    }
+    bool match = framesMatch && serial.checksum == pipelined.checksum;
+    printf("drawn frames %s, final state %s\n", framesMatch ? "identical" : "DIFFER",
+           serial.checksum == pipelined.checksum ? "identical" : "DIFFER");
+    return match ? 0 : 1;
+}
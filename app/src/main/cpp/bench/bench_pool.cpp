@@ -0,0 +1,127 @@
+// 粒子池内存区基准：按预算保留 100 万粒子的地址空间，从 8192 逐帧扩容到满，再满池积分 + 打包
+// 用法：bench_pool [预算 MB=80] [初始容量=8192]
+// 输出每个阶段后的常驻内存（/proc/self/status 的 VmRSS）和透明大页用量（AnonHugePages），
+// 用来确认物理内存只随已用容量增长，以及扩容不搬移已有粒子。
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bench_common.h"
+#include "particle_pack.h"
+#include "particle_pool.h"
+#include "particle_spawn.h"
+
+#define SPAWN_PER_FRAME 8192
+#define FRAMES          30
+
+// 从 /proc/self 读取一个以 kB 为单位的字段，读不到返回 -1
+static long read_proc_kb(const char *path, const char *field) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        return -1;
+    }
+    char line[256];
+    long total = -1;
+    size_t length = strlen(field);
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (strncmp(line, field, length) == 0) {
+            total = (total < 0 ? 0 : total) + atol(line + length);
+        }
+    }
+    fclose(file);
+    return total;
+}
+
+static void report(const char *stage, const ParticlePool *pool) {
+    ParticlePoolMetrics metrics;
+    particle_pool_metrics(pool, &metrics);
+    printf("%-16s used %8d  capacity %8d/%8d  grows %2d  evictions %8d  committed %6.1f MB  "
+           "rss %7.1f MB  anon huge %6.1f MB\n",
+           stage, metrics.used, metrics.capacity, metrics.maxCapacity, metrics.grows, metrics.evictions,
+           metrics.committedBytes / 1048576.0, read_proc_kb("/proc/self/status", "VmRSS:") / 1024.0,
+           read_proc_kb("/proc/self/smaps", "AnonHugePages:") / 1024.0);
+}
+
+static void fill_spawns(ParticleSpawnBuffer *spawns, uint32_t *state) {
+    for (int i = 0; i < SPAWN_PER_FRAME; i++) {
+        Particle p;
+        *state = *state * 1664525u + 1013904223u;
+        float u = (float) (*state >> 8) * (1.0f / 16777216.0f);
+        p.x = u * 2.0f - 1.0f;
+        p.y = 1.0f - u;
+        p.vx = u - 0.5f;
+        p.vy = 0.5f - u;
+        p.ax = 0.0f;
+        p.ay = 0.5f;
+        p.r = u;
+        p.g = 1.0f - u;
+        p.b = 0.5f;
+        p.a = 1.0f;
+        p.size = 4.0f + u;
+        p.life = 2.0f + 6.0f * u;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = 1.0f;
+        p.type = PARTICLE_EXPLOSION;
+        particle_spawn_push(spawns, &p);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t budget = (size_t) (argc > 1 ? atoi(argv[1]) : 80) << 20;
+    int initial = argc > 2 ? atoi(argv[2]) : 8192;
+    int maxCapacity = particle_pool_capacity_for_budget(budget);
+
+    ParticlePool pool;
+    ParticleSpawnBuffer spawns;
+    if (particle_pool_reserve(&pool, initial < maxCapacity ? initial : maxCapacity, maxCapacity,
+                              PARTICLE_ARENA_HUGE_PAGES) != 0 ||
+        particle_spawn_init(&spawns, SPAWN_PER_FRAME) != 0) {
+        fprintf(stderr, "reserve failed\n");
+        return 1;
+    }
+    static const char *pageNames[] = {"normal", "transparent huge (advised)", "hugetlb"};
+    printf("budget %zu MB -> %d particles (%zu bytes each), %s pages\n", budget >> 20, maxCapacity,
+           PARTICLE_POOL_BYTES_PER_PARTICLE, pageNames[pool.arena.pages]);
+    report("reserved", &pool);
+
+    // 逐帧发射，直到容量用满并开始替换
+    uint32_t state = 7;
+    const float *firstColumn = pool.x;
+    int64_t emitNs = 0;
+    int frames = 0;
+    while (pool.evictions == 0 && frames < maxCapacity / SPAWN_PER_FRAME + 2) {
+        fill_spawns(&spawns, &state);
+        int64_t start = bench_now_ns();
+        particle_spawn_apply(&pool, &spawns);
+        emitNs += bench_now_ns() - start;
+        frames++;
+    }
+    report("filled", &pool);
+    printf("%d frames of %d spawns, %.2f ns/particle, columns %s\n", frames, SPAWN_PER_FRAME,
+           (double) emitNs / ((double) frames * SPAWN_PER_FRAME), pool.x == firstColumn ? "not moved" : "MOVED");
+
+    // 满池稳定状态：积分 + 打包 + 持续发射（替换最早过期的粒子）
+    std::vector<ParticleVertex> vertices(pool.capacity);
+    int64_t integrateNs = 0, packNs = 0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        int64_t t0 = bench_now_ns();
+        particle_integrate(&pool, 1.0f / 60.0f);
+        int64_t t1 = bench_now_ns();
+        particle_pack_range(&pool, 0, pool.count, 1.0f, vertices.data());
+        int64_t t2 = bench_now_ns();
+        integrateNs += t1 - t0;
+        packNs += t2 - t1;
+        fill_spawns(&spawns, &state);
+        particle_spawn_apply(&pool, &spawns);
+    }
+    bench_consume((float) vertices[pool.count - 1].size);
+    report("steady", &pool);
+    printf("%d particles: integrate %.2f ms/frame, pack %.2f ms/frame\n", pool.count,
+           integrateNs * 1e-6 / FRAMES, packNs * 1e-6 / FRAMES);
+
+    particle_spawn_free(&spawns);
+    particle_pool_free(&pool);
+    return 0;
+}
@@ -0,0 +1,108 @@
+// 分阶段帧计时器的开销和无锁读取（宿主机）
+// 1. 空作用域计时的单次开销（两次 clock_gettime 加一次累加）
+// 2. 用计时器跑完整场景，同时另一个线程不停地取统计：每帧各阶段写入同一个标记值的整数倍，
+//    读者拿到的每一帧都必须各阶段一致，否则说明读到了写到一半或已被覆盖的槽位
+// 3. 输出场景各阶段的均值和分位数，与设备上 logcat 里的格式相同
+// 用法：bench_profiler [帧数=700] [种子=1]
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "bench_common.h"
+#include "fireworks_sim.h"
+
+// 与 bench_fireworks 保持一致
+#define MAX_PARTICLES 8000
+#define SPAWN_BUDGET  2048
+#define SIM_DT        (1.0f / 60.0f)
+#define ASPECT        (1080.0f / 2400.0f)
+#define HEIGHT_PX     2400.0f
+
+#define SCOPE_ITERATIONS 1000000
+#define STRESS_REPORTS   20000
+
+static void print_report(const FrameProfilerReport *report) {
+    printf("last %d frames (us):  %8s %8s %8s %8s\n", report->frames, "mean", "p50", "p95", "p99");
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        const FrameProfilerStats *stats = &report->phases[phase];
+        printf("  %-18s %8.1f %8.1f %8.1f %8.1f\n", frame_profiler_phase_name(phase), stats->mean, stats->p50,
+               stats->p95, stats->p99);
+    }
+    printf("  %-18s %8.1f %8.1f %8.1f %8.1f\n", "total", report->total.mean, report->total.p50, report->total.p95,
+           report->total.p99);
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 700;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+
+    static FrameProfiler profiler;
+    frame_profiler_init(&profiler);
+    int64_t start = bench_now_ns();
+    for (int i = 0; i < SCOPE_ITERATIONS; i++) {
+        PROFILE_SCOPE(&profiler, PROFILE_UPDATE);
+    }
+    printf("scope overhead: %.1f ns\n", (double) (bench_now_ns() - start) / SCOPE_ITERATIONS);
+
+    // 写者每帧给各阶段写 v * (phase + 1) 微秒；读到的各阶段均值除以 phase + 1 后应相等
+    frame_profiler_init(&profiler);
+    std::atomic<bool> done(false);
+    std::atomic<long> reports(0);
+    long torn = 0;
+    std::thread reader([&]() {
+        while (!done.load(std::memory_order_relaxed)) {
+            FrameProfilerReport report;
+            if (frame_profiler_report(&profiler, &report) > 0) {
+                reports++;
+                float base = report.phases[0].mean;
+                for (int phase = 1; phase < PROFILE_PHASE_COUNT; phase++) {
+                    float scaled = report.phases[phase].mean / (float) (phase + 1);
+                    if (scaled < base * 0.999f - 1e-3f || scaled > base * 1.001f + 1e-3f) {
+                        torn++;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+    // 写者一直写到读者取够 STRESS_REPORTS 次统计，保证读写确实交错
+    uint32_t frame = 0;
+    while (reports.load(std::memory_order_relaxed) < STRESS_REPORTS) {
+        frame++;
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            frame_profiler_add(&profiler, phase, (int64_t) (frame % 1000 + 1) * (phase + 1) * 1000);
+        }
+        frame_profiler_end_frame(&profiler);
+    }
+    done.store(true);
+    reader.join();
+    printf("concurrent reads: %ld reports over %u frames, %ld inconsistent\n", reports.load(), frame, torn);
+
+    // 完整场景
+    JobSystem *jobs = job_system_create(0);
+    FireworksSim sim;
+    if (jobs == nullptr || fireworks_sim_init(&sim, MAX_PARTICLES, MAX_PARTICLES, SPAWN_BUDGET, jobs, seed) != 0) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+    sim.aspect = ASPECT;
+    frame_profiler_init(&profiler);
+    sim.profiler = &profiler;
+    ParticleVertex *vertices = new ParticleVertex[MAX_PARTICLES];
+    ParticleCullParams cull = {-ASPECT, ASPECT, -1.0f, 1.0f, HEIGHT_PX * 0.5f, 1.0f, 0.5f / 255.0f, 8.0f};
+    for (int frame = 0; frame < frames; frame++) {
+        fireworks_sim_step(&sim, SIM_DT);
+        fireworks_sim_pack(&sim, 1.0f, &cull, vertices, nullptr);
+        frame_profiler_end_frame(&profiler);
+    }
+    FrameProfilerReport report;
+    frame_profiler_report(&profiler, &report);
+    printf("fireworks, %d frames, %d particles at the end\n", frames, sim.particles.count);
+    print_report(&report);
+
+    delete[] vertices;
+    fireworks_sim_free(&sim);
+    job_system_destroy(jobs);
+    return torn == 0 ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+// 着色器程序二进制缓存的冷/热链接耗时（宿主机，Mesa llvmpipe 即可）
+// 在临时目录上依次：冷启动（编译并写缓存）、热启动（新的 ProgramCache 从文件加载）、
+// 篡改缓存文件后再加载（应回退到编译并覆盖），最后再热启动一次。每轮链接同一组程序。
+// Mesa 的程序二进制依赖其自带的磁盘着色器缓存（MESA_SHADER_CACHE_DISABLE 时报告 0 种格式），
+// 重复运行时“冷”编译也可能命中 Mesa 的缓存，设备上的冷启动耗时以 logcat 为准。
+// 用法：bench_program_cache [缓存目录=/tmp/program_cache_bench/]
+#include <GLES3/gl3.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bench_common.h"
+#include "bench_egl.h"
+#include "program_cache.h"
+
+// 与 main.cpp 的点精灵着色器一致
+static const char POINT_VS[] =
+        "#version 300 es\n"
+        "uniform mat4 uMatrix;\n"
+        "uniform float uSizeScale;\n"
+        "layout(location = 0) in vec2 aPosition;\n"
+        "layout(location = 1) in vec4 aColor;\n"
+        "layout(location = 2) in float aSize;\n"
+        "out vec4 vColor;\n"
+        "void main() {\n"
+        "    gl_Position = uMatrix * vec4(aPosition, 0.0, 1.0);\n"
+        "    gl_PointSize = aSize * uSizeScale;\n"
+        "    vColor = aColor;\n"
+        "}\n";
+
+static const char POINT_FS[] =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform sampler2D uTexture;\n"
+        "in vec4 vColor;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    fragColor = vColor * texture(uTexture, gl_PointCoord);\n"
+        "}\n";
+
+// 与 assets/texture.vert / texture.frag（typing.c）一致，ES 2.0 着色器并在链接前绑定属性
+static const char TEXTURE_VS[] =
+        "#version 100\n"
+        "attribute highp vec4 position;\n"
+        "attribute mediump vec2 texCoord;\n"
+        "varying mediump vec2 texCoordFragment;\n"
+        "void main() {\n"
+        "    texCoordFragment = texCoord;\n"
+        "    gl_Position = position;\n"
+        "}\n";
+
+static const char TEXTURE_FS[] =
+        "#version 100\n"
+        "uniform lowp sampler2D texture0;\n"
+        "varying mediump vec2 texCoordFragment;\n"
+        "void main() {\n"
+        "    gl_FragColor = texture2D(texture0, texCoordFragment);\n"
+        "}\n";
+
+// 片段着色器较长的一组（按 define 选择分支），让编译耗时更接近真实场景
+static const char FILTER_FS[] =
+        "#version 300 es\n"
+        "precision highp float;\n"
+        "uniform sampler2D uTexture;\n"
+        "uniform vec2 uTexelSize;\n"
+        "in vec2 vTexCoord;\n"
+        "out vec4 fragColor;\n"
+        "vec4 cubic(float v) {\n"
+        "    vec4 n = vec4(1.0, 2.0, 3.0, 4.0) - v;\n"
+        "    vec4 s = n * n * n;\n"
+        "    float x = s.x;\n"
+        "    float y = s.y - 4.0 * s.x;\n"
+        "    float z = s.z - 4.0 * s.y + 6.0 * s.x;\n"
+        "    float w = 6.0 - x - y - z;\n"
+        "    return vec4(x, y, z, w) * (1.0 / 6.0);\n"
+        "}\n"
+        "void main() {\n"
+        "#ifdef BICUBIC\n"
+        "    vec2 coord = vTexCoord / uTexelSize - 0.5;\n"
+        "    vec2 f = fract(coord);\n"
+        "    coord -= f;\n"
+        "    vec4 xc = cubic(f.x);\n"
+        "    vec4 yc = cubic(f.y);\n"
+        "    vec4 c = coord.xxyy + vec2(-0.5, 1.5).xyxy;\n"
+        "    vec4 s = vec4(xc.xz + xc.yw, yc.xz + yc.yw);\n"
+        "    vec4 offset = (c + vec4(xc.yw, yc.yw) / s) * uTexelSize.xxyy;\n"
+        "    vec4 s0 = texture(uTexture, offset.xz);\n"
+        "    vec4 s1 = texture(uTexture, offset.yz);\n"
+        "    vec4 s2 = texture(uTexture, offset.xw);\n"
+        "    vec4 s3 = texture(uTexture, offset.yw);\n"
+        "    float sx = s.x / (s.x + s.y);\n"
+        "    float sy = s.z / (s.z + s.w);\n"
+        "    fragColor = mix(mix(s3, s2, sx), mix(s1, s0, sx), sy);\n"
+        "#else\n"
+        "    fragColor = texture(uTexture, vTexCoord);\n"
+        "#endif\n"
+        "}\n";
+
+static const char FILTER_VS[] =
+        "#version 300 es\n"
+        "out vec2 vTexCoord;\n"
+        "void main() {\n"
+        "    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+        "    vTexCoord = p;\n"
+        "    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+        "}\n";
+
+struct ProgramDesc {
+    const char *name;
+    const char *vertex;
+    const char *fragment;
+    const char *defines;
+    const char *const *attributes;
+    int attributeCount;
+};
+
+static const char *const kTextureAttributes[] = {"position", "texCoord"};
+
+static const ProgramDesc kPrograms[] = {
+        {"particle points", POINT_VS, POINT_FS, nullptr, nullptr, 0},
+        {"texture", TEXTURE_VS, TEXTURE_FS, nullptr, kTextureAttributes, 2},
+        {"upsample bilinear", FILTER_VS, FILTER_FS, nullptr, nullptr, 0},
+        {"upsample bicubic", FILTER_VS, FILTER_FS, "#define BICUBIC\n", nullptr, 0},
+};
+static const int kProgramCount = sizeof(kPrograms) / sizeof(kPrograms[0]);
+
+static std::vector<std::string> cache_files(const std::string &dir) {
+    std::vector<std::string> files;
+    DIR *d = opendir(dir.c_str());
+    if (d == nullptr) {
+        return files;
+    }
+    while (dirent *entry = readdir(d)) {
+        if (strncmp(entry->d_name, "program-", 8) == 0) {
+            files.push_back(dir + entry->d_name);
+        }
+    }
+    closedir(d);
+    return files;
+}
+
+// 链接全部程序，返回总耗时（毫秒），并检查每个程序都能使用
+static double link_all(const char *dir, const char *label, ProgramCache *cache) {
+    program_cache_init(cache, dir);
+    int64_t start = bench_now_ns();
+    GLuint programs[kProgramCount];
+    for (int i = 0; i < kProgramCount; i++) {
+        const ProgramDesc &p = kPrograms[i];
+        programs[i] = program_cache_link(cache, p.name, p.vertex, p.fragment, p.defines, p.attributes,
+                                         p.attributeCount);
+    }
+    double ms = (double) (bench_now_ns() - start) * 1e-6;
+    int valid = 0;
+    for (int i = 0; i < kProgramCount; i++) {
+        if (programs[i] != 0) {
+            glValidateProgram(programs[i]);
+            valid++;
+        }
+        if (i == 1 && programs[i] != 0 && glGetAttribLocation(programs[i], "texCoord") != 1) {
+            fprintf(stderr, "%s: attribute binding lost\n", label);
+            valid--;
+        }
+        glDeleteProgram(programs[i]);
+    }
+    printf("%-10s %8.2f ms total, %d/%d programs, %d hits, %d compiled, %d rejected, %d stored\n", label, ms,
+           valid, kProgramCount, cache->hits, cache->misses + cache->rejected, cache->rejected, cache->stored);
+    return valid == kProgramCount ? ms : -1.0;
+}
+
+int main(int argc, char **argv) {
+    std::string dir = argc > 1 ? argv[1] : "/tmp/program_cache_bench/";
+    if (dir.back() != '/') {
+        dir += '/';
+    }
+    mkdir(dir.c_str(), 0755);
+    for (const std::string &file : cache_files(dir)) {
+        unlink(file.c_str());
+    }
+
+    BenchEgl egl;
+    if (!bench_egl_init(&egl, 16, 16)) {
+        return 1;
+    }
+    printf("renderer: %s, cache dir %s\n", glGetString(GL_RENDERER), dir.c_str());
+
+    ProgramCache cache;
+    if (program_cache_init(&cache, dir.c_str()) != 0) {
+        printf("program binaries unsupported, only the cold path is measured\n");
+    }
+    double cold = link_all(dir.c_str(), "cold", &cache);
+    double warm = link_all(dir.c_str(), "warm", &cache);
+
+    // 篡改缓存文件的二进制部分（保留文件头），应被驱动拒绝并回退到编译
+    std::vector<std::string> files = cache_files(dir);
+    for (const std::string &file : files) {
+        FILE *f = fopen(file.c_str(), "r+b");
+        if (f != nullptr) {
+            fseek(f, 0, SEEK_END);
+            long size = ftell(f);
+            std::vector<char> garbage((size_t) (size > 24 ? size - 24 : 0), 0x5A);
+            fseek(f, 24, SEEK_SET);
+            fwrite(garbage.data(), 1, garbage.size(), f);
+            fclose(f);
+        }
+    }
+    double corrupt = link_all(dir.c_str(), "corrupted", &cache);
+    double rewarm = link_all(dir.c_str(), "warm again", &cache);
+
+    printf("%zu cache files; cold %.2f ms, warm %.2f ms (%.1fx)\n", files.size(), cold, warm,
+           warm > 0.0 ? cold / warm : 0.0);
+    bench_egl_term(&egl);
+    return cold < 0.0 || warm < 0.0 || corrupt < 0.0 || rewarm < 0.0 ? 1 : 0;
+}
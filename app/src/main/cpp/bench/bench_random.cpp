@@ -0,0 +1,64 @@
+// 发射器随机数基准：libc rand() vs xoshiro128+ 逐个取数 vs SIMD 批量填充
+// 输出每个随机数的平均耗时，并校验批量与逐个取数的序列一致、同一种子可复现。
+// 用法：bench_random [随机数个数]
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "particle_random.h"
+
+int main(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 10000000;
+    std::vector<float> values((size_t) count);
+
+    srand(1);
+    int64_t start = bench_now_ns();
+    for (int i = 0; i < count; i++) {
+        values[i] = (float) rand() / RAND_MAX;
+    }
+    double libcNs = (double) (bench_now_ns() - start) / count;
+    bench_consume(values[count / 2]);
+
+    ParticleRandom rng;
+    particle_random_seed(&rng, 1, 0);
+    start = bench_now_ns();
+    for (int i = 0; i < count; i++) {
+        values[i] = particle_random_float(&rng);
+    }
+    double scalarNs = (double) (bench_now_ns() - start) / count;
+    bench_consume(values[count / 2]);
+
+    // 批量结果与逐个取数比较：每次取不同长度，覆盖缓存中有剩余的情况
+    std::vector<float> batched((size_t) count);
+    particle_random_seed(&rng, 1, 0);
+    start = bench_now_ns();
+    for (int done = 0, chunk = 1; done < count; done += chunk, chunk = chunk % 37 + 1) {
+        int n = count - done < chunk ? count - done : chunk;
+        particle_random_fill(&rng, &batched[done], n);
+    }
+    double chunkedNs = (double) (bench_now_ns() - start) / count;
+    int mismatches = 0;
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        mismatches += values[i] != batched[i];
+        mismatches += !(values[i] >= 0.0f && values[i] < 1.0f);
+        sum += values[i];
+    }
+
+    particle_random_seed(&rng, 1, 0);
+    start = bench_now_ns();
+    particle_random_fill(&rng, batched.data(), count);
+    double fillNs = (double) (bench_now_ns() - start) / count;
+    for (int i = 0; i < count; i++) {
+        mismatches += values[i] != batched[i];
+    }
+
+    printf("%d values\n", count);
+    printf("%-22s %8.3f ns/value\n", "libc rand()", libcNs);
+    printf("%-22s %8.3f ns/value\n", "xoshiro128+ scalar", scalarNs);
+    printf("%-22s %8.3f ns/value\n", "xoshiro128+ fill 1..37", chunkedNs);
+    printf("%-22s %8.3f ns/value\n", "xoshiro128+ fill", fillNs);
+    printf("mean %.5f  mismatches %d\n", sum / count, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// 模拟快照的体积、保存/恢复耗时和恢复后的一致性（宿主机）
+// 用固定种子跑到第 N 帧后保存快照，恢复到一个新的模拟实例，两边再各跑 M 帧，比较校验和。
+// 过期索引随快照一起恢复，满池替换的顺序不变，因此两边应逐位一致。
+// 用法：bench_snapshot [保存时的帧数=400] [之后的帧数=240] [种子=1] [重复次数=50]
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "fireworks_snapshot.h"
+
+// 与 bench_fireworks 保持一致
+#define MAX_PARTICLES 8000
+#define SPAWN_BUDGET  2048
+#define SIM_DT        (1.0f / 60.0f)
+#define ASPECT        (1080.0f / 2400.0f)
+
+static bool init_sim(FireworksSim *sim, JobSystem *jobs, uint64_t seed) {
+    if (fireworks_sim_init(sim, MAX_PARTICLES, MAX_PARTICLES, SPAWN_BUDGET, jobs, seed) != 0) {
+        return false;
+    }
+    sim->aspect = ASPECT;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int saveFrame = argc > 1 ? atoi(argv[1]) : 400;
+    int moreFrames = argc > 2 ? atoi(argv[2]) : 240;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1;
+    int repeats = argc > 4 ? atoi(argv[4]) : 50;
+    if (repeats <= 0) {
+        repeats = 1;
+    }
+
+    JobSystem *jobs = job_system_create(0);
+    FireworksSim original, restored;
+    // 恢复目标用不同的种子，确认随机数状态来自快照
+    if (jobs == nullptr || !init_sim(&original, jobs, seed) || !init_sim(&restored, jobs, seed + 1)) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+    for (int frame = 0; frame < saveFrame; frame++) {
+        fireworks_sim_step(&original, SIM_DT);
+    }
+
+    std::vector<unsigned char> blob(fireworks_snapshot_bound(&original));
+    size_t size = 0;
+    int64_t start = bench_now_ns();
+    for (int i = 0; i < repeats; i++) {
+        size = fireworks_snapshot_save(&original, blob.data(), blob.size());
+    }
+    double saveUs = (double) (bench_now_ns() - start) * 1e-3 / repeats;
+    if (size == 0) {
+        fprintf(stderr, "save failed\n");
+        return 1;
+    }
+
+    int loaded = 0;
+    start = bench_now_ns();
+    for (int i = 0; i < repeats; i++) {
+        loaded = fireworks_snapshot_load(&restored, blob.data(), size);
+    }
+    double loadUs = (double) (bench_now_ns() - start) * 1e-3 / repeats;
+    if (loaded != 0) {
+        fprintf(stderr, "load failed\n");
+        return 1;
+    }
+
+    // 篡改的快照必须被拒绝
+    blob[size / 2] ^= 0xFF;
+    FireworksSim scratch;
+    if (!init_sim(&scratch, jobs, seed)) {
+        return 1;
+    }
+    int corruptRejected = fireworks_snapshot_load(&scratch, blob.data(), size) != 0;
+    fireworks_sim_free(&scratch);
+
+    int count = original.particles.count;
+    for (int frame = 0; frame < moreFrames; frame++) {
+        fireworks_sim_step(&original, SIM_DT);
+        fireworks_sim_step(&restored, SIM_DT);
+    }
+    uint64_t expected = fireworks_sim_checksum(&original);
+    uint64_t actual = fireworks_sim_checksum(&restored);
+
+    printf("snapshot at frame %d (t=%.2f s): %d particles, %zu bytes (%.1f bytes/particle)%s\n", saveFrame,
+           saveFrame * SIM_DT, count, size, count > 0 ? (double) (size - sizeof(FireworksSnapshotHeader)) / count : 0.0,
+           FIREWORKS_SNAPSHOT_LZ4 ? ", lz4" : "");
+    printf("save %.1f us, restore %.1f us (mean of %d)\n", saveUs, loadUs, repeats);
+    printf("corrupted snapshot %s\n", corruptRejected ? "rejected" : "ACCEPTED");
+    printf("after %d more frames: original %016" PRIx64 ", restored %016" PRIx64 " -> %s\n", moreFrames, expected,
+           actual, expected == actual ? "match" : "MISMATCH");
+
+    fireworks_sim_free(&restored);
+    fireworks_sim_free(&original);
+    job_system_destroy(jobs);
+    return expected == actual && corruptRejected ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+// 点精灵与实例化四边形的对比（宿主机，Mesa llvmpipe 即可）
+// 两种负载：大量 1 像素小粒子（顶点/图元吞吐）和少量大粒子（填充），每种负载分别用
+// GL_POINTS 与 glDrawArraysInstanced 四边形绘制同一份 12 字节顶点，glFinish 包围计时，
+// 并给出与点精灵画面的平均误差（不拉伸的四边形应与点精灵基本一致）。
+// 用法：bench_sprites [小粒子数=200000] [大粒子数=20000] [帧数=5] [宽=1080] [高=2400]
+#include <GLES3/gl3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "bench_egl.h"
+#include "gl_utils.h"
+#include "particle_pack.h"
+#include "particle_quads.h"
+
+// 与 main.cpp 的点精灵着色器一致
+static const char POINT_VS[] =
+        "#version 300 es\n"
+        "uniform mat4 uMatrix;\n"
+        "uniform float uSizeScale;\n"
+        "layout(location = 0) in vec2 aPosition;\n"
+        "layout(location = 1) in vec4 aColor;\n"
+        "layout(location = 2) in float aSize;\n"
+        "out vec4 vColor;\n"
+        "void main() {\n"
+        "    gl_Position = uMatrix * vec4(aPosition, 0.0, 1.0);\n"
+        "    gl_PointSize = aSize * uSizeScale;\n"
+        "    vColor = aColor;\n"
+        "}\n";
+
+static const char POINT_FS[] =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform sampler2D uTexture;\n"
+        "in vec4 vColor;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    fragColor = vColor * texture(uTexture, gl_PointCoord);\n"
+        "}\n";
+
+static const float IDENTITY[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+static uint32_t rng_state = 7;
+
+static float frand() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float) (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+// 圆形渐变纹理（与 main.cpp 的 createCircleTexture 相同）
+static GLuint circle_texture() {
+    const int texSize = 64;
+    std::vector<uint8_t> data((size_t) texSize * texSize * 4);
+    for (int y = 0; y < texSize; y++) {
+        for (int x = 0; x < texSize; x++) {
+            float dx = (x + 0.5f - texSize / 2) / (texSize / 2);
+            float dy = (y + 0.5f - texSize / 2) / (texSize / 2);
+            float alpha = 1.0f - fminf(sqrtf(dx * dx + dy * dy), 1.0f);
+            uint8_t *texel = &data[(size_t) (y * texSize + x) * 4];
+            texel[0] = texel[1] = texel[2] = 255;
+            texel[3] = (uint8_t) (alpha * alpha * 255);
+        }
+    }
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texSize, texSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return texture;
+}
+
+// 随机粒子，大小在 [minSize, maxSize) 像素，带随机方向的运动量
+static void make_vertices(std::vector<ParticleVertex> *vertices, int count, float minSize, float maxSize) {
+    vertices->resize((size_t) count);
+    for (ParticleVertex &v : *vertices) {
+        particle_pack_vertex(frand() * 1.8f - 0.9f, frand() * 1.8f - 0.9f, frand(), frand(), frand(),
+                             0.3f + frand() * 0.7f, minSize + frand() * (maxSize - minSize), &v);
+        v.mx = (int8_t) (frand() * 120.0f - 60.0f);
+        v.my = (int8_t) (frand() * 120.0f - 60.0f);
+    }
+}
+
+struct PointRenderer {
+    GLuint program;
+    GLint uMatrix, uTexture, uSizeScale;
+    GLuint vao;
+};
+
+static bool points_init(PointRenderer *points, GLuint buffer) {
+    points->program = gl_link_program(gl_compile_shader(GL_VERTEX_SHADER, POINT_VS),
+                                      gl_compile_shader(GL_FRAGMENT_SHADER, POINT_FS), nullptr, 0);
+    if (points->program == 0) {
+        return false;
+    }
+    points->uMatrix = glGetUniformLocation(points->program, "uMatrix");
+    points->uTexture = glGetUniformLocation(points->program, "uTexture");
+    points->uSizeScale = glGetUniformLocation(points->program, "uSizeScale");
+    const GLsizei stride = sizeof(ParticleVertex);
+    glGenVertexArrays(1, &points->vao);
+    glBindVertexArray(points->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void *) offsetof(ParticleVertex, x));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *) offsetof(ParticleVertex, r));
+    glVertexAttribPointer(2, 1, GL_UNSIGNED_SHORT, GL_FALSE, stride, (void *) offsetof(ParticleVertex, size));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+    return true;
+}
+
+static void points_draw(const PointRenderer *points, int count) {
+    glUseProgram(points->program);
+    glUniformMatrix4fv(points->uMatrix, 1, GL_FALSE, IDENTITY);
+    glUniform1i(points->uTexture, 0);
+    glUniform1f(points->uSizeScale, 1.0f / PARTICLE_SIZE_SCALE);
+    glBindVertexArray(points->vao);
+    glDrawArrays(GL_POINTS, 0, count);
+    glBindVertexArray(0);
+}
+
+// 平均每通道绝对误差（0~255），用于确认两条路径画出的是同一幅图
+static double frame_error(int width, int height, std::vector<uint8_t> *reference) {
+    std::vector<uint8_t> pixels((size_t) width * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    if (reference->empty()) {
+        *reference = pixels;
+        return 0.0;
+    }
+    int64_t sum = 0;
+    for (size_t i = 0; i < pixels.size(); i++) {
+        if ((i & 3) != 3) {
+            sum += abs((int) pixels[i] - (int) (*reference)[i]);
+        }
+    }
+    return (double) sum / (double) (pixels.size() / 4 * 3);
+}
+
+// 返回每帧毫秒数（glFinish 包围，先预热一帧）
+template<typename Draw>
+static double time_frames(int frames, Draw draw) {
+    glClear(GL_COLOR_BUFFER_BIT);
+    draw();
+    glFinish();
+    int64_t start = bench_now_ns();
+    for (int f = 0; f < frames; f++) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw();
+        glFinish();
+    }
+    return (double) (bench_now_ns() - start) * 1e-6 / frames;
+}
+
+int main(int argc, char **argv) {
+    int smallCount = argc > 1 ? atoi(argv[1]) : 200000;
+    int largeCount = argc > 2 ? atoi(argv[2]) : 20000;
+    int frames = argc > 3 ? atoi(argv[3]) : 5;
+    int width = argc > 4 ? atoi(argv[4]) : 1080;
+    int height = argc > 5 ? atoi(argv[5]) : 2400;
+
+    BenchEgl egl;
+    if (!bench_egl_init(&egl, width, height)) {
+        return 1;
+    }
+    GLfloat pointRange[2] = {0.0f, 0.0f};
+    glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, pointRange);
+    printf("renderer: %s, %dx%d, point size range %.0f - %.0f px\n", glGetString(GL_RENDERER), width, height,
+           pointRange[0], pointRange[1]);
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glActiveTexture(GL_TEXTURE0);
+    GLuint texture = circle_texture();
+
+    struct Load {
+        const char *name;
+        int count;
+        float minSize, maxSize;
+    };
+    const Load loads[] = {
+            {"small 1px", smallCount, 1.0f, 1.0f},
+            {"large 16-64px", largeCount, 16.0f, 64.0f},
+    };
+    printf("%-14s %8s %-8s %10s %12s %10s\n", "load", "count", "path", "ms/frame", "ns/particle", "vs points");
+    std::vector<ParticleVertex> vertices;
+    for (const Load &load : loads) {
+        make_vertices(&vertices, load.count, load.minSize, load.maxSize);
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) (vertices.size() * sizeof(ParticleVertex)), vertices.data(),
+                     GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        PointRenderer points;
+        ParticleQuadRenderer quads;
+        if (!points_init(&points, buffer) || particle_quads_init(&quads, buffer) != 0) {
+            fprintf(stderr, "shader init failed\n");
+            return 1;
+        }
+        ParticleQuadParams params;
+        params.matrix = IDENTITY;
+        params.textureUnit = 0;
+        params.sizeScale = 1.0f / PARTICLE_SIZE_SCALE;
+        params.pixelsPerUnit = height * 0.5f;
+        params.viewportWidth = (float) width;
+        params.viewportHeight = (float) height;
+
+        std::vector<uint8_t> reference;
+        double pointMs = time_frames(frames, [&] { points_draw(&points, load.count); });
+        double pointError = frame_error(width, height, &reference);
+        params.stretch = 0.0f;
+        double quadMs = time_frames(frames, [&] { particle_quads_draw(&quads, &params, 0, load.count); });
+        double quadError = frame_error(width, height, &reference);
+        params.stretch = 2.0f;
+        double stretchMs = time_frames(frames, [&] { particle_quads_draw(&quads, &params, 0, load.count); });
+        double stretchError = frame_error(width, height, &reference);
+
+        const struct {
+            const char *path;
+            double ms;
+            double error;
+        } results[] = {{"points", pointMs, pointError}, {"quads", quadMs, quadError},
+                       {"stretch", stretchMs, stretchError}};
+        for (const auto &result : results) {
+            printf("%-14s %8d %-8s %10.3f %12.1f %10.3f\n", load.name, load.count, result.path, result.ms,
+                   result.ms * 1e6 / load.count, result.error);
+        }
+
+        particle_quads_free(&quads);
+        glDeleteVertexArrays(1, &points.vao);
+        glDeleteProgram(points.program);
+        glDeleteBuffers(1, &buffer);
+    }
+
+    glDeleteTextures(1, &texture);
+    bench_egl_term(&egl);
+    return 0;
+}
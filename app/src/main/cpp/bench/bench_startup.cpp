@@ -0,0 +1,226 @@
+// 启动到第一帧的耗时：窗口到达后才建上下文（原来的顺序） vs 窗口到达前先建上下文（宿主机，Mesa llvmpipe 即可）
+// 另一个线程睡 window 毫秒后“交付窗口”，代表系统创建窗口的时间；窗口表面用屏幕大小的 pbuffer 代替。
+//   on-window：等窗口 → 显示/配置/上下文/窗口表面 → 编译程序、上传纹理 → 第一帧
+//   early    ：显示/配置/上下文（surfaceless 或 1x1 pbuffer）→ 编译程序、上传纹理 → 等窗口 → 绑定窗口表面 → 第一帧
+// 每种顺序交替跑若干次取中位数。关闭了 Mesa 的磁盘着色器缓存，编译耗时按冷启动计；
+// 设备上的实际数字以 logcat 的 "time to first frame" 为准（debug.fireworks.early_gl 0/1 对比）。
+// 用法：bench_startup [window 毫秒=100] [次数=5]
+#include <EGL/egl.h>
+#include <GLES3/gl3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "bench_common.h"
+#include "particle_quads.h"
+#include "particle_target.h"
+#include "program_cache.h"
+
+#define SCREEN_WIDTH  1080
+#define SCREEN_HEIGHT 2400
+
+// 与 main.cpp 的点精灵着色器一致
+static const char POINT_VS[] =
+        "#version 300 es\n"
+        "uniform mat4 uMatrix;\n"
+        "uniform float uSizeScale;\n"
+        "layout(location = 0) in vec2 aPosition;\n"
+        "layout(location = 1) in vec4 aColor;\n"
+        "layout(location = 2) in float aSize;\n"
+        "out vec4 vColor;\n"
+        "void main() {\n"
+        "    gl_Position = uMatrix * vec4(aPosition, 0.0, 1.0);\n"
+        "    gl_PointSize = aSize * uSizeScale;\n"
+        "    vColor = aColor;\n"
+        "}\n";
+
+static const char POINT_FS[] =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform sampler2D uTexture;\n"
+        "in vec4 vColor;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    vec4 texColor = texture(uTexture, gl_PointCoord);\n"
+        "    fragColor = vColor * texColor;\n"
+        "}\n";
+
+struct Startup {
+    EGLDisplay display;
+    EGLConfig config;
+    EGLContext context;
+    EGLSurface bootstrap;
+    EGLSurface window;
+    GLuint program, texture, buffer;
+    ParticleQuadRenderer quads;
+    ParticleTarget target;
+    bool surfaceless;
+    double contextMs, resourcesMs, windowMs, boundMs, firstFrameMs;
+};
+
+static bool init_context(Startup *s, bool early) {
+    s->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (s->display == EGL_NO_DISPLAY || !eglInitialize(s->display, nullptr, nullptr)) {
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const char *extensions = eglQueryString(s->display, EGL_EXTENSIONS);
+    s->surfaceless = extensions != nullptr && strstr(extensions, "EGL_KHR_surfaceless_context") != nullptr;
+    const EGLint attribs[] = {
+        EGL_RENDERABLE_TYPE, 0x0040, // EGL_OPENGL_ES3_BIT
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(s->display, attribs, &s->config, 1, &numConfigs) || numConfigs == 0) {
+        return false;
+    }
+    const EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+    s->context = eglCreateContext(s->display, s->config, EGL_NO_CONTEXT, contextAttribs);
+    if (s->context == EGL_NO_CONTEXT) {
+        return false;
+    }
+    if (!early) {
+        return true;
+    }
+    s->bootstrap = EGL_NO_SURFACE;
+    if (!s->surfaceless) {
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        s->bootstrap = eglCreatePbufferSurface(s->display, s->config, pbufferAttribs);
+    }
+    return eglMakeCurrent(s->display, s->bootstrap, s->bootstrap, s->context) == EGL_TRUE;
+}
+
+static bool bind_window(Startup *s) {
+    const EGLint attribs[] = {EGL_WIDTH, SCREEN_WIDTH, EGL_HEIGHT, SCREEN_HEIGHT, EGL_NONE};
+    s->window = eglCreatePbufferSurface(s->display, s->config, attribs);
+    if (s->window == EGL_NO_SURFACE || !eglMakeCurrent(s->display, s->window, s->window, s->context)) {
+        return false;
+    }
+    if (s->bootstrap != EGL_NO_SURFACE) {
+        eglDestroySurface(s->display, s->bootstrap);
+        s->bootstrap = EGL_NO_SURFACE;
+    }
+    return true;
+}
+
+// 与 main.cpp 的 engine_init_gl_resources 相同的一组：点精灵程序、圆形纹理、实例化四边形、合成着色器
+static bool init_resources(Startup *s) {
+    ProgramCache cache;
+    program_cache_init(&cache, "");
+    s->program = program_cache_link(&cache, "particle points", POINT_VS, POINT_FS, nullptr, nullptr, 0);
+
+    const int texSize = 64;
+    std::vector<unsigned char> pixels(texSize * texSize * 4, 255);
+    glGenTextures(1, &s->texture);
+    glBindTexture(GL_TEXTURE_2D, s->texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texSize, texSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    glGenBuffers(1, &s->buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, s->buffer);
+    glBufferData(GL_ARRAY_BUFFER, 8192 * 12, nullptr, GL_STREAM_DRAW);
+    return s->program != 0 && particle_quads_init(&s->quads, s->buffer) == 0 &&
+           particle_target_init(&s->target) == 0;
+}
+
+static void term(Startup *s) {
+    particle_target_free(&s->target);
+    particle_quads_free(&s->quads);
+    glDeleteBuffers(1, &s->buffer);
+    glDeleteTextures(1, &s->texture);
+    glDeleteProgram(s->program);
+    eglMakeCurrent(s->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroySurface(s->display, s->window);
+    eglDestroyContext(s->display, s->context);
+    eglTerminate(s->display);
+}
+
+static bool run(bool early, double windowMs, Startup *s) {
+    memset(s, 0, sizeof(*s));
+    const int64_t start = bench_now_ns();
+    auto since = [start]() { return (double) (bench_now_ns() - start) * 1e-6; };
+    std::thread windowThread([windowMs] {
+        std::this_thread::sleep_for(std::chrono::microseconds((int64_t) (windowMs * 1000.0)));
+    });
+
+    bool ok;
+    if (early) {
+        ok = init_context(s, true);
+        s->contextMs = since();
+        ok = ok && init_resources(s);
+        s->resourcesMs = since();
+        windowThread.join();
+        s->windowMs = since();
+        ok = ok && bind_window(s);
+        s->boundMs = since();
+    } else {
+        windowThread.join();
+        s->windowMs = since();
+        ok = init_context(s, false);
+        s->contextMs = since();
+        s->bootstrap = EGL_NO_SURFACE;
+        ok = ok && bind_window(s);
+        s->boundMs = since();
+        ok = ok && init_resources(s);
+        s->resourcesMs = since();
+    }
+    ok = ok && particle_target_resize(&s->target, SCREEN_WIDTH, SCREEN_HEIGHT, 1) == 0;
+    if (ok) {
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        eglSwapBuffers(s->display, s->window);
+        glFinish();
+    }
+    s->firstFrameMs = since();
+    term(s);
+    return ok;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main(int argc, char **argv) {
+    double windowMs = argc > 1 ? atof(argv[1]) : 100.0;
+    int runs = argc > 2 ? atoi(argv[2]) : 5;
+    if (runs <= 0) {
+        runs = 1;
+    }
+    setenv("EGL_PLATFORM", "surfaceless", 0);
+    setenv("MESA_SHADER_CACHE_DISABLE", "true", 0);
+
+    std::vector<double> times[2][5];
+    bool surfaceless = false;
+    for (int i = 0; i < runs; i++) {
+        for (int early = 0; early < 2; early++) {
+            Startup s;
+            if (!run(early != 0, windowMs, &s)) {
+                fprintf(stderr, "%s startup failed\n", early ? "early" : "on-window");
+                return 1;
+            }
+            surfaceless = early ? s.surfaceless : surfaceless;
+            const double values[5] = {s.contextMs, s.resourcesMs, s.windowMs, s.boundMs, s.firstFrameMs};
+            for (int k = 0; k < 5; k++) {
+                times[early][k].push_back(values[k]);
+            }
+        }
+    }
+
+    printf("window delivered after %.0f ms, early context %s, median of %d runs (ms since start)\n", windowMs,
+           surfaceless ? "surfaceless" : "on a 1x1 pbuffer", runs);
+    printf("%-10s %9s %10s %8s %8s %12s\n", "order", "context", "resources", "window", "bound", "first frame");
+    const char *names[2] = {"on-window", "early"};
+    for (int early = 0; early < 2; early++) {
+        printf("%-10s %9.1f %10.1f %8.1f %8.1f %12.1f\n", names[early], median(times[early][0]),
+               median(times[early][1]), median(times[early][2]), median(times[early][3]), median(times[early][4]));
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// 文字爆炸发射基准：原逐粒子近似形状（rand + sin/cos/atan2 + 逐个写入）vs 点云整列拷贝
+// 用法：bench_text [点云 .gpc 文件]
+// 给出文件时用 mmap 零拷贝加载（与设备上 AAsset_getBuffer 相同的访问方式），否则在内存中合成一个点云。
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "glyph_cloud.h"
+#include "particle_emitter.h"
+#include "particle_spawn.h"
+
+#define TEXT_PARTICLE_COUNT 1200
+#define BURSTS 2000
+
+// 原 main.cpp 中的 spawn_text_particles（写入发射缓冲的版本）
+static void legacy_spawn_text(ParticleSpawnBuffer *buffer, float aspect) {
+    for (int i = 0; i < TEXT_PARTICLE_COUNT; i++) {
+        Particle p;
+        int charIdx = rand() % 4;
+        float baseX = -0.6f + charIdx * 0.4f;
+        float baseY = 0.0f;
+        float cx = ((float) rand() / RAND_MAX) * 0.25f - 0.125f;
+        float cy = ((float) rand() / RAND_MAX) * 0.35f - 0.175f;
+        if (charIdx == 0) {
+            cx = sinf(cx * 10) * 0.1f;
+        } else if (charIdx == 1) {
+            cy = cosf(cy * 8) * 0.08f;
+        } else if (charIdx == 2) {
+            cx = fabsf(cx) - 0.05f;
+        } else {
+            cy = fabsf(cy) - 0.05f;
+        }
+        p.x = (baseX + cx) * aspect;
+        p.y = baseY + cy;
+        float angle = atan2f(p.y - baseY, p.x - baseX);
+        float speed = ((float) rand() / RAND_MAX) * 1.0f + 0.3f;
+        p.vx = cosf(angle) * speed * 0.5f;
+        p.vy = sinf(angle) * speed * 0.5f;
+        p.ax = 0.0f;
+        p.ay = 0.2f;
+        p.r = ((float) rand() / RAND_MAX) * 0.8f + 0.2f;
+        p.g = ((float) rand() / RAND_MAX) * 0.8f + 0.2f;
+        p.b = ((float) rand() / RAND_MAX) * 0.8f + 0.2f;
+        p.a = 1.0f;
+        p.size = ((float) rand() / RAND_MAX) * 12.0f + 6.0f;
+        p.life = ((float) rand() / RAND_MAX) * 2.0f + 1.0f;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = 1.0f;
+        p.type = PARTICLE_TEXT;
+        particle_spawn_push(buffer, &p);
+    }
+}
+
+// 没有资源文件时合成一个格式相同的点云
+static std::vector<float> synthesize(int count) {
+    std::vector<float> data(sizeof(GlyphCloudHeader) / sizeof(float) + (size_t) count * 5);
+    auto *header = (GlyphCloudHeader *) data.data();
+    header->magic = GLYPH_CLOUD_MAGIC;
+    header->version = GLYPH_CLOUD_VERSION;
+    header->headerSize = sizeof(GlyphCloudHeader);
+    header->count = (uint32_t) count;
+    header->extentX = 2.0f;
+    header->extentY = 0.5f;
+    float *columns = data.data() + sizeof(GlyphCloudHeader) / sizeof(float);
+    for (int i = 0; i < count; i++) {
+        float angle = (float) i * 2.399963f;
+        columns[i] = ((float) (i % 97) / 97.0f - 0.5f) * 4.0f;
+        columns[count + i] = ((float) (i % 89) / 89.0f - 0.5f);
+        columns[2 * count + i] = cosf(angle);
+        columns[3 * count + i] = sinf(angle);
+        columns[4 * count + i] = 0.5f + 0.5f * (float) (i % 7) / 7.0f;
+    }
+    return data;
+}
+
+int main(int argc, char **argv) {
+    GlyphCloud cloud;
+    std::vector<float> synthesized;
+    void *mapped = nullptr;
+    size_t mappedSize = 0;
+    if (argc > 1) {
+        int fd = open(argv[1], O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 1;
+        }
+        mappedSize = (size_t) st.st_size;
+        mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED || glyph_cloud_view(mapped, mappedSize, &cloud) != 0) {
+            fprintf(stderr, "%s is not a glyph cloud\n", argv[1]);
+            return 1;
+        }
+    } else {
+        synthesized = synthesize(TEXT_PARTICLE_COUNT);
+        glyph_cloud_view(synthesized.data(), synthesized.size() * sizeof(float), &cloud);
+    }
+
+    ParticleSpawnBuffer buffer;
+    if (particle_spawn_init(&buffer, TEXT_PARTICLE_COUNT) != 0) {
+        fprintf(stderr, "alloc failed\n");
+        return 1;
+    }
+
+    srand(1);
+    int64_t start = bench_now_ns();
+    for (int b = 0; b < BURSTS; b++) {
+        particle_spawn_reset(&buffer);
+        legacy_spawn_text(&buffer, 1.8f);
+    }
+    double legacyNs = (double) (bench_now_ns() - start) / BURSTS;
+    bench_consume(buffer.staged.vx[buffer.staged.count - 1]);
+
+    ParticleEmitter emitter = {0.0f, 0.0f, 0.0f, 0.0f, 0.2f, 1.0f, 1.0f, 1.0f, 1.0f, 0.8f,
+                               6.0f, 18.0f, 1.0f, 3.0f, 1.0f, 1.0f, PARTICLE_TEXT};
+    ParticleRandom rng;
+    particle_random_seed(&rng, 1, 0);
+    int emitted = 0;
+    start = bench_now_ns();
+    for (int b = 0; b < BURSTS; b++) {
+        particle_spawn_reset(&buffer);
+        emitted = particle_emit_cloud(&buffer, &emitter, &cloud, 0.35f, 0.15f, 0.65f, TEXT_PARTICLE_COUNT, &rng);
+    }
+    double cloudNs = (double) (bench_now_ns() - start) / BURSTS;
+    bench_consume(buffer.staged.vx[buffer.staged.count - 1]);
+
+    printf("%d points in cloud%s, %d particles per burst\n", cloud.count, argc > 1 ? "" : " (synthetic)", emitted);
+    printf("%-12s %8.2f us/burst %8.2f ns/particle\n", "legacy", legacyNs * 1e-3, legacyNs / TEXT_PARTICLE_COUNT);
+    printf("%-12s %8.2f us/burst %8.2f ns/particle  (%.1fx)\n", "glyph cloud", cloudNs * 1e-3,
+           cloudNs / emitted, legacyNs / cloudNs);
+
+    particle_spawn_free(&buffer);
+    if (mapped != nullptr) {
+        munmap(mapped, mappedSize);
+    }
+    return 0;
+}
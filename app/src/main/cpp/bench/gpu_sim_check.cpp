@@ -0,0 +1,139 @@
+// GPU 粒子模拟与 CPU 路径的一致性校验（宿主机，Mesa llvmpipe 即可）
+// 两边每帧发射同样的粒子、设置同样的全局加速度（模拟倾斜）并推进同样的步长，逐槽位比较状态，同时输出每帧耗时。
+// 用法：gpu_sim_check [帧数] [每帧发射数]
+#include <GLES3/gl31.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bench_common.h"
+#include "bench_egl.h"
+#include "gl_utils.h"
+#include "gpu_particle_sim.h"
+#include "particle_pool.h"
+#include "particle_spawn.h"
+
+static uint32_t rng_state;
+
+static float frand() {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float) (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static Particle make_particle() {
+    Particle p;
+    p.x = frand() * 2.0f - 1.0f;
+    p.y = frand() * 2.0f - 1.0f;
+    p.vx = frand() - 0.5f;
+    p.vy = frand() - 0.5f;
+    p.ax = 0.0f;
+    p.ay = frand() * 0.5f;
+    p.r = frand();
+    p.g = frand();
+    p.b = frand();
+    p.a = 1.0f;
+    p.size = frand() * 12.0f + 2.0f;
+    p.life = frand() * 2.0f + 0.2f;
+    p.maxLife = p.life;
+    p.alphaScale = frand() < 0.3f ? 0.8f : 1.0f;
+    p.sizeDecay = p.alphaScale < 1.0f ? 0.95f : 1.0f;
+    p.type = PARTICLE_EXPLOSION;
+    return p;
+}
+
+static bool close_enough(float cpu, float gpu) {
+    return fabsf(cpu - gpu) <= 1e-4f + 1e-4f * fabsf(cpu);
+}
+
+static bool run(int mode, int frames, int emitPerFrame) {
+    const float dt = 1.0f / 60.0f;
+    int capacity = frames * emitPerFrame;
+
+    // CPU 路径不移除死亡粒子，槽位顺序与 GPU 环形缓冲（不回绕）一致
+    ParticlePool pool;
+    ParticleSpawnBuffer spawns;
+    GpuParticleSim sim;
+    if (particle_pool_init(&pool, capacity) != 0 || particle_spawn_init(&spawns, emitPerFrame) != 0) {
+        fprintf(stderr, "alloc failed\n");
+        return false;
+    }
+    if (gpu_particle_sim_init(&sim, mode, capacity) != 0) {
+        printf("%-18s unsupported on this context\n", mode == GPU_SIM_COMPUTE ? "compute" : "transform feedback");
+        particle_spawn_free(&spawns);
+        particle_pool_free(&pool);
+        return true;
+    }
+
+    rng_state = 2024;
+    int64_t cpuNs = 0, gpuNs = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        for (int i = 0; i < emitPerFrame; i++) {
+            Particle p = make_particle();
+            particle_spawn_push(&spawns, &p);
+        }
+        float fieldX = 0.3f * sinf((float) frame * 0.05f), fieldY = -0.2f;
+        int64_t start = bench_now_ns();
+        gpu_particle_sim_emit(&sim, &spawns.staged);
+        gpu_particle_sim_set_field(&sim, fieldX, fieldY);
+        gpu_particle_sim_step(&sim, dt);
+        glFinish();
+        gpuNs += bench_now_ns() - start;
+
+        start = bench_now_ns();
+        particle_spawn_apply(&pool, &spawns);
+        particle_integrate_field_range(&pool, 0, pool.count, dt, fieldX, fieldY);
+        particle_pool_advance(&pool, dt);
+        cpuNs += bench_now_ns() - start;
+    }
+
+    std::vector<float> gpu((size_t) capacity * GPU_PARTICLE_FLOATS);
+    int read = gpu_particle_sim_read(&sim, gpu.data(), capacity);
+    int mismatches = 0, alive = 0;
+    float maxError = 0.0f;
+    for (int i = 0; i < read; i++) {
+        const float *g = &gpu[(size_t) i * GPU_PARTICLE_FLOATS];
+        bool isAlive = pool.life[i] > 0.0f;
+        const float cpu[] = {pool.x[i], pool.y[i], pool.vx[i], pool.vy[i], pool.life[i],
+                             isAlive ? pool.a[i] : 0.0f, isAlive ? pool.size[i] : 0.0f};
+        const float gpuValues[] = {g[0], g[1], g[2], g[3], g[11], g[9], g[10]};
+        alive += isAlive;
+        for (int k = 0; k < 7; k++) {
+            float error = fabsf(cpu[k] - gpuValues[k]);
+            maxError = error > maxError ? error : maxError;
+            if (!close_enough(cpu[k], gpuValues[k])) {
+                if (mismatches < 5) {
+                    fprintf(stderr, "particle %d field %d: cpu %.6f gpu %.6f\n", i, k, cpu[k], gpuValues[k]);
+                }
+                mismatches++;
+            }
+        }
+    }
+    bool ok = read == pool.count && mismatches == 0;
+    printf("%-18s %7d particles (%6d alive)  max err %.2e  cpu %.3f ms/f  gpu %.3f ms/f  %s\n",
+           mode == GPU_SIM_COMPUTE ? "compute" : "transform feedback", read, alive, maxError,
+           cpuNs * 1e-6 / frames, gpuNs * 1e-6 / frames, ok ? "OK" : "MISMATCH");
+
+    gpu_particle_sim_free(&sim);
+    particle_spawn_free(&spawns);
+    particle_pool_free(&pool);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 120;
+    int emitPerFrame = argc > 2 ? atoi(argv[2]) : 500;
+
+    BenchEgl egl;
+    if (!bench_egl_init(&egl, 16, 16)) {
+        return 1;
+    }
+    printf("%s | %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+
+    bool ok = run(GPU_SIM_TRANSFORM_FEEDBACK, frames, emitPerFrame);
+    ok = run(GPU_SIM_COMPUTE, frames, emitPerFrame) && ok;
+
+    bench_egl_term(&egl);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+#ifndef NATIVE_ACTIVITY_LEGACY_PARTICLES_H
+#define NATIVE_ACTIVITY_LEGACY_PARTICLES_H
+
+// 原 main.cpp 中的粒子实现（AoS），作为基准对照
+
+#include "particle_pool.h"
+
+// 原 56 字节粒子结构
+struct LegacyParticle {
+    float x, y;
+    float vx, vy;
+    float ax, ay;
+    float r, g, b, a;
+    float size;
+    float life;
+    float maxLife;
+    int type;
+};
+
+static inline LegacyParticle legacy_from(const Particle &p) {
+    return {p.x, p.y, p.vx, p.vy, p.ax, p.ay, p.r, p.g, p.b, p.a,
+            p.size, p.life, p.maxLife, p.type};
+}
+
+// 原 add_particle：池满时线性扫描寿命最短的粒子
+static inline void legacy_add(LegacyParticle *particles, int *count, int capacity,
+                              const LegacyParticle &p) {
+    if (*count >= capacity) {
+        int oldestIdx = 0;
+        float oldestLife = particles[0].life;
+        for (int i = 1; i < capacity; i++) {
+            if (particles[i].life < oldestLife) {
+                oldestLife = particles[i].life;
+                oldestIdx = i;
+            }
+        }
+        particles[oldestIdx] = p;
+    } else {
+        particles[(*count)++] = p;
+    }
+}
+
+// 原 update_particles 的积分与移除部分（不含火箭逻辑）
+static inline void legacy_update(LegacyParticle *particles, int *count, float dt) {
+    for (int i = *count - 1; i >= 0; i--) {
+        LegacyParticle *p = &particles[i];
+        p->life -= dt;
+        if (p->life <= 0.0f) {
+            particles[i] = particles[--*count];
+            continue;
+        }
+        p->vx += p->ax * dt;
+        p->vy += p->ay * dt;
+        p->x += p->vx * dt;
+        p->y += p->vy * dt;
+        p->a = p->life / p->maxLife;
+        if (p->type == PARTICLE_TRAIL) {
+            p->a *= 0.8f;
+            p->size *= 0.95f;
+        }
+    }
+}
+
+// 原 render_particles 的顶点格式：每个粒子 7 个 float（x y r g b a size），28 字节
+#define LEGACY_VERTEX_FLOATS 7
+
+static inline void legacy_pack(const ParticlePool *pool, int begin, int end, float *out) {
+    for (int i = begin; i < end; i++) {
+        float *v = &out[i * LEGACY_VERTEX_FLOATS];
+        v[0] = pool->x[i];
+        v[1] = pool->y[i];
+        v[2] = pool->r[i];
+        v[3] = pool->g[i];
+        v[4] = pool->b[i];
+        v[5] = pool->a[i];
+        v[6] = pool->size[i];
+    }
+}
+
+#endif //NATIVE_ACTIVITY_LEGACY_PARTICLES_H
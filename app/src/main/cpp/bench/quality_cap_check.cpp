@@ -0,0 +1,94 @@
+// 画质档位的存活粒子上限校验（宿主机，不需要 GL）
+// 用固定种子跑完整场景（火箭 → 爆炸 → 文字），每档分别在 CPU 粒子池和 GPU 常驻两种模式下：
+//   - 低于全画质的各档：上限必须真正丢弃发射请求，且存活粒子数的峰值不超过上限
+//   - 全画质：不丢弃任何请求
+// GPU 常驻模式下按调用方的做法每步取走 gpuSpawns，用一份 CPU 上的寿命副本代替 GPU 上的粒子，
+// 统计真实存活数（模拟内部只有按寿命的估计）。任一条件不满足时返回 1。
+// 用法：quality_cap_check [帧数=700] [种子=1]
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "fireworks_sim.h"
+#include "quality_governor.h"
+
+// 与 main.cpp 保持一致
+#define MAX_PARTICLES 8000
+#define SPAWN_BUDGET  2048
+#define SIM_DT        (1.0f / 60.0f)
+#define ASPECT        (1080.0f / 2400.0f)
+
+struct CapResult {
+    int peak;      // 存活粒子数峰值（CPU 粒子池 + GPU 常驻）
+    int capped;
+};
+
+static bool run(int level, bool gpuResident, int frames, uint64_t seed, JobSystem *jobs, CapResult *result) {
+    FireworksSim sim;
+    if (fireworks_sim_init(&sim, MAX_PARTICLES, MAX_PARTICLES, SPAWN_BUDGET, jobs, seed) != 0) {
+        return false;
+    }
+    sim.aspect = ASPECT;
+    FireworksQuality quality;
+    quality_level_settings(level, &quality);
+    fireworks_sim_set_quality(&sim, &quality);
+    fireworks_sim_set_gpu_resident(&sim, gpuResident);
+
+    std::vector<float> gpuLives;   // GPU 上各粒子的剩余寿命
+    result->peak = 0;
+    for (int f = 0; f < frames; f++) {
+        int events = fireworks_sim_step(&sim, SIM_DT);
+        if (gpuResident) {
+            if (events & FIREWORKS_EVENT_TEXT) {
+                gpuLives.clear();
+            }
+            // 旧粒子推进一步后去掉死亡的，再加入本步上传的（GPU 上新粒子当步就推进，这里多算一步，偏保守）
+            for (float &life : gpuLives) {
+                life -= SIM_DT;
+            }
+            gpuLives.erase(std::remove_if(gpuLives.begin(), gpuLives.end(), [](float life) { return life <= 0.0f; }),
+                           gpuLives.end());
+            const ParticlePool *staged = &sim.gpuSpawns.staged;
+            gpuLives.insert(gpuLives.end(), staged->life, staged->life + staged->count);
+            particle_spawn_reset(&sim.gpuSpawns);
+        }
+        result->peak = std::max(result->peak, sim.particles.count + (int) gpuLives.size());
+    }
+    result->capped = sim.cappedSpawns;
+    fireworks_sim_free(&sim);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 700;
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+    JobSystem *jobs = job_system_create(1);
+    if (jobs == nullptr) {
+        fprintf(stderr, "init failed\n");
+        return 1;
+    }
+
+    bool ok = true;
+    printf("%d frames, seed %llu\n", frames, (unsigned long long) seed);
+    printf("%-6s %-5s %6s %6s %8s\n", "level", "mode", "cap", "peak", "capped");
+    for (int level = 0; level <= QUALITY_LEVEL_FULL; level++) {
+        FireworksQuality quality;
+        quality_level_settings(level, &quality);
+        for (int gpu = 0; gpu < 2; gpu++) {
+            CapResult result;
+            if (!run(level, gpu != 0, frames, seed, jobs, &result)) {
+                fprintf(stderr, "init failed\n");
+                return 1;
+            }
+            bool pass = level < QUALITY_LEVEL_FULL
+                        ? result.capped > 0 && result.peak <= quality.maxParticles
+                        : result.capped == 0;
+            ok = ok && pass;
+            printf("%-6d %-5s %6d %6d %8d%s\n", level, gpu ? "gpu" : "cpu", quality.maxParticles, result.peak,
+                   result.capped, pass ? "" : "  FAIL");
+        }
+    }
+    job_system_destroy(jobs);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#include "job_system.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Job {
+    JobFunc func;
+    void *ctx;
+    int begin;
+    int end;
+    int grain;
+    JobGroup *group;
+};
+
+struct Worker {
+    std::mutex mutex;
+    std::deque<Job> deque;  // 队尾归本线程，队首供其它线程窃取
+    std::thread thread;
+};
+
+} // namespace
+
+struct JobSystem {
+    std::vector<Worker *> workers;
+    std::atomic<int> queued{0};     // 所有队列中的任务总数
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool quit = false;
+};
+
+// 当前线程在任务系统中的编号，非工作线程为 -1
+static thread_local int tls_worker_index = -1;
+
+static void push_job(JobSystem *jobs, int self, const Job &job) {
+    __atomic_fetch_add(&job.group->pending, 1, __ATOMIC_ACQ_REL);
+    Worker *worker = jobs->workers[self];
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->deque.push_back(job);
+    }
+    jobs->queued.fetch_add(1, std::memory_order_release);
+    {
+        // 加锁后再通知，避免与正在进入等待的线程错过唤醒
+        std::lock_guard<std::mutex> lock(jobs->sleepMutex);
+    }
+    jobs->wake.notify_one();
+}
+
+// 先从自己的队尾取，再依次从其它线程的队首窃取
+static bool take_job(JobSystem *jobs, int self, Job *out) {
+    int n = (int) jobs->workers.size();
+    for (int k = 0; k < n; k++) {
+        int victim = (self + k) % n;
+        Worker *worker = jobs->workers[victim];
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (worker->deque.empty()) {
+            continue;
+        }
+        if (k == 0) {
+            *out = worker->deque.back();
+            worker->deque.pop_back();
+        } else {
+            *out = worker->deque.front();
+            worker->deque.pop_front();
+        }
+        jobs->queued.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+// 执行任务：区间超过 grain 时把后半段 fork 回本线程队列（可被窃取），前半段继续拆分
+static void run_job(JobSystem *jobs, int self, Job job) {
+    for (;;) {
+        int length = job.end - job.begin;
+        int chunks = (length + job.grain - 1) / job.grain;
+        if (chunks <= 1) {
+            break;
+        }
+        int mid = job.begin + (chunks / 2) * job.grain;
+        Job rest = job;
+        rest.begin = mid;
+        push_job(jobs, self, rest);
+        job.end = mid;
+    }
+    if (job.end > job.begin) {
+        job.func(job.ctx, job.begin, job.end);
+    }
+    __atomic_fetch_sub(&job.group->pending, 1, __ATOMIC_ACQ_REL);
+}
+
+static void worker_main(JobSystem *jobs, int self) {
+    tls_worker_index = self;
+    for (;;) {
+        Job job;
+        if (take_job(jobs, self, &job)) {
+            run_job(jobs, self, job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(jobs->sleepMutex);
+        jobs->wake.wait(lock, [jobs] {
+            return jobs->quit || jobs->queued.load(std::memory_order_acquire) > 0;
+        });
+        if (jobs->quit) {
+            return;
+        }
+    }
+}
+
+JobSystem *job_system_create(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        if (threadCount <= 0) {
+            threadCount = 1;
+        }
+    }
+    auto *jobs = new JobSystem();
+    for (int i = 0; i < threadCount; i++) {
+        jobs->workers.push_back(new Worker());
+    }
+    tls_worker_index = 0;
+    for (int i = 1; i < threadCount; i++) {
+        jobs->workers[i]->thread = std::thread(worker_main, jobs, i);
+    }
+    return jobs;
+}
+
+void job_system_destroy(JobSystem *jobs) {
+    if (jobs == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(jobs->sleepMutex);
+        jobs->quit = true;
+    }
+    jobs->wake.notify_all();
+    for (Worker *worker : jobs->workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+        delete worker;
+    }
+    delete jobs;
+}
+
+int job_system_thread_count(const JobSystem *jobs) {
+    return (int) jobs->workers.size();
+}
+
+void job_system_fork(JobSystem *jobs, JobGroup *group, JobFunc func, void *ctx,
+                     int begin, int end, int grain) {
+    int self = tls_worker_index < 0 ? 0 : tls_worker_index;
+    Job job = {func, ctx, begin, end, grain > 0 ? grain : 1, group};
+    push_job(jobs, self, job);
+}
+
+void job_system_join(JobSystem *jobs, JobGroup *group) {
+    int self = tls_worker_index < 0 ? 0 : tls_worker_index;
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+        Job job;
+        if (take_job(jobs, self, &job)) {
+            run_job(jobs, self, job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void job_system_parallel_for(JobSystem *jobs, int count, int grain, JobFunc func, void *ctx) {
+    if (count <= 0) {
+        return;
+    }
+    if (grain <= 0) {
+        grain = 1;
+    }
+    // 只有一个线程或区间不足两块时直接在本线程执行，省去入队开销
+    if (jobs == nullptr || jobs->workers.size() == 1 || count <= grain) {
+        func(ctx, 0, count);
+        return;
+    }
+    JobGroup group = {0};
+    job_system_fork(jobs, &group, func, ctx, 0, count, grain);
+    job_system_join(jobs, &group);
+}
@@ -0,0 +1,34 @@
+#ifndef NATIVE_ACTIVITY_JOB_SYSTEM_H
+#define NATIVE_ACTIVITY_JOB_SYSTEM_H
+
+// ---------- 工作窃取任务系统 ----------
+// 每个工作线程有自己的双端队列：自己从队尾压入/弹出，空闲线程从别人的队首窃取。
+// 调用 job_system_create 的线程是 0 号工作线程，fork/join 只能在该线程上发起；
+// 该线程不再使用任务系统时，可以交给另一个线程（如模拟流水线线程）接着发起，同一时刻只能有一个发起者。
+
+typedef struct JobSystem JobSystem;
+
+// 处理 [begin, end) 区间的任务函数
+typedef void (*JobFunc)(void *ctx, int begin, int end);
+
+// 一组 fork 出去的任务，join 等待全部完成
+typedef struct JobGroup {
+    int pending;  // 由任务系统原子维护，调用方只需清零
+} JobGroup;
+
+// 创建包含 threadCount 个工作线程（含调用线程）的任务系统，threadCount <= 0 时使用全部在线核心
+JobSystem *job_system_create(int threadCount);
+void job_system_destroy(JobSystem *jobs);
+int job_system_thread_count(const JobSystem *jobs);
+
+// fork：把 [begin, end) 作为一个任务放入当前线程的队列，区间大于 grain 时执行时继续对半拆分
+void job_system_fork(JobSystem *jobs, JobGroup *group, JobFunc func, void *ctx,
+                     int begin, int end, int grain);
+// join：等待组内任务全部完成，等待期间当前线程也执行/窃取任务
+void job_system_join(JobSystem *jobs, JobGroup *group);
+
+// fork + join 的便捷形式。拆分点总是 grain 的整数倍，与线程数无关，
+// 只要任务函数对各区间的写入互不重叠，结果就与线程数无关。
+void job_system_parallel_for(JobSystem *jobs, int count, int grain, JobFunc func, void *ctx);
+
+#endif //NATIVE_ACTIVITY_JOB_SYSTEM_H
@@ -1,6 +1,7 @@
 #include <initializer_list>
 #include <memory>
 #include <cstdlib>
+#include <cstddef>
 #include <cstring>
 #include <jni.h>
 #include <cerrno>
@@ -11,43 +12,127 @@
 #include <GLES3/gl3ext.h>
 #include <android/sensor.h>
 #include <android/log.h>
+#include <android/asset_manager.h>
 #include <android_native_app_glue.h>
 #include <time.h>
 #include <math.h>
 #include <dlfcn.h>
+#include <sys/system_properties.h>
 #include "../utils/utils.h"  // 保留你的工具头文件（如有）
+#include "fireworks_sim.h"
+#include "fireworks_snapshot.h"
+#include "gpu_particle_sim.h"
+#include "gpu_timer.h"
+#include "motion_field.h"
+#include "particle_quads.h"
+#include "particle_target.h"
+#include "program_cache.h"
+#include "quality_governor.h"
+#include "sim_pipeline.h"
+#include "stream_buffer.h"
+
+// file_compat 在 Android 上通过这个宏取得 Activity（调用 JNI 的 getCacheDir 等），只在能访问 engine 的函数里使用
+#define FILE_COMPAT_ANDROID_ACTIVITY (engine->app->activity)
+#include "deps/file_compat.h"
 
 #define LOGI(...) ((void)__android_log_print(ANDROID_LOG_INFO, "native-activity", __VA_ARGS__))
 #define LOGW(...) ((void)__android_log_print(ANDROID_LOG_WARN, "native-activity", __VA_ARGS__))
 
 // ---------- 粒子系统常量 ----------
-#define MAX_PARTICLES        8000
-#define PARTICLE_LIFETIME    2.0f
-#define ROCKET_LIFETIME      1.8f
-#define EXPLOSION_COUNT      35
-#define TRAIL_COUNT          3     // 每个火箭每帧产生尾迹粒子数
-#define FIREWORK_COOLDOWN    0.25f // 生成火箭的间隔
-#define TEXT_PARTICLE_COUNT  1200  // 文字爆炸粒子数
-
-// ---------- 粒子类型 ----------
-enum ParticleType {
-    PARTICLE_ROCKET,
-    PARTICLE_EXPLOSION,
-    PARTICLE_TRAIL,
-    PARTICLE_TEXT
+// 场景本身（火箭、爆炸、文字）在 sim/fireworks_sim.cpp
+#define INITIAL_PARTICLES    8192  // 粒子池初始容量，需要时扩容到内存预算允许的上限
+#define SPAWN_BUDGET         2048  // 每个模拟步最多接受的发射请求数
+#define GPU_PARTICLE_CAPACITY 65536 // GPU 后端的粒子槽位数
+
+// 剔除与细节层次：adb shell setprop debug.fireworks.lod off|cull|merge（默认 cull）
+enum LodMode {
+    LOD_OFF,
+    LOD_CULL,    // 丢弃屏幕外、过淡、过小的粒子
+    LOD_MERGE,   // 同上，但过小的粒子按屏幕瓦片合并成聚合点
+    LOD_MODE_COUNT
+};
+static const char *kLodModeNames[LOD_MODE_COUNT] = {"off", "cull", "merge"};
+#define LOD_MIN_SIZE         1.0f   // 像素
+#define LOD_MIN_ALPHA        (0.5f / 255.0f) // 量化后为 0
+#define LOD_MERGE_TILE       8.0f   // 合并瓦片边长（像素）
+
+// 降分辨率粒子渲染：adb shell setprop debug.fireworks.lowres 1|2|4（默认 1，全分辨率），
+// debug.fireworks.upsample bilinear|bicubic 选择放大滤波；四指点击在 1、1/2、1/4 之间切换。
+// debug.fireworks.lowres_measure 1 为测量模式：全分辨率也画进离屏纹理再合成，各档 GPU 时间可以相互比较
+static const int kParticleDivisors[] = {1, 2, 4};
+#define PARTICLE_DIVISOR_COUNT 3
+static const char *kUpsampleNames[PARTICLE_UPSAMPLE_COUNT] = {"bilinear", "bicubic"};
+#define GPU_TIME_LOG_FRAMES  600   // 每隔多少帧输出一次粒子绘制的 GPU 耗时
+
+// CPU 粒子的图元：adb shell setprop debug.fireworks.sprites points|quads（默认 points）
+// quads 为实例化四边形，不受点大小上限限制，并沿运动方向旋转拉伸；GPU 常驻粒子仍画点精灵
+enum SpriteMode {
+    SPRITE_POINTS,
+    SPRITE_QUADS,
+    SPRITE_MODE_COUNT
+};
+static const char *kSpriteModeNames[SPRITE_MODE_COUNT] = {"points", "quads"};
+#define SPRITE_STRETCH       2.0f   // 四边形拉伸长度为最近一步位移的倍数
+
+// 画质调节：adb shell setprop debug.fireworks.quality auto|0|1|2|3|4（默认 auto，按帧耗时自动调节；
+// 数字为固定档位，4 为全画质）
+#define QUALITY_AUTO         (-1)
+
+// 固定步长模拟：与屏幕刷新率无关，渲染时在最近两步之间插值
+#define SIM_HZ               60
+#define SIM_DT               (1.0f / SIM_HZ)
+#define SIM_MAX_STEPS        4     // 每帧最多补算的步数，卡顿后超出的时间直接丢弃
+
+// 加速度计：主循环成批取出事件写入 MotionField 的环形缓冲，每帧低通一次，作为全局加速度作用于全部粒子
+#define SENSOR_BATCH         16    // 每次 ASensorEventQueue_getEvents 取出的事件数
+#define MOTION_CUTOFF_HZ     1.5f  // 低通截止频率，滤掉手抖，保留倾斜
+#define MOTION_SCALE         (0.5f / MOTION_FIELD_GRAVITY) // 侧倾 90° 时约等于爆炸粒子自身的重力
+#define MOTION_LIMIT         0.6f  // 场景加速度上限（甩动时不至于把粒子甩出屏幕）
+
+// 模拟与渲染的调度（adb shell setprop debug.fireworks.pipeline serial 退回串行）：
+// 流水线模式下模拟线程推进下一帧的同时渲染线程绘制本帧，延迟多一帧；只用于 CPU 后端，
+// GPU 后端的模拟步要发 GL 命令，仍在渲染线程上串行执行
+enum SimSchedule {
+    SCHEDULE_SERIAL,
+    SCHEDULE_PIPELINED,
+    SCHEDULE_COUNT
+};
+static const char *kScheduleNames[SCHEDULE_COUNT] = {"serial", "pipelined"};
+
+// 触摸交互：按住的手指吸引火花，松手后在原处短暂排斥（adb shell setprop debug.fireworks.interact full）
+enum InteractMode {
+    INTERACT_OFF,
+    INTERACT_TOUCH,       // 触摸点吸引/排斥
+    INTERACT_FULL,        // 另加火花碰撞和屏幕边缘反弹
+    INTERACT_MODE_COUNT
+};
+static const char *kInteractModeNames[INTERACT_MODE_COUNT] = {"off", "touch", "full"};
+#define TOUCH_RADIUS         0.35f // 世界单位（屏幕高度为 2）
+#define TOUCH_ATTRACT        2.0f  // 中心处的吸引加速度
+#define TOUCH_REPULSE        3.0f  // 松手瞬间的排斥加速度，随后线性减弱
+#define TOUCH_REPULSE_TIME   0.35f // 秒
+#define COLLISION_RADIUS_PX  8.0f
+#define COLLISION_STIFFNESS  4.0f
+#define BOUNCE_RESTITUTION   0.6f
+#define GESTURE_MIN_POINTERS 3     // 三指及以上的点击是切换手势，不产生吸引点
+
+// 一个触摸点：按下期间 held，松手后 repulse 倒计时（秒），两者都为 0 时槽位空闲
+struct TouchPoint {
+    int32_t id;
+    int   held;
+    float repulse;
+    float x, y;          // 世界坐标
 };
 
-// ---------- 粒子结构 ----------
-typedef struct Particle {
-    float x, y;          // 位置
-    float vx, vy;        // 速度
-    float ax, ay;        // 加速度
-    float r, g, b, a;    // 颜色
-    float size;          // 大小
-    float life;          // 剩余生命
-    float maxLife;       // 最大生命
-    int type;            // 粒子类型
-} Particle;
+// ---------- 模拟后端 ----------
+// 通过 `adb shell setprop debug.fireworks.sim cpu|tf|compute` 选择，三指点击可在运行时切换
+enum SimBackend {
+    SIM_BACKEND_CPU,
+    SIM_BACKEND_GPU_FEEDBACK,   // ES 3.0 变换反馈
+    SIM_BACKEND_GPU_COMPUTE,    // ES 3.1 计算着色器
+    SIM_BACKEND_COUNT
+};
+static const char *kSimBackendNames[SIM_BACKEND_COUNT] = {"cpu", "tf", "compute"};
 
 // ---------- 保存的状态（兼容原有结构） ----------
 struct saved_state {
@@ -55,19 +140,44 @@ struct saved_state {
     int32_t x;
     int32_t y;
     struct timeval startTime;
+    int32_t snapshot;    // SnapshotLocation
 };
 
+// 模拟快照：不大时直接跟在 saved_state 后面（savedState 经 Bundle 保存，体积有限），
+// 否则写到应用数据目录，saved_state 里只记录位置
+enum SnapshotLocation {
+    SNAPSHOT_NONE,
+    SNAPSHOT_INLINE,
+    SNAPSHOT_FILE
+};
+#define SNAPSHOT_INLINE_MAX  (256 * 1024)
+#define SNAPSHOT_FILE_NAME   "fireworks.snapshot"
+
 // ---------- OpenGL 资源结构 ----------
 struct glstruct {
     GLuint program;      // 粒子着色器程序
-    GLuint vertexShader;
-    GLuint fragmentShader;
     GLuint texture;      // 粒子纹理（圆形渐变）
     GLint  uMatrix;
     GLint  uTexture;
+    GLint  uSizeScale;   // 点大小换算系数（压缩顶点为定点，GPU 状态为 float）
     GLint  aPosition;
     GLint  aColor;
     GLint  aSize;
+    GLuint particleVao;              // 粒子顶点格式（指向流式缓冲）
+    StreamBuffer particleStream;     // 每帧粒子顶点的三段环形缓冲
+    ParticleQuadRenderer quads;      // 实例化四边形路径，逐实例数据同样来自流式缓冲
+    int spriteMode;                  // SpriteMode
+};
+
+// 启动各阶段的单调时钟时间（纳秒，0 表示尚未发生），首帧后输出一次
+struct StartupTimes {
+    int64_t startNs;       // 进入 android_main
+    int64_t contextNs;     // 上下文可用
+    int64_t resourcesNs;   // 着色器程序、纹理等与窗口无关的资源就绪
+    int64_t windowNs;      // 处理 APP_CMD_INIT_WINDOW
+    int64_t boundNs;       // 窗口表面绑定到上下文
+    int64_t firstFrameNs;  // 第一次 eglSwapBuffers 返回
+    int early;             // 窗口到达前就建立上下文
 };
 
 // ---------- 引擎主结构 ----------
@@ -76,23 +186,65 @@ struct engine {
     ASensorManager *sensorManager;
     const ASensor *accelerometerSensor;
     ASensorEventQueue *sensorEventQueue;
+    MotionField motion;          // 加速度计样本环形缓冲与低通后的全局加速度
+    int   interactMode;          // InteractMode
+    TouchPoint touches[PARTICLE_MAX_ATTRACTORS];
+    int   gesturePointers;       // 本次触摸序列中同时按下的最多手指数，达到 GESTURE_MIN_POINTERS 即为多指手势
     int animating;
     EGLDisplay display;
     EGLSurface surface;
     EGLContext context;
+    EGLConfig config;
+    EGLSurface bootstrapSurface; // 没有 surfaceless 扩展时窗口到达前使用的 1x1 pbuffer
+    int glReady;                 // 上下文和与窗口无关的 GL 资源已就绪
+    StartupTimes startup;
     int32_t width;
     int32_t height;
     struct saved_state state;
     struct glstruct gldata;
 
-    // 粒子系统数据
-    Particle particles[MAX_PARTICLES];
-    int particleCount;
-    float fireworkTimer;       // 火箭发射计时器
-    float totalTime;          // 总运行时间
-    int   textSpawned;        // 文字是否已生成
-    float exitTimer;         // 退出倒计时
-    int   shouldExit;        // 是否需要退出
+    // 烟花场景（SoA 粒子池、发射缓冲、随机数和场景计时）
+    FireworksSim sim;
+    JobSystem *jobs;             // 积分和顶点打包的分块并行
+    AAsset *textAsset;           // 文字点云资源，保持打开以使用其内存映射
+
+    // GPU 模拟后端：火箭仍在 CPU 上模拟，其余粒子经 sim.gpuSpawns 上传后常驻 GPU
+    int simBackend;
+    GpuParticleSim gpuSim;
+    int64_t lastFrameNs;       // 上一帧的单调时钟时间，0 表示尚未开始
+    float simAccumulator;      // 尚未模拟的时间（不足一步的部分）
+    int   skippedSteps;        // 因超过 SIM_MAX_STEPS 被丢弃的步数
+    int   lodMode;             // LodMode
+    int   clockRestart;        // 下一次推进时从一步开始计时（恢复绘制后），与 pendingDt 都属于模拟状态
+    float pendingDt;           // 下一次推进要消耗的真实时间
+
+    // 流水线：模拟线程推进粒子池并打包到 SimFrame，渲染线程只读交回的帧。
+    // 除 sim_pipeline_acquire/reset 之后、submit 之前外，渲染线程不能访问 sim
+    SimPipeline *pipeline;     // 串行模式为 NULL
+    SimPipelineStats frameStats;
+    int64_t lastInputNs;       // 上一次处理过的帧（流水刚开始时同一帧会交回两次）
+    ParticleCullStats cullStats; // 累计剔除统计
+
+    // 降分辨率粒子目标与粒子绘制（含合成）的 GPU 耗时，按分辨率分别累计
+    ParticleTarget particleTarget;
+    GpuTimer particleTimer;
+    int   particleDivisor;     // kParticleDivisors 下标
+    int   timerWarmup;         // 切换分辨率后仍属于旧设置的查询数，其结果丢弃
+    int   timedFrames;
+    double particleGpuMs[PARTICLE_DIVISOR_COUNT];
+    int   particleGpuSamples[PARTICLE_DIVISOR_COUNT];
+
+    // 画质调节器：CPU 帧耗时（模拟到提交绘制）和粒子绘制的 GPU 耗时对比刷新周期
+    QualityGovernor governor;
+    int   qualityAuto;         // 0 表示固定档位，不随帧耗时调节
+    float refreshHz;
+
+    // 着色器程序二进制缓存（应用缓存目录），恢复时跳过编译
+    ProgramCache programCache;
+
+#if FRAME_PROFILER_ENABLED
+    FrameProfiler profiler;    // 最近若干帧的分阶段 CPU 耗时，sim.profiler 指向这里
+#endif
 };
 
 // ---------- 正交投影矩阵（工具函数，保留） ----------
@@ -115,25 +267,6 @@ static void orthoM(float* m, int offset, float left, float right, float bottom,
     m[offset + 15] = 1;
 }
 
-// ---------- 着色器编译检查 ----------
-static void checkShaderCompile(GLuint shader) {
-    GLint compiled;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-    GLint infoLen = 0;
-    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
-    if (!compiled) {
-        if (infoLen > 1) {
-            char *infoLog = (char *) malloc(sizeof(char) * infoLen);
-            glGetShaderInfoLog(shader, infoLen, NULL, infoLog);
-            LOGW("Error compiling shader:[%s]", infoLog);
-            free(infoLog);
-        }
-        glDeleteShader(shader);
-    } else {
-        LOGI("Shader compiled successfully");
-    }
-}
-
 // ---------- 创建圆形渐变纹理 ----------
 static GLuint createCircleTexture() {
     const int texSize = 64;
@@ -166,16 +299,18 @@ static GLuint createCircleTexture() {
 // ---------- 初始化粒子着色器 ----------
 static int init_particle_shader(struct engine *engine) {
     // 顶点着色器：仅传递位置、颜色、点大小，并计算点精灵坐标
+    // 位置为半精度、颜色为归一化 RGBA8，由顶点格式自动转换；大小乘 uSizeScale 还原成像素
     const char* vertexShaderSrc =
         "#version 300 es\n"
         "uniform mat4 uMatrix;\n"
+        "uniform float uSizeScale;\n"
         "layout(location = 0) in vec2 aPosition;\n"
         "layout(location = 1) in vec4 aColor;\n"
         "layout(location = 2) in float aSize;\n"
         "out vec4 vColor;\n"
         "void main() {\n"
         "    gl_Position = uMatrix * vec4(aPosition, 0.0, 1.0);\n"
-        "    gl_PointSize = aSize;\n"
+        "    gl_PointSize = aSize * uSizeScale;\n"
         "    vColor = aColor;\n"
         "}\n";
 
@@ -191,34 +326,18 @@ static int init_particle_shader(struct engine *engine) {
         "    fragColor = vColor * texColor;\n"
         "}\n";
 
-    GLuint program = glCreateProgram();
-    GLuint vert = glCreateShader(GL_VERTEX_SHADER);
-    GLuint frag = glCreateShader(GL_FRAGMENT_SHADER);
-
-    glShaderSource(vert, 1, &vertexShaderSrc, NULL);
-    glCompileShader(vert);
-    checkShaderCompile(vert);
-
-    glShaderSource(frag, 1, &fragmentShaderSrc, NULL);
-    glCompileShader(frag);
-    checkShaderCompile(frag);
-
-    glAttachShader(program, vert);
-    glAttachShader(program, frag);
-    glLinkProgram(program);
-
-    GLint linked;
-    glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    if (!linked) {
+    // 属性位置由着色器的 layout 指定，不需要在链接前绑定
+    GLuint program = program_cache_link(&engine->programCache, "particle points", vertexShaderSrc,
+                                        fragmentShaderSrc, nullptr, nullptr, 0);
+    if (program == 0) {
         LOGW("Particle program link failed");
         return -1;
     }
 
     engine->gldata.program = program;
-    engine->gldata.vertexShader = vert;
-    engine->gldata.fragmentShader = frag;
     engine->gldata.uMatrix = glGetUniformLocation(program, "uMatrix");
     engine->gldata.uTexture = glGetUniformLocation(program, "uTexture");
+    engine->gldata.uSizeScale = glGetUniformLocation(program, "uSizeScale");
     engine->gldata.aPosition = 0;
     engine->gldata.aColor = 1;
     engine->gldata.aSize = 2;
@@ -226,30 +345,282 @@ static int init_particle_shader(struct engine *engine) {
     // 创建纹理
     engine->gldata.texture = createCircleTexture();
 
+    // 流式顶点缓冲与 VAO：属性格式只设置一次，每帧通过 glDrawArrays 的 first 选择写入的段
+    const GLsizei stride = sizeof(ParticleVertex);
+    if (stream_buffer_init(&engine->gldata.particleStream, GL_ARRAY_BUFFER,
+                           INITIAL_PARTICLES * stride, stride, STREAM_BUFFER_UNSYNCHRONIZED) != 0) {
+        LOGW("particle stream buffer init failed");
+        return -1;
+    }
+    glGenVertexArrays(1, &engine->gldata.particleVao);
+    glBindVertexArray(engine->gldata.particleVao);
+    glBindBuffer(GL_ARRAY_BUFFER, engine->gldata.particleStream.buffer);
+    glVertexAttribPointer(engine->gldata.aPosition, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+                          (void *) offsetof(ParticleVertex, x));
+    glVertexAttribPointer(engine->gldata.aColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void *) offsetof(ParticleVertex, r));
+    glVertexAttribPointer(engine->gldata.aSize, 1, GL_UNSIGNED_SHORT, GL_FALSE, stride,
+                          (void *) offsetof(ParticleVertex, size));
+    glEnableVertexAttribArray(engine->gldata.aPosition);
+    glEnableVertexAttribArray(engine->gldata.aColor);
+    glEnableVertexAttribArray(engine->gldata.aSize);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (particle_quads_init(&engine->gldata.quads, engine->gldata.particleStream.buffer) != 0) {
+        LOGW("particle quad shader init failed");
+        return -1;
+    }
+    GLfloat pointRange[2] = {0.0f, 0.0f};
+    glGetFloatv(GL_ALIASED_POINT_SIZE_RANGE, pointRange);
+    LOGI("point size range: %.0f - %.0f px", pointRange[0], pointRange[1]);
+
+    return 0;
+}
+
+// ---------- 调试属性（adb shell setprop debug.fireworks.*） ----------
+// 取值为 names 中的一项时返回其下标，未设置或不认识时返回 fallback
+static int read_enum_property(const char *name, const char *const *names, int count, int fallback) {
+    char value[PROP_VALUE_MAX] = "";
+    __system_property_get(name, value);
+    for (int i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) {
+            return i;
+        }
+    }
+    return fallback;
+}
+
+static int read_sim_backend_property() {
+    return read_enum_property("debug.fireworks.sim", kSimBackendNames, SIM_BACKEND_COUNT, SIM_BACKEND_CPU);
+}
+
+// 随机种子：adb shell setprop debug.fireworks.seed 12345，未设置时按当前时间
+static uint64_t read_seed_property() {
+    char value[PROP_VALUE_MAX] = "";
+    if (__system_property_get("debug.fireworks.seed", value) > 0) {
+        return strtoull(value, nullptr, 10);
+    }
+    return (uint64_t) time(NULL);
+}
+
+static int read_lod_property() {
+    return read_enum_property("debug.fireworks.lod", kLodModeNames, LOD_MODE_COUNT, LOD_CULL);
+}
+
+static int read_interact_property() {
+    return read_enum_property("debug.fireworks.interact", kInteractModeNames, INTERACT_MODE_COUNT, INTERACT_TOUCH);
+}
+
+// 窗口到达前建立上下文并编译着色器：adb shell setprop debug.fireworks.early_gl 0 关闭（用于对比启动耗时）
+static int read_early_gl_property() {
+    char value[PROP_VALUE_MAX] = "";
+    __system_property_get("debug.fireworks.early_gl", value);
+    return strcmp(value, "0") != 0;
+}
+
+static int read_schedule_property() {
+    return read_enum_property("debug.fireworks.pipeline", kScheduleNames, SCHEDULE_COUNT, SCHEDULE_PIPELINED);
+}
+
+static int read_sprite_property() {
+    return read_enum_property("debug.fireworks.sprites", kSpriteModeNames, SPRITE_MODE_COUNT, SPRITE_POINTS);
+}
+
+static int read_quality_property() {
+    char value[PROP_VALUE_MAX] = "";
+    if (__system_property_get("debug.fireworks.quality", value) > 0 && value[0] >= '0' && value[0] <= '9') {
+        int level = atoi(value);
+        return level < QUALITY_LEVEL_FULL ? level : QUALITY_LEVEL_FULL;
+    }
+    return QUALITY_AUTO;
+}
+
+static int read_lowres_property() {
+    char value[PROP_VALUE_MAX] = "";
+    __system_property_get("debug.fireworks.lowres", value);
+    int divisor = atoi(value);
+    for (int i = 0; i < PARTICLE_DIVISOR_COUNT; i++) {
+        if (kParticleDivisors[i] == divisor) {
+            return i;
+        }
+    }
     return 0;
 }
 
+static int read_lowres_measure_property() {
+    char value[PROP_VALUE_MAX] = "";
+    __system_property_get("debug.fireworks.lowres_measure", value);
+    return strcmp(value, "1") == 0;
+}
+
+static int read_upsample_property() {
+    return read_enum_property("debug.fireworks.upsample", kUpsampleNames, PARTICLE_UPSAMPLE_COUNT,
+                              PARTICLE_UPSAMPLE_BILINEAR);
+}
+
+// 粒子池内存预算：adb shell setprop debug.fireworks.pool_mb 128，未设置时按设备档次
+static size_t read_pool_budget_property() {
+    char value[PROP_VALUE_MAX] = "";
+    if (__system_property_get("debug.fireworks.pool_mb", value) > 0 && atoi(value) > 0) {
+        return (size_t) atoi(value) << 20;
+    }
+    int deviceClass = particle_device_class();
+    LOGI("device class: %s", particle_device_class_name(deviceClass));
+    return particle_device_budget(deviceClass);
+}
+
+static void log_cull_stats(const struct engine *engine) {
+    const ParticleCullStats *stats = &engine->cullStats;
+    double input = stats->input > 0 ? (double) stats->input : 1.0;
+    LOGI("lod %s: %lld particles -> %lld vertices (%.1f%%): offscreen %lld, faint %lld, tiny %lld, "
+         "%lld aggregates", kLodModeNames[engine->lodMode], (long long) stats->input,
+         (long long) stats->output, 100.0 * stats->output / input, (long long) stats->offscreen,
+         (long long) stats->faint, (long long) stats->tiny, (long long) stats->aggregates);
+}
+
+static void log_quality(const struct engine *engine, const char *reason) {
+    const QualityGovernor *governor = &engine->governor;
+    const FireworksQuality *quality = &governor->current;
+    LOGI("quality %s: level %d/%d%s, cpu %.2f ms, gpu %.2f ms, budget %.2f ms (%.0f Hz), "
+         "emission x%.2f, cooldown x%.2f, size x%.2f, cap %d particles (0 = none), %d changes, "
+         "%d spawns capped",
+         reason, governor->level, QUALITY_LEVEL_FULL, engine->qualityAuto ? "" : " (fixed)",
+         governor->cpuMs, governor->gpuMs, governor->budgetMs, engine->refreshHz,
+         quality->emission, quality->cooldown, quality->size, quality->maxParticles,
+         governor->changes, engine->sim.cappedSpawns);
+}
+
+// 只统计画进离屏纹理的帧（FBO 切换和合成迫使光栅化在查询内完成）；直接画到默认帧缓冲时
+// tiler 把光栅化推迟到交换缓冲，落在查询之外，所以 1/1 只在 lowres_measure 测量模式下有数据
+static void log_particle_gpu_time(const struct engine *engine) {
+    if (!engine->particleTimer.supported) {
+        return;
+    }
+    const int fullSamples = engine->particleGpuSamples[0];
+    const double fullMs = fullSamples > 0 ? engine->particleGpuMs[0] / fullSamples : 0.0;
+    for (int i = 0; i < PARTICLE_DIVISOR_COUNT; i++) {
+        int samples = engine->particleGpuSamples[i];
+        if (samples == 0) {
+            continue;
+        }
+        double ms = engine->particleGpuMs[i] / samples;
+        if (fullMs > 0.0 && ms > 0.0) {
+            LOGI("particle pass 1/%d: %.3f ms gpu (%d frames), %.2fx vs 1/1", kParticleDivisors[i], ms, samples,
+                 fullMs / ms);
+        } else {
+            LOGI("particle pass 1/%d: %.3f ms gpu (%d frames), 1/1 not measured (debug.fireworks.lowres_measure 1)",
+                 kParticleDivisors[i], ms, samples);
+        }
+    }
+}
+
+// 切换粒子渲染分辨率（需要 GL 上下文），创建失败时回到全分辨率
+static void engine_set_particle_resolution(struct engine *engine, int index) {
+    ParticleTarget *target = &engine->particleTarget;
+    if (particle_target_resize(target, engine->width, engine->height, kParticleDivisors[index]) != 0) {
+        LOGW("low resolution particle target unavailable, drawing at full resolution");
+        index = 0;
+    }
+    engine->particleDivisor = index;
+    engine->timerWarmup = GPU_TIMER_QUERIES;
+    LOGI("particle resolution: 1/%d (%dx%d, %s%s)", kParticleDivisors[index],
+         index > 0 ? target->width : engine->width, index > 0 ? target->height : engine->height,
+         kUpsampleNames[target->filter], index == 0 && target->framebuffer != 0 ? ", offscreen measure" : "");
+}
+
+static void log_pool_metrics(const ParticlePool *pool) {
+    static const char *pageNames[] = {"normal", "transparent huge", "hugetlb"};
+    ParticlePoolMetrics metrics;
+    particle_pool_metrics(pool, &metrics);
+    LOGI("particle pool: %d/%d used, capacity %d of %d (%d grows), %d evictions, "
+         "%.1f MB committed of %.1f MB reserved, %s pages",
+         metrics.used, metrics.capacity, metrics.capacity, metrics.maxCapacity, metrics.grows,
+         metrics.evictions, metrics.committedBytes / 1048576.0, metrics.reservedBytes / 1048576.0,
+         pageNames[metrics.pages]);
+}
+
+// 切换模拟后端（需要 GL 上下文）。GPU 上的粒子不迁移，CPU 池中已有的粒子自然消亡。
+static void engine_set_sim_backend(struct engine *engine, int backend) {
+    if (engine->pipeline != nullptr) {
+        sim_pipeline_reset(engine->pipeline);
+    }
+    gpu_particle_sim_free(&engine->gpuSim);
+    if (backend == SIM_BACKEND_GPU_COMPUTE && !gpu_particle_sim_supports_compute()) {
+        LOGW("compute shaders unavailable, using transform feedback");
+        backend = SIM_BACKEND_GPU_FEEDBACK;
+    }
+    if (backend != SIM_BACKEND_CPU) {
+        int mode = backend == SIM_BACKEND_GPU_COMPUTE ? GPU_SIM_COMPUTE : GPU_SIM_TRANSFORM_FEEDBACK;
+        if (gpu_particle_sim_init(&engine->gpuSim, mode, GPU_PARTICLE_CAPACITY) != 0) {
+            LOGW("gpu particle sim init failed, using cpu");
+            backend = SIM_BACKEND_CPU;
+        }
+    }
+    engine->simBackend = backend;
+    fireworks_sim_set_gpu_resident(&engine->sim, backend != SIM_BACKEND_CPU);
+    LOGI("simulation backend: %s", kSimBackendNames[backend]);
+}
+
+// 显示刷新率：Activity.getWindowManager().getDefaultDisplay().getRefreshRate()，失败时按 60 Hz
+static float query_refresh_rate(struct android_app *app) {
+    JNIEnv *env = nullptr;
+    app->activity->vm->AttachCurrentThread(&env, nullptr);
+    float refreshRate = 0.0f;
+    jclass activityClass = env->GetObjectClass(app->activity->clazz);
+    jmethodID getWindowManager = env->GetMethodID(activityClass, "getWindowManager", "()Landroid/view/WindowManager;");
+    jobject windowManager = env->CallObjectMethod(app->activity->clazz, getWindowManager);
+    if (!env->ExceptionCheck() && windowManager != nullptr) {
+        jclass windowManagerClass = env->GetObjectClass(windowManager);
+        jmethodID getDefaultDisplay = env->GetMethodID(windowManagerClass, "getDefaultDisplay", "()Landroid/view/Display;");
+        jobject display = env->CallObjectMethod(windowManager, getDefaultDisplay);
+        if (!env->ExceptionCheck() && display != nullptr) {
+            jclass displayClass = env->GetObjectClass(display);
+            jmethodID getRefreshRate = env->GetMethodID(displayClass, "getRefreshRate", "()F");
+            refreshRate = env->CallFloatMethod(display, getRefreshRate);
+        }
+    }
+    if (env->ExceptionCheck()) {
+        env->ExceptionClear();
+        refreshRate = 0.0f;
+    }
+    app->activity->vm->DetachCurrentThread();
+    return refreshRate > 0.0f ? refreshRate : 60.0f;
+}
+
 // ---------- 初始化显示 ----------
-static int engine_init_display(struct engine *engine) {
+static int64_t monotonic_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// 与窗口无关的 EGL 部分：显示、配置、上下文。early 时窗口还没有，上下文先绑定到空表面
+// （EGL_KHR_surfaceless_context）或 1x1 pbuffer，窗口到达后再换成窗口表面
+static int engine_init_context(struct engine *engine, int early) {
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (!eglInitialize(display, nullptr, nullptr)) {
+        LOGW("egl init failed");
+        return -1;
+    }
+    const char *extensions = eglQueryString(display, EGL_EXTENSIONS);
+    const int surfaceless = extensions != nullptr && strstr(extensions, "EGL_KHR_surfaceless_context") != nullptr;
+    // 没有 surfaceless 时配置还要能创建 pbuffer
     const EGLint attribs[] = {
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_SURFACE_TYPE, EGL_WINDOW_BIT | (early && !surfaceless ? EGL_PBUFFER_BIT : 0),
         EGL_BLUE_SIZE, 8,
         EGL_GREEN_SIZE, 8,
         EGL_RED_SIZE, 8,
         EGL_NONE
     };
-    EGLint w, h, format;
     EGLint numConfigs;
     EGLConfig config = nullptr;
-    EGLSurface surface;
-    EGLContext context;
-    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    if (!eglInitialize(display, nullptr, nullptr)) {
-        LOGW("egl init failed");
-        return 0;
-    }
-
     eglChooseConfig(display, attribs, nullptr, 0, &numConfigs);
+    if (numConfigs <= 0) {
+        LOGW("no EGLConfig");
+        eglTerminate(display);
+        return -1;
+    }
     std::unique_ptr<EGLConfig[]> supportedConfigs(new EGLConfig[numConfigs]);
     eglChooseConfig(display, attribs, supportedConfigs.get(), numConfigs, &numConfigs);
     int i = 0;
@@ -268,31 +639,81 @@ static int engine_init_display(struct engine *engine) {
     if (i == numConfigs) config = supportedConfigs[0];
     if (config == nullptr) {
         LOGW("no EGLConfig");
+        eglTerminate(display);
         return -1;
     }
 
-    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &format);
-    surface = eglCreateWindowSurface(display, config, engine->app->window, nullptr);
     EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
-    context = eglCreateContext(display, EGL_NO_CONTEXT, EGL_NO_CONTEXT, contextAttribs);
-    eglMakeCurrent(display, surface, surface, context);
-
-    eglQuerySurface(display, surface, EGL_WIDTH, &w);
-    eglQuerySurface(display, surface, EGL_HEIGHT, &h);
-
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        LOGW("eglCreateContext failed");
+        eglTerminate(display);
+        return -1;
+    }
     engine->display = display;
+    engine->config = config;
     engine->context = context;
-    engine->surface = surface;
-    engine->width = w;
-    engine->height = h;
-    engine->state.angle = 0;
+    if (!early) {
+        return 0;
+    }
+    if (!surfaceless) {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        engine->bootstrapSurface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+    }
+    if ((!surfaceless && engine->bootstrapSurface == EGL_NO_SURFACE) ||
+        !eglMakeCurrent(display, engine->bootstrapSurface, engine->bootstrapSurface, context)) {
+        LOGW("cannot make the context current without a window, waiting for the window");
+        if (engine->bootstrapSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(display, engine->bootstrapSurface);
+            engine->bootstrapSurface = EGL_NO_SURFACE;
+        }
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        engine->display = EGL_NO_DISPLAY;
+        engine->context = EGL_NO_CONTEXT;
+        return -1;
+    }
+    LOGI("early gl context: %s", surfaceless ? "surfaceless" : "1x1 pbuffer");
+    return 0;
+}
 
-    // 初始化粒子着色器
+// 与窗口大小无关的 GL 资源：着色器程序（含缓存）、圆形纹理、流式缓冲、合成着色器、计时查询和 GL 状态
+static int engine_init_gl_resources(struct engine *engine) {
+    char cacheDir[PATH_MAX];
+    fc_cachedir("fireworks", cacheDir, sizeof(cacheDir));
+    program_cache_init(&engine->programCache, cacheDir);
     if (init_particle_shader(engine) != 0) {
         LOGW("init particle shader failed");
         return -1;
     }
 
+    engine_set_sim_backend(engine, read_sim_backend_property());
+    engine->lodMode = read_lod_property();
+    engine->interactMode = read_interact_property();
+    LOGI("touch interaction: %s", kInteractModeNames[engine->interactMode]);
+    engine->gldata.spriteMode = read_sprite_property();
+    LOGI("particle sprites: %s", kSpriteModeNames[engine->gldata.spriteMode]);
+    memset(&engine->cullStats, 0, sizeof(engine->cullStats));
+
+    if (particle_target_init(&engine->particleTarget) != 0) {
+        LOGW("particle composite shader init failed");
+        return -1;
+    }
+    engine->particleTarget.filter = read_upsample_property();
+    engine->particleTarget.offscreen = read_lowres_measure_property();
+    if (gpu_timer_init(&engine->particleTimer) != 0) {
+        LOGI("GL_EXT_disjoint_timer_query unavailable, particle gpu time not measured");
+    }
+    engine->refreshHz = query_refresh_rate(engine->app);
+    int quality = read_quality_property();
+    engine->qualityAuto = quality == QUALITY_AUTO;
+    quality_governor_init(&engine->governor, engine->refreshHz, engine->qualityAuto ? QUALITY_LEVEL_FULL : quality);
+    fireworks_sim_set_quality(&engine->sim, &engine->governor.current);
+    log_quality(engine, "start");
+    memset(engine->particleGpuMs, 0, sizeof(engine->particleGpuMs));
+    memset(engine->particleGpuSamples, 0, sizeof(engine->particleGpuSamples));
+    engine->timedFrames = 0;
+
     // 设置OpenGL状态
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -300,190 +721,102 @@ static int engine_init_display(struct engine *engine) {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
     LOGI("OpenGL Info: %s", glGetString(GL_VERSION));
+    engine->glReady = 1;
     return 0;
 }
 
-// ---------- 粒子系统函数 ----------
-
-// 添加粒子到数组
-static void add_particle(struct engine *engine, Particle p) {
-    if (engine->particleCount >= MAX_PARTICLES) {
-        // 简单替换最老的粒子
-        int oldestIdx = 0;
-        float oldestLife = engine->particles[0].life;
-        for (int i = 1; i < MAX_PARTICLES; i++) {
-            if (engine->particles[i].life < oldestLife) {
-                oldestLife = engine->particles[i].life;
-                oldestIdx = i;
-            }
+static int engine_init_display(struct engine *engine) {
+    StartupTimes *startup = &engine->startup;
+    if (!startup->windowNs) {
+        startup->windowNs = monotonic_ns();
+    }
+    if (!engine->glReady && engine->display == EGL_NO_DISPLAY) {
+        if (engine_init_context(engine, 0) != 0) {
+            return -1;
+        }
+        if (!startup->contextNs) {
+            startup->contextNs = monotonic_ns();
         }
-        engine->particles[oldestIdx] = p;
-    } else {
-        engine->particles[engine->particleCount++] = p;
     }
-}
 
-// 生成一枚上升火箭
-static void spawn_rocket(struct engine *engine) {
-    Particle r;
-    float aspect = (float)engine->width / engine->height;
-    r.x = ((float)rand() / RAND_MAX) * 2.0f * aspect - aspect; // 屏幕宽度范围
-    r.y = -1.0f; // 底部
-    r.vx = ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
-    r.vy = ((float)rand() / RAND_MAX) * 0.8f + 0.8f; // 向上速度
-    r.ax = 0.0f;
-    r.ay = 0.2f; // 减速（模拟重力）
-    r.r = ((float)rand() / RAND_MAX) * 0.5f + 0.5f;
-    r.g = ((float)rand() / RAND_MAX) * 0.3f + 0.7f;
-    r.b = ((float)rand() / RAND_MAX) * 0.2f + 0.8f;
-    r.a = 1.0f;
-    r.size = 8.0f;
-    r.life = ROCKET_LIFETIME;
-    r.maxLife = ROCKET_LIFETIME;
-    r.type = PARTICLE_ROCKET;
-    add_particle(engine, r);
-}
-
-// 火箭爆炸，生成爆炸粒子
-static void explode(struct engine *engine, float x, float y, float r, float g, float b) {
-    for (int i = 0; i < EXPLOSION_COUNT; i++) {
-        Particle p;
-        p.x = x;
-        p.y = y;
-        float angle = ((float)rand() / RAND_MAX) * 2.0f * M_PI;
-        float speed = ((float)rand() / RAND_MAX) * 1.5f + 0.5f;
-        p.vx = cosf(angle) * speed;
-        p.vy = sinf(angle) * speed;
-        p.ax = 0.0f;
-        p.ay = 0.5f; // 重力
-        p.r = r;
-        p.g = g;
-        p.b = b;
-        p.a = 1.0f;
-        p.size = ((float)rand() / RAND_MAX) * 6.0f + 4.0f;
-        p.life = ((float)rand() / RAND_MAX) * 1.5f + 0.8f;
-        p.maxLife = p.life;
-        p.type = PARTICLE_EXPLOSION;
-        add_particle(engine, p);
-    }
-}
-
-// 生成尾迹粒子（火箭拖尾）
-static void spawn_trail(struct engine *engine, float x, float y, float r, float g, float b) {
-    for (int i = 0; i < TRAIL_COUNT; i++) {
-        Particle t;
-        t.x = x + ((float)rand() / RAND_MAX - 0.5f) * 0.05f;
-        t.y = y + ((float)rand() / RAND_MAX - 0.5f) * 0.05f;
-        t.vx = ((float)rand() / RAND_MAX - 0.5f) * 0.1f;
-        t.vy = ((float)rand() / RAND_MAX) * 0.2f - 0.1f;
-        t.ax = 0.0f;
-        t.ay = 0.1f;
-        t.r = r;
-        t.g = g;
-        t.b = b;
-        t.a = 0.7f;
-        t.size = ((float)rand() / RAND_MAX) * 4.0f + 2.0f;
-        t.life = 0.4f;
-        t.maxLife = 0.4f;
-        t.type = PARTICLE_TRAIL;
-        add_particle(engine, t);
-    }
-}
-
-// ---------- 生成文字“新年快乐”的粒子（爆炸效果）----------
-static void spawn_text_particles(struct engine *engine) {
-    // 定义文字轮廓的点阵（归一化坐标 0-1）
-    // 简化：四个字“新年快乐”用点阵粗略表示
-    // 每个字大约 0.2x0.3，四个字横向排列
-    const int pointsPerChar = 300;
-    float aspect = (float)engine->width / engine->height;
-    for (int i = 0; i < TEXT_PARTICLE_COUNT; i++) {
-        Particle p;
-        // 随机选择四个字中的一个
-        int charIdx = rand() % 4;
-        float baseX = -0.6f + charIdx * 0.4f; // 大致位置
-        float baseY = 0.0f;
-
-        // 在字的区域内随机偏移
-        float cx = ((float)rand() / RAND_MAX) * 0.25f - 0.125f;
-        float cy = ((float)rand() / RAND_MAX) * 0.35f - 0.175f;
-
-        // 为不同字添加简单轮廓形状
-        if (charIdx == 0) { // 新
-            cx = sinf(cx * 10) * 0.1f; // 简单装饰
-        } else if (charIdx == 1) { // 年
-            cy = cosf(cy * 8) * 0.08f;
-        } else if (charIdx == 2) { // 快
-            cx = fabsf(cx) - 0.05f;
-        } else { // 乐
-            cy = fabsf(cy) - 0.05f;
-        }
-
-        p.x = (baseX + cx) * aspect; // 考虑屏幕比例
-        p.y = baseY + cy;
-
-        // 爆炸速度向外
-        float angle = atan2f(p.y - baseY, p.x - baseX);
-        float speed = ((float)rand() / RAND_MAX) * 1.0f + 0.3f;
-        p.vx = cosf(angle) * speed * 0.5f;
-        p.vy = sinf(angle) * speed * 0.5f;
-        p.ax = 0.0f;
-        p.ay = 0.2f; // 轻微重力
-
-        // 多彩颜色
-        p.r = ((float)rand() / RAND_MAX) * 0.8f + 0.2f;
-        p.g = ((float)rand() / RAND_MAX) * 0.8f + 0.2f;
-        p.b = ((float)rand() / RAND_MAX) * 0.8f + 0.2f;
-        p.a = 1.0f;
-        p.size = ((float)rand() / RAND_MAX) * 12.0f + 6.0f;
-        p.life = ((float)rand() / RAND_MAX) * 2.0f + 1.0f;
-        p.maxLife = p.life;
-        p.type = PARTICLE_TEXT;
-        add_particle(engine, p);
-    }
-    LOGI("文字粒子已生成！");
-}
-
-// ---------- 更新粒子 ----------
-static void update_particles(struct engine *engine, float deltaTime) {
-    for (int i = engine->particleCount - 1; i >= 0; i--) {
-        Particle *p = &engine->particles[i];
-        p->life -= deltaTime;
-        if (p->life <= 0.0f) {
-            // 移除粒子
-            engine->particles[i] = engine->particles[--engine->particleCount];
-            continue;
-        }
+    // 窗口表面替换启动时的空表面/pbuffer
+    EGLSurface surface = eglCreateWindowSurface(engine->display, engine->config, engine->app->window, nullptr);
+    if (surface == EGL_NO_SURFACE || !eglMakeCurrent(engine->display, surface, surface, engine->context)) {
+        LOGW("window surface init failed");
+        return -1;
+    }
+    if (engine->bootstrapSurface != EGL_NO_SURFACE) {
+        eglDestroySurface(engine->display, engine->bootstrapSurface);
+        engine->bootstrapSurface = EGL_NO_SURFACE;
+    }
+    if (!startup->boundNs) {
+        startup->boundNs = monotonic_ns();
+    }
+    EGLint w, h;
+    eglQuerySurface(engine->display, surface, EGL_WIDTH, &w);
+    eglQuerySurface(engine->display, surface, EGL_HEIGHT, &h);
+    engine->surface = surface;
+    engine->width = w;
+    engine->height = h;
+    engine->sim.aspect = (float) w / h;
+    engine->state.angle = 0;
 
-        // 物理更新
-        p->vx += p->ax * deltaTime;
-        p->vy += p->ay * deltaTime;
-        p->x += p->vx * deltaTime;
-        p->y += p->vy * deltaTime;
-
-        // 火箭特殊处理：到达顶部或生命周期结束时爆炸
-        if (p->type == PARTICLE_ROCKET) {
-            // 产生尾迹
-            spawn_trail(engine, p->x, p->y, p->r, p->g, p->b);
-            // 如果超出顶部或生命快结束，爆炸
-            if (p->y > 1.2f || p->life < 0.2f) {
-                explode(engine, p->x, p->y, p->r, p->g, p->b);
-                p->life = 0.0f; // 标记删除
-            }
+    // 启动时没能提前准备（或窗口销毁后重建）：与原来一样在窗口表面上编译
+    if (!engine->glReady) {
+        if (engine_init_gl_resources(engine) != 0) {
+            return -1;
         }
-
-        // 根据生命调整透明度
-        p->a = p->life / p->maxLife;
-        if (p->type == PARTICLE_TRAIL) {
-            p->a *= 0.8f;
-            p->size *= 0.95f;
+        if (!startup->resourcesNs) {
+            startup->resourcesNs = monotonic_ns();
         }
     }
+    engine_set_particle_resolution(engine, read_lowres_property());
+    return 0;
+}
+
+// ---------- 文字点云资源 ----------
+// 由 tools/glyph_cloud_tool 离线生成，APK 中不压缩存放（build.gradle noCompress 'gpc'），
+// AAsset_getBuffer 因此直接返回 APK 的内存映射，不读取也不拷贝。
+#define TEXT_CLOUD_ASSET "text/new_year.gpc"
+
+static void load_text_cloud(struct engine *engine) {
+    AAsset *asset = AAssetManager_open(engine->app->activity->assetManager, TEXT_CLOUD_ASSET, AASSET_MODE_BUFFER);
+    if (asset == nullptr) {
+        LOGI("%s not found, using procedural text", TEXT_CLOUD_ASSET);
+        return;
+    }
+    const void *data = AAsset_getBuffer(asset);
+    GlyphCloud cloud;
+    if (data == nullptr || glyph_cloud_view(data, (size_t) AAsset_getLength(asset), &cloud) != 0) {
+        LOGW("%s is not a valid glyph cloud, using procedural text", TEXT_CLOUD_ASSET);
+        AAsset_close(asset);
+        return;
+    }
+    engine->textAsset = asset;
+    fireworks_sim_set_text_cloud(&engine->sim, &cloud);
+    LOGI("text cloud: %d points", cloud.count);
 }
 
 // ---------- 渲染所有粒子 ----------
-static void render_particles(struct engine *engine) {
+// alpha：距上一个模拟步的时间占步长的比例，用于位置插值
+// 剔除屏幕外/过淡/过小的粒子，只画剩下的（GPU 常驻粒子不经过这里）
+static void engine_cull_params(const struct engine *engine, ParticleCullParams *cull) {
+    float aspect = (float) engine->width / engine->height;
+    cull->left = -aspect;
+    cull->right = aspect;
+    cull->bottom = -1.0f;
+    cull->top = 1.0f;
+    cull->pixelsPerUnit = engine->height * 0.5f;
+    cull->minSize = LOD_MIN_SIZE;
+    cull->minAlpha = LOD_MIN_ALPHA;
+    cull->mergeTile = engine->lodMode == LOD_MERGE ? LOD_MERGE_TILE : 0.0f;
+}
+
+// frame 非空时画模拟线程打包好的顶点（流水线），否则在这里把粒子池打包进流式缓冲（串行）
+static void render_particles(struct engine *engine, float alpha, const SimFrame *frame) {
     glUseProgram(engine->gldata.program);
+    // 降分辨率时点大小按比例缩小，屏幕上的大小不变
+    const float sizeScale = 1.0f / (float) kParticleDivisors[engine->particleDivisor];
 
     // 设置投影矩阵（保持宽高比）
     float proj[16];
@@ -496,97 +829,345 @@ static void render_particles(struct engine *engine) {
     glBindTexture(GL_TEXTURE_2D, engine->gldata.texture);
     glUniform1i(engine->gldata.uTexture, 0);
 
-    // 准备顶点数据
-    GLfloat *vertices = (GLfloat*)malloc(engine->particleCount * 7 * sizeof(GLfloat)); // 每粒子: x,y,r,g,b,a,size
-    int idx = 0;
-    for (int i = 0; i < engine->particleCount; i++) {
-        Particle *p = &engine->particles[i];
-        vertices[idx++] = p->x;
-        vertices[idx++] = p->y;
-        vertices[idx++] = p->r;
-        vertices[idx++] = p->g;
-        vertices[idx++] = p->b;
-        vertices[idx++] = p->a;
-        vertices[idx++] = p->size;
-    }
+    // 顶点数据直接写进流式缓冲的本帧段（不再逐帧 malloc / 客户端数组）
+    const int count = frame != nullptr ? frame->vertexCount : engine->sim.particles.count;
+    if (count > 0) {
+        StreamBuffer *stream = &engine->gldata.particleStream;
+        const GLsizeiptr stride = sizeof(ParticleVertex); // 每粒子 12 字节: half x,y / RGBA8 / 定点 size
+        GLintptr offset = 0;
+        ParticleVertex *vertices;
+        {
+            PROFILE_SCOPE(engine->sim.profiler, PROFILE_UPLOAD);
+            vertices = (ParticleVertex *) stream_buffer_map(stream, count * stride, &offset);
+        }
+        if (vertices != nullptr) {
+            glUniform1f(engine->gldata.uSizeScale, sizeScale / PARTICLE_SIZE_SCALE);
+            ParticleCullParams cull;
+            engine_cull_params(engine, &cull);
+            int drawn = count;
+            if (frame != nullptr) {
+                PROFILE_SCOPE(engine->sim.profiler, PROFILE_UPLOAD);
+                memcpy(vertices, frame->vertices, count * stride);
+            } else {
+                int64_t packStart = monotonic_ns();
+                drawn = fireworks_sim_pack(&engine->sim, alpha, engine->lodMode != LOD_OFF ? &cull : nullptr,
+                                           vertices, &engine->cullStats);
+                int64_t packNs = monotonic_ns() - packStart;
+                engine->frameStats.produceNs += packNs;
+                engine->frameStats.waitNs += packNs;
+            }
+            {
+                PROFILE_SCOPE(engine->sim.profiler, PROFILE_UPLOAD);
+                stream_buffer_unmap(stream);
+            }
 
-    glVertexAttribPointer(engine->gldata.aPosition, 2, GL_FLOAT, GL_FALSE, 7 * sizeof(GLfloat), vertices);
-    glVertexAttribPointer(engine->gldata.aColor, 4, GL_FLOAT, GL_FALSE, 7 * sizeof(GLfloat), vertices + 2);
-    glVertexAttribPointer(engine->gldata.aSize, 1, GL_FLOAT, GL_FALSE, 7 * sizeof(GLfloat), vertices + 6);
+            PROFILE_SCOPE(engine->sim.profiler, PROFILE_DRAW);
+            if (engine->gldata.spriteMode == SPRITE_QUADS) {
+                ParticleQuadParams quad;
+                quad.matrix = proj;
+                quad.textureUnit = 0;
+                quad.sizeScale = sizeScale / PARTICLE_SIZE_SCALE;
+                quad.pixelsPerUnit = cull.pixelsPerUnit * sizeScale;
+                quad.viewportWidth = engine->width * sizeScale;
+                quad.viewportHeight = engine->height * sizeScale;
+                quad.stretch = SPRITE_STRETCH;
+                particle_quads_draw(&engine->gldata.quads, &quad, offset, drawn);
+                glUseProgram(engine->gldata.program);
+            } else {
+                glBindVertexArray(engine->gldata.particleVao);
+                glDrawArrays(GL_POINTS, (GLint) (offset / stride), drawn);
+                glBindVertexArray(0);
+            }
+            stream_buffer_advance(stream);
+        }
+    }
 
-    glEnableVertexAttribArray(engine->gldata.aPosition);
-    glEnableVertexAttribArray(engine->gldata.aColor);
-    glEnableVertexAttribArray(engine->gldata.aSize);
+    // GPU 常驻粒子直接从状态缓冲绘制，使用同一个着色器和投影
+    if (engine->simBackend != SIM_BACKEND_CPU) {
+        PROFILE_SCOPE(engine->sim.profiler, PROFILE_DRAW);
+        glUniform1f(engine->gldata.uSizeScale, sizeScale);
+        gpu_particle_sim_draw(&engine->gpuSim);
+    }
+}
 
-    glDrawArrays(GL_POINTS, 0, engine->particleCount);
+// 最近若干帧各阶段耗时的分位数（微秒）
+static void log_frame_profile(struct engine *engine) {
+#if FRAME_PROFILER_ENABLED
+    FrameProfilerReport report;
+    if (frame_profiler_report(&engine->profiler, &report) == 0) {
+        return;
+    }
+    LOGI("frame profile, last %d frames (us): phase mean / p50 / p95 / p99", report.frames);
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        const FrameProfilerStats *stats = &report.phases[phase];
+        LOGI("  %-6s %8.1f %8.1f %8.1f %8.1f", frame_profiler_phase_name(phase), stats->mean, stats->p50,
+             stats->p95, stats->p99);
+    }
+    LOGI("  %-6s %8.1f %8.1f %8.1f %8.1f", "total", report.total.mean, report.total.p50, report.total.p95,
+         report.total.p99);
+#else
+    (void) engine;
+#endif
+}
 
-    glDisableVertexAttribArray(engine->gldata.aPosition);
-    glDisableVertexAttribArray(engine->gldata.aColor);
-    glDisableVertexAttribArray(engine->gldata.aSize);
+// ---------- 绘制帧 ----------
+// 推进一个固定步长：场景模拟，GPU 后端再上传本步发射的粒子并推进。返回事件位
+static int simulate_step(struct engine *engine, float deltaTime) {
+    int events = fireworks_sim_step(&engine->sim, deltaTime);
+    if (engine->simBackend != SIM_BACKEND_CPU) {
+        PROFILE_SCOPE_AT(engine->sim.profiler, engine->sim.profileFrame, PROFILE_UPDATE);
+        if (events & FIREWORKS_EVENT_TEXT) {
+            gpu_particle_sim_clear(&engine->gpuSim); // 只保留文字粒子
+        }
+        gpu_particle_sim_emit(&engine->gpuSim, &engine->sim.gpuSpawns.staged);
+        particle_spawn_reset(&engine->sim.gpuSpawns);
+        gpu_particle_sim_step(&engine->gpuSim, deltaTime);
+    }
+    return events;
+}
 
-    free(vertices);
+// 按固定步长消耗 pendingDt（流水线模式下在模拟线程上执行），返回各步事件位之和
+static int engine_advance(struct engine *engine) {
+    if (engine->clockRestart) {
+        engine->simAccumulator = SIM_DT;
+    } else {
+        engine->simAccumulator += engine->pendingDt;
+    }
+    int events = 0;
+    int steps = 0;
+    while (engine->simAccumulator >= SIM_DT && steps < SIM_MAX_STEPS) {
+        events |= simulate_step(engine, SIM_DT);
+        engine->simAccumulator -= SIM_DT;
+        steps++;
+    }
+    // 卡顿后不追赶超出上限的部分，避免一帧里堆积大量模拟工作
+    if (engine->simAccumulator >= SIM_DT) {
+        int skipped = (int) (engine->simAccumulator / SIM_DT);
+        engine->skippedSteps += skipped;
+        engine->simAccumulator -= skipped * SIM_DT;
+    }
+    return events;
 }
 
-// ---------- 绘制帧 ----------
-static void engine_draw_frame(struct engine *engine) {
-    if (engine->display == nullptr) return;
+// 模拟线程产出一帧：推进后按最近两步之间的插值打包，分阶段耗时计入 submit 时的帧
+static void engine_produce_frame(void *ctx, SimFrame *frame) {
+    auto *engine = (struct engine *) ctx;
+    engine->sim.profileFrame = frame->frameNumber;
+    frame->events = engine_advance(engine);
+    frame->vertexCount = 0;
+    int count = engine->sim.particles.count;
+    if (count > 0 && sim_frame_reserve(frame, count) == 0) {
+        ParticleCullParams cull;
+        engine_cull_params(engine, &cull);
+        frame->vertexCount = fireworks_sim_pack(&engine->sim, engine->simAccumulator / SIM_DT,
+                                                engine->lodMode != LOD_OFF ? &cull : nullptr, frame->vertices,
+                                                &engine->cullStats);
+    }
+    engine->sim.profileFrame = FRAME_PROFILER_CURRENT;
+}
 
-    // 计算时间差
-    static struct timeval lastTime = {0, 0};
-    struct timeval now;
-    gettimeofday(&now, NULL);
-    float deltaTime = 0.016f; // 默认约60fps
-    if (lastTime.tv_sec != 0) {
-        deltaTime = (now.tv_sec - lastTime.tv_sec) + (now.tv_usec - lastTime.tv_usec) * 0.000001f;
-        if (deltaTime > 0.1f) deltaTime = 0.016f; // 防止跳帧
+// 场景事件（渲染线程上处理）
+static void engine_handle_sim_events(struct engine *engine, int events) {
+    if (events & FIREWORKS_EVENT_TEXT) {
+        LOGI("文字粒子已生成！");
+    }
+    if (events & FIREWORKS_EVENT_FINISHED) {
+        ANativeActivity_finish(engine->app->activity);
+        LOGI("2秒已过，退出程序");
     }
-    lastTime = now;
+}
+
+static double startup_ms(const StartupTimes *startup, int64_t ns) {
+    return ns != 0 ? (double) (ns - startup->startNs) * 1e-6 : -1.0;
+}
+
+// 各时间都从进入 android_main 算起
+static void log_startup(const struct engine *engine) {
+    const StartupTimes *startup = &engine->startup;
+    LOGI("time to first frame: %.1f ms (%s context: context %.1f ms, gl resources %.1f ms, "
+         "window %.1f ms, surface bound %.1f ms)", startup_ms(startup, startup->firstFrameNs),
+         startup->early ? "early" : "on window", startup_ms(startup, startup->contextNs),
+         startup_ms(startup, startup->resourcesNs), startup_ms(startup, startup->windowNs),
+         startup_ms(startup, startup->boundNs));
+}
 
-    // 总运行时间
-    engine->totalTime += deltaTime;
+static void log_pipeline_stats(const struct engine *engine) {
+    const SimPipelineStats *stats = &engine->frameStats;
+    if (stats->frames == 0) {
+        return;
+    }
+    double frames = (double) stats->frames;
+    double seconds = (double) (stats->lastPresentNs - stats->firstPresentNs) * 1e-9;
+    LOGI("frame schedule %s: %lld frames, %.1f fps, latency %.2f ms mean / %.2f ms max, "
+         "simulate+pack %.2f ms, render thread waited %.2f ms per frame",
+         kScheduleNames[engine->pipeline != nullptr ? SCHEDULE_PIPELINED : SCHEDULE_SERIAL],
+         (long long) stats->frames, seconds > 0.0 ? (frames - 1.0) / seconds : 0.0,
+         stats->latencyNs * 1e-6 / frames, stats->maxLatencyNs * 1e-6,
+         stats->produceNs * 1e-6 / frames, stats->waitNs * 1e-6 / frames);
+}
 
-    // 退出逻辑：文字出现后2秒退出
-    if (engine->textSpawned) {
-        engine->exitTimer -= deltaTime;
-        if (engine->exitTimer <= 0.0f && !engine->shouldExit) {
-            engine->shouldExit = 1;
-            ANativeActivity_finish(engine->app->activity);
-            LOGI("2秒已过，退出程序");
+// 触摸点转成本帧的吸引/排斥点，松手的排斥按经过的时间减弱。
+// 只作用于 CPU 粒子池（GPU 后端时只有火箭）
+static void engine_update_interaction(struct engine *engine, float frameDt) {
+    FireworksInteraction interaction = {};
+    if (engine->interactMode != INTERACT_OFF) {
+        for (TouchPoint &touch : engine->touches) {
+            if (!touch.held && touch.repulse <= 0.0f) {
+                continue;
+            }
+            ParticleAttractor &attractor = interaction.attractors[interaction.attractorCount++];
+            attractor.x = touch.x;
+            attractor.y = touch.y;
+            attractor.radius = TOUCH_RADIUS;
+            attractor.strength = touch.held ? TOUCH_ATTRACT : -TOUCH_REPULSE * touch.repulse / TOUCH_REPULSE_TIME;
+            if (!touch.held) {
+                touch.repulse -= frameDt;
+            }
         }
     }
+    if (engine->interactMode == INTERACT_FULL && engine->height > 0) {
+        interaction.collisionRadius = COLLISION_RADIUS_PX * 2.0f / (float) engine->height;
+        interaction.collisionStiffness = COLLISION_STIFFNESS;
+        interaction.bounce = 1;
+        interaction.restitution = BOUNCE_RESTITUTION;
+    }
+    fireworks_sim_set_interaction(&engine->sim, &interaction);
+}
 
-    // 10秒触发文字爆炸
-    if (!engine->textSpawned && engine->totalTime >= 10.0f) {
-        // 清空大部分粒子，保留文字粒子
-        engine->particleCount = 0;
-        spawn_text_particles(engine);
-        engine->textSpawned = 1;
-        engine->exitTimer = 2.0f; // 再过2秒退出
+static void engine_draw_frame(struct engine *engine) {
+    if (engine->surface == EGL_NO_SURFACE) return;
+
+    // 单调时钟累计真实经过的时间，按固定步长消耗
+    int64_t now = monotonic_ns();
+    const int restart = engine->lastFrameNs == 0;
+    const float dt = restart ? SIM_DT : (float) ((now - engine->lastFrameNs) * 1e-9);
+
+    // 流水线的唯一交接点：等模拟线程做完手上的帧，到 submit 之前可以修改模拟状态。
+    // clockRestart/pendingDt 由 engine_advance 在模拟线程上读取，只能在这之后写入
+    const bool pipelined = engine->pipeline != nullptr && engine->simBackend == SIM_BACKEND_CPU;
+    if (pipelined) {
+        engine->frameStats.waitNs += sim_pipeline_acquire(engine->pipeline);
+    }
+    engine->clockRestart = restart;
+    engine->pendingDt = dt;
+    engine->lastFrameNs = now;
+
+    // 本帧到达的加速度计样本低通一次，之后各步使用同一个全局加速度
+    motion_field_update(&engine->motion);
+    engine->sim.fieldX = engine->motion.ax;
+    engine->sim.fieldY = engine->motion.ay;
+    gpu_particle_sim_set_field(&engine->gpuSim, engine->motion.ax, engine->motion.ay);
+
+    engine_update_interaction(engine, dt);
+    if (engine->qualityAuto) {
+        // 画质调节器上一帧给出的参数，从这一帧的发射开始使用
+        fireworks_sim_set_quality(&engine->sim, &engine->governor.current);
     }
 
-    // 生成新的火箭（如果不处于文字阶段）
-    if (!engine->textSpawned) {
-        engine->fireworkTimer -= deltaTime;
-        while (engine->fireworkTimer <= 0.0f) {
-            spawn_rocket(engine);
-            engine->fireworkTimer += FIREWORK_COOLDOWN;
+    // 流水线：模拟线程开始推进下一帧，这里画它上一次做完的帧；串行：推进后打包本帧
+    const SimFrame *frame = nullptr;
+    int64_t inputNs = now;
+    bool fresh = true;
+    if (pipelined) {
+        frame = sim_pipeline_submit(engine->pipeline, now, frame_profiler_frame(engine->sim.profiler));
+        inputNs = frame->inputNs;
+        fresh = inputNs != engine->lastInputNs;
+        if (fresh) {
+            engine->frameStats.produceNs += frame->produceNs;
+            engine_handle_sim_events(engine, frame->events);
         }
+    } else {
+        int64_t start = monotonic_ns();
+        int events = engine_advance(engine);
+        int64_t advanceNs = monotonic_ns() - start;
+        engine->frameStats.produceNs += advanceNs;
+        engine->frameStats.waitNs += advanceNs;
+        engine_handle_sim_events(engine, events);
     }
 
-    // 更新粒子
-    update_particles(engine, deltaTime);
+    // 渲染（CPU 粒子在最近两步之间插值；GPU 常驻粒子直接画最新一步）
+    // 粒子绘制连同降分辨率合成一起计时，结果几帧后取回
+    {
+        PROFILE_SCOPE(engine->sim.profiler, PROFILE_DRAW);
+        glClear(GL_COLOR_BUFFER_BIT);
+        gpu_timer_begin(&engine->particleTimer);
+        particle_target_begin(&engine->particleTarget);
+    }
+    render_particles(engine, frame != nullptr ? 0.0f : engine->simAccumulator / SIM_DT, frame);
+    {
+        PROFILE_SCOPE(engine->sim.profiler, PROFILE_DRAW);
+        particle_target_end(&engine->particleTarget);
+        gpu_timer_end(&engine->particleTimer);
+    }
+    float cpuMs = (float) ((monotonic_ns() - now) * 1e-6);
 
-    // 渲染
-    glClear(GL_COLOR_BUFFER_BIT);
-    render_particles(engine);
+    {
+        PROFILE_SCOPE(engine->sim.profiler, PROFILE_SWAP);
+        eglSwapBuffers(engine->display, engine->surface);
+    }
+    PROFILE_END_FRAME(engine->sim.profiler);
+    if (engine->startup.firstFrameNs == 0) {
+        engine->startup.firstFrameNs = monotonic_ns();
+        log_startup(engine);
+    }
+    if (fresh) {
+        sim_pipeline_stats_present(&engine->frameStats, inputNs, monotonic_ns());
+        engine->lastInputNs = inputNs;
+    }
 
-    eglSwapBuffers(engine->display, engine->surface);
+    GpuTimer *timer = &engine->particleTimer;
+    int samples = gpu_timer_poll(timer);
+    if (engine->qualityAuto) {
+        // 画质调节，下一步的发射开始使用新参数
+        if (quality_governor_update(&engine->governor, cpuMs, samples > 0 ? (float) timer->lastMs : -1.0f) != 0) {
+            log_quality(engine, "changed");
+        }
+    }
+    if (samples > 0) {
+        // 新取到的结果里前 timerWarmup 个属于切换前的设置，只把最近一次的结果计入当前分辨率
+        if (engine->timerWarmup > 0) {
+            engine->timerWarmup -= samples;
+        } else if (engine->particleTarget.framebuffer != 0) {
+            engine->particleGpuMs[engine->particleDivisor] += timer->lastMs;
+            engine->particleGpuSamples[engine->particleDivisor]++;
+        }
+    }
+    if (++engine->timedFrames % GPU_TIME_LOG_FRAMES == 0) {
+        log_particle_gpu_time(engine);
+        log_quality(engine, "holding");
+        log_frame_profile(engine);
+        log_pipeline_stats(engine);
+    }
 }
 
 // ---------- 终止显示 ----------
 static void engine_term_display(struct engine *engine) {
+    if (engine->pipeline != nullptr) {
+        sim_pipeline_reset(engine->pipeline);  // 恢复绘制时时钟重新开始，做好的帧不再有效
+    }
     if (engine->display != EGL_NO_DISPLAY) {
+        // GPU 粒子状态随上下文一起销毁，重建窗口时按属性重新选择后端
+        gpu_particle_sim_free(&engine->gpuSim);
+        engine->simBackend = SIM_BACKEND_CPU;
+        log_cull_stats(engine);
+        log_particle_gpu_time(engine);
+        log_quality(engine, "final");
+        log_frame_profile(engine);
+        log_pipeline_stats(engine);
+        program_cache_log(&engine->programCache);
+        gpu_timer_free(&engine->particleTimer);
+        particle_target_free(&engine->particleTarget);
+        StreamBuffer *stream = &engine->gldata.particleStream;
+        LOGI("particle stream: %llu bytes uploaded, %u stalls, %u orphans",
+             (unsigned long long) stream->bytesUploaded, stream->stalls, stream->orphans);
+        particle_quads_free(&engine->gldata.quads);
+        stream_buffer_free(stream);
+        glDeleteVertexArrays(1, &engine->gldata.particleVao);
+        engine->gldata.particleVao = 0;
         eglMakeCurrent(engine->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (engine->bootstrapSurface != EGL_NO_SURFACE) {
+            eglDestroySurface(engine->display, engine->bootstrapSurface);
+        }
         if (engine->context != EGL_NO_CONTEXT) {
             eglDestroyContext(engine->display, engine->context);
         }
@@ -596,15 +1177,138 @@ static void engine_term_display(struct engine *engine) {
         eglTerminate(engine->display);
     }
     engine->animating = 0;
+    engine->lastFrameNs = 0;
     engine->display = EGL_NO_DISPLAY;
     engine->context = EGL_NO_CONTEXT;
     engine->surface = EGL_NO_SURFACE;
+    engine->bootstrapSurface = EGL_NO_SURFACE;
+    engine->glReady = 0;
+}
+
+// 启动时窗口还没到：先建上下文、编译程序、上传纹理，与系统创建窗口同时进行
+static void engine_bootstrap_gl(struct engine *engine) {
+    if (engine_init_context(engine, 1) != 0) {
+        return;
+    }
+    engine->startup.contextNs = monotonic_ns();
+    if (engine_init_gl_resources(engine) != 0) {
+        engine_term_display(engine);
+        return;
+    }
+    engine->startup.resourcesNs = monotonic_ns();
 }
 
 // ---------- 输入处理 ----------
+static TouchPoint *find_touch(struct engine *engine, int32_t id) {
+    for (TouchPoint &touch : engine->touches) {
+        if (touch.held && touch.id == id) {
+            return &touch;
+        }
+    }
+    return nullptr;
+}
+
+static void touch_to_world(const struct engine *engine, const AInputEvent *event, size_t index, TouchPoint *touch) {
+    float aspect = (float) engine->width / engine->height;
+    touch->x = (AMotionEvent_getX(event, index) / engine->width * 2.0f - 1.0f) * aspect;
+    touch->y = 1.0f - AMotionEvent_getY(event, index) / engine->height * 2.0f;
+}
+
+// 按指针 id 跟踪按下的手指；槽位用完时新手指忽略，正在排斥的槽位可被新手指占用
+static void engine_track_touches(struct engine *engine, const AInputEvent *event, int32_t action) {
+    if (engine->width <= 0 || engine->height <= 0) {
+        return;
+    }
+    size_t actionIndex = (AMotionEvent_getAction(event) & AMOTION_EVENT_ACTION_POINTER_INDEX_MASK) >>
+                         AMOTION_EVENT_ACTION_POINTER_INDEX_SHIFT;
+    switch (action) {
+        case AMOTION_EVENT_ACTION_DOWN:
+        case AMOTION_EVENT_ACTION_POINTER_DOWN: {
+            int32_t id = AMotionEvent_getPointerId(event, actionIndex);
+            for (TouchPoint &touch : engine->touches) {
+                if (!touch.held) {
+                    touch.id = id;
+                    touch.held = 1;
+                    touch.repulse = 0.0f;
+                    touch_to_world(engine, event, actionIndex, &touch);
+                    break;
+                }
+            }
+            break;
+        }
+        case AMOTION_EVENT_ACTION_MOVE:
+            for (size_t i = 0; i < AMotionEvent_getPointerCount(event); i++) {
+                TouchPoint *touch = find_touch(engine, AMotionEvent_getPointerId(event, i));
+                if (touch != nullptr) {
+                    touch_to_world(engine, event, i, touch);
+                }
+            }
+            break;
+        case AMOTION_EVENT_ACTION_UP:
+        case AMOTION_EVENT_ACTION_POINTER_UP: {
+            TouchPoint *touch = find_touch(engine, AMotionEvent_getPointerId(event, actionIndex));
+            if (touch != nullptr) {
+                touch_to_world(engine, event, actionIndex, touch);
+                touch->held = 0;
+                touch->repulse = TOUCH_REPULSE_TIME;
+            }
+            break;
+        }
+        case AMOTION_EVENT_ACTION_CANCEL:
+            memset(engine->touches, 0, sizeof(engine->touches));
+            break;
+        default:
+            break;
+    }
+}
+
+// 多指手势：按同时按下的最多手指数在最后一根手指抬起时决定，每次只触发一个切换。
+// 序列一旦达到 GESTURE_MIN_POINTERS，手指都不再作为吸引点（已按下的直接放掉，不排斥）
+static void engine_track_gesture(struct engine *engine, const AInputEvent *event, int32_t action) {
+    int pointers = (int) AMotionEvent_getPointerCount(event);
+    switch (action) {
+        case AMOTION_EVENT_ACTION_DOWN:
+            engine->gesturePointers = 1;
+            break;
+        case AMOTION_EVENT_ACTION_POINTER_DOWN:
+            if (pointers > engine->gesturePointers) {
+                if (pointers >= GESTURE_MIN_POINTERS && engine->gesturePointers < GESTURE_MIN_POINTERS) {
+                    for (TouchPoint &touch : engine->touches) {
+                        if (touch.held) {
+                            touch.held = 0;
+                            touch.repulse = 0.0f;
+                        }
+                    }
+                }
+                engine->gesturePointers = pointers;
+            }
+            break;
+        case AMOTION_EVENT_ACTION_UP:
+            // 三指点击：切换模拟后端；四指点击：切换粒子渲染分辨率
+            if (engine->gesturePointers == 3 && engine->display != EGL_NO_DISPLAY) {
+                engine_set_sim_backend(engine, (engine->simBackend + 1) % SIM_BACKEND_COUNT);
+            } else if (engine->gesturePointers == 4 && engine->surface != EGL_NO_SURFACE) {
+                engine_set_particle_resolution(engine, (engine->particleDivisor + 1) % PARTICLE_DIVISOR_COUNT);
+            }
+            engine->gesturePointers = 0;
+            break;
+        case AMOTION_EVENT_ACTION_CANCEL:
+            engine->gesturePointers = 0;
+            break;
+        default:
+            break;
+    }
+}
+
 static int32_t engine_handle_input(struct android_app *app, AInputEvent *event) {
     auto *engine = (struct engine *) app->userData;
     if (AInputEvent_getType(event) == AINPUT_EVENT_TYPE_MOTION) {
+        int32_t action = AMotionEvent_getAction(event) & AMOTION_EVENT_ACTION_MASK;
+        int gesture = engine->gesturePointers >= GESTURE_MIN_POINTERS;
+        engine_track_gesture(engine, event, action);
+        if (!gesture && engine->gesturePointers < GESTURE_MIN_POINTERS) {
+            engine_track_touches(engine, event, action);
+        }
         engine->animating = 1;
         engine->state.x = AMotionEvent_getX(event, 0);
         engine->state.y = AMotionEvent_getY(event, 0);
@@ -613,14 +1317,120 @@ static int32_t engine_handle_input(struct android_app *app, AInputEvent *event)
     return 0;
 }
 
+// ---------- 模拟快照 ----------
+static int snapshot_path(struct engine *engine, char *path, size_t pathMax) {
+    if (fc_datadir("fireworks", path, pathMax) != 0) {
+        return -1;
+    }
+    strncat(path, SNAPSHOT_FILE_NAME, pathMax - strlen(path) - 1);
+    return 0;
+}
+
+// 保存 saved_state 和模拟快照到 savedState（glue 负责释放）
+static void engine_save_state(struct engine *engine) {
+    if (engine->pipeline != nullptr) {
+        sim_pipeline_acquire(engine->pipeline);
+    }
+    int64_t start = monotonic_ns();
+    size_t bound = fireworks_snapshot_bound(&engine->sim);
+    auto *blob = (unsigned char *) malloc(sizeof(struct saved_state) + bound);
+    if (blob == nullptr) {
+        return;
+    }
+    size_t size = fireworks_snapshot_save(&engine->sim, blob + sizeof(struct saved_state), bound);
+    engine->state.snapshot = SNAPSHOT_NONE;
+    if (size > 0 && size <= SNAPSHOT_INLINE_MAX) {
+        engine->state.snapshot = SNAPSHOT_INLINE;
+    } else if (size > 0) {
+        char path[PATH_MAX];
+        FILE *file = snapshot_path(engine, path, sizeof(path)) == 0 ? fopen(path, "wb") : nullptr;
+        if (file != nullptr) {
+            int ok = fwrite(blob + sizeof(struct saved_state), size, 1, file) == 1;
+            if (fclose(file) == 0 && ok) {
+                engine->state.snapshot = SNAPSHOT_FILE;
+            }
+        }
+    }
+    memcpy(blob, &engine->state, sizeof(struct saved_state));
+    engine->app->savedState = blob;
+    engine->app->savedStateSize = sizeof(struct saved_state) +
+                                  (engine->state.snapshot == SNAPSHOT_INLINE ? size : 0);
+    LOGI("snapshot saved: %d particles, %zu bytes (%s), %.2f ms", engine->sim.particles.count, size,
+         engine->state.snapshot == SNAPSHOT_INLINE ? "inline" :
+         engine->state.snapshot == SNAPSHOT_FILE ? "file" : "failed",
+         (monotonic_ns() - start) * 1e-6);
+}
+
+// 系统恢复 Activity 时（savedState 非空）从快照继续上次的场景，失败时按冷启动
+static void engine_restore_snapshot(struct engine *engine, const void *savedState, size_t savedStateSize) {
+    if (savedState == nullptr || savedStateSize < sizeof(struct saved_state) ||
+        engine->state.snapshot == SNAPSHOT_NONE) {
+        return;
+    }
+    int64_t start = monotonic_ns();
+    const void *data = (const unsigned char *) savedState + sizeof(struct saved_state);
+    size_t size = savedStateSize - sizeof(struct saved_state);
+    void *fileData = nullptr;
+    char path[PATH_MAX];
+    if (engine->state.snapshot == SNAPSHOT_FILE) {
+        size = 0;
+        FILE *file = snapshot_path(engine, path, sizeof(path)) == 0 ? fopen(path, "rb") : nullptr;
+        if (file != nullptr) {
+            fseek(file, 0, SEEK_END);
+            long length = ftell(file);
+            fseek(file, 0, SEEK_SET);
+            fileData = length > 0 ? malloc((size_t) length) : nullptr;
+            if (fileData != nullptr && fread(fileData, (size_t) length, 1, file) == 1) {
+                size = (size_t) length;
+            }
+            fclose(file);
+            remove(path);
+        }
+        data = fileData;
+    }
+    if (size > 0 && fireworks_snapshot_load(&engine->sim, data, size) == 0) {
+        LOGI("snapshot restored: %d particles at %.2f s, %zu bytes, %.2f ms", engine->sim.particles.count,
+             engine->sim.totalTime, size, (monotonic_ns() - start) * 1e-6);
+    } else {
+        LOGW("snapshot unusable, starting cold");
+    }
+    free(fileData);
+}
+
+// ---------- 加速度计 ----------
+// 一次取出队列里积压的全部事件（每批 SENSOR_BATCH 个），只写入环形缓冲，低通留到绘制帧时做
+static void engine_drain_sensor(struct engine *engine) {
+    ASensorEvent events[SENSOR_BATCH];
+    MotionSample samples[SENSOR_BATCH];
+    ssize_t count;
+    while ((count = ASensorEventQueue_getEvents(engine->sensorEventQueue, events, SENSOR_BATCH)) > 0) {
+        int accepted = 0;
+        for (ssize_t i = 0; i < count; i++) {
+            if (events[i].type == ASENSOR_TYPE_ACCELEROMETER) {
+                samples[accepted].timestamp = events[i].timestamp;
+                samples[accepted].x = events[i].acceleration.x;
+                samples[accepted].y = events[i].acceleration.y;
+                samples[accepted].z = events[i].acceleration.z;
+                accepted++;
+            }
+        }
+        motion_field_push(&engine->motion, samples, accepted);
+    }
+}
+
+// 加速度计读数是设备坐标，按屏幕方向换到屏幕坐标。NDK 只能区分横竖屏，横屏按逆时针 90° 处理
+static void engine_update_rotation(struct engine *engine) {
+    int landscape = engine->app->config != nullptr &&
+                    AConfiguration_getOrientation(engine->app->config) == ACONFIGURATION_ORIENTATION_LAND;
+    motion_field_set_rotation(&engine->motion, landscape ? 1 : 0);
+}
+
 // ---------- 命令处理 ----------
 static void engine_handle_cmd(struct android_app *app, int32_t cmd) {
     auto *engine = (struct engine *) app->userData;
     switch (cmd) {
         case APP_CMD_SAVE_STATE:
-            engine->app->savedState = malloc(sizeof(struct saved_state));
-            *((struct saved_state *) engine->app->savedState) = engine->state;
-            engine->app->savedStateSize = sizeof(struct saved_state);
+            engine_save_state(engine);
             break;
         case APP_CMD_INIT_WINDOW:
             if (engine->app->window != nullptr) {
@@ -631,8 +1441,12 @@ static void engine_handle_cmd(struct android_app *app, int32_t cmd) {
         case APP_CMD_TERM_WINDOW:
             engine_term_display(engine);
             break;
+        case APP_CMD_CONFIG_CHANGED:
+            engine_update_rotation(engine);
+            break;
         case APP_CMD_GAINED_FOCUS:
             if (engine->accelerometerSensor != nullptr) {
+                motion_field_reset(&engine->motion);  // 停用期间的旧样本和滤波状态不再有意义
                 ASensorEventQueue_enableSensor(engine->sensorEventQueue, engine->accelerometerSensor);
                 ASensorEventQueue_setEventRate(engine->sensorEventQueue, engine->accelerometerSensor, (1000L / 60) * 1000);
             }
@@ -643,6 +1457,7 @@ static void engine_handle_cmd(struct android_app *app, int32_t cmd) {
             }
             engine->animating = 0;
             engine_draw_frame(engine);
+            engine->lastFrameNs = 0; // 暂停期间不计入模拟时间
             break;
         default:
             break;
@@ -681,6 +1496,8 @@ ASensorManager *AcquireASensorManagerInstance(android_app *app) {
 void android_main(struct android_app *state) {
     struct engine engine{};
     memset(&engine, 0, sizeof(engine));
+    engine.startup.startNs = monotonic_ns();
+    engine.startup.early = read_early_gl_property();
 
     state->userData = &engine;
     state->onAppCmd = engine_handle_cmd;
@@ -691,21 +1508,48 @@ void android_main(struct android_app *state) {
     engine.sensorManager = AcquireASensorManagerInstance(state);
     engine.accelerometerSensor = ASensorManager_getDefaultSensor(engine.sensorManager, ASENSOR_TYPE_ACCELEROMETER);
     engine.sensorEventQueue = ASensorManager_createEventQueue(engine.sensorManager, state->looper, LOOPER_ID_USER, nullptr, nullptr);
+    motion_field_init(&engine.motion, MOTION_CUTOFF_HZ, MOTION_SCALE, MOTION_LIMIT);
+    engine_update_rotation(&engine);
 
-    if (state->savedState != nullptr) {
+    if (state->savedState != nullptr && state->savedStateSize >= sizeof(struct saved_state)) {
         engine.state = *(struct saved_state *) state->savedState;
     }
 
-    // 初始化随机种子
-    srand(time(NULL));
-
     // 记录开始时间
     gettimeofday(&engine.state.startTime, NULL);
-    engine.totalTime = 0.0f;
-    engine.fireworkTimer = 0.0f;
-    engine.textSpawned = 0;
-    engine.shouldExit = 0;
-    engine.particleCount = 0;
+
+    // 当前线程作为 0 号工作线程，其余核心跑后台工作线程
+    engine.jobs = job_system_create(0);
+    LOGI("job system threads: %d", job_system_thread_count(engine.jobs));
+
+    // 随机种子：debug.fireworks.seed 指定时可复现同一场烟花（基准/回放）
+    uint64_t seed = read_seed_property();
+    int maxParticles = particle_pool_capacity_for_budget(read_pool_budget_property());
+    int initialParticles = INITIAL_PARTICLES < maxParticles ? INITIAL_PARTICLES : maxParticles;
+    if (fireworks_sim_init(&engine.sim, initialParticles, maxParticles, SPAWN_BUDGET, engine.jobs, seed) != 0) {
+        LOGW("particle pool alloc failed");
+        job_system_destroy(engine.jobs);
+        return;
+    }
+#if FRAME_PROFILER_ENABLED
+    frame_profiler_init(&engine.profiler);
+    engine.sim.profiler = &engine.profiler;
+#endif
+    // 系统创建窗口的同时建立上下文、编译着色器、上传纹理，APP_CMD_INIT_WINDOW 时只需绑定窗口表面
+    if (engine.startup.early) {
+        engine_bootstrap_gl(&engine);
+    }
+    LOGI("random seed: %llu", (unsigned long long) seed);
+    log_pool_metrics(&engine.sim.particles);
+    load_text_cloud(&engine);
+    engine_restore_snapshot(&engine, state->savedState, state->savedStateSize);
+    if (read_schedule_property() == SCHEDULE_PIPELINED) {
+        engine.pipeline = sim_pipeline_create(engine_produce_frame, &engine);
+        if (engine.pipeline == nullptr) {
+            LOGW("simulation thread unavailable, running serially");
+        }
+    }
+    LOGI("frame schedule: %s", kScheduleNames[engine.pipeline != nullptr ? SCHEDULE_PIPELINED : SCHEDULE_SERIAL]);
 
     // 主循环
     while (true) {
@@ -719,12 +1563,22 @@ void android_main(struct android_app *state) {
             }
             if (ident == LOOPER_ID_USER) {
                 if (engine.accelerometerSensor != nullptr) {
-                    ASensorEvent event;
-                    ASensorEventQueue_getEvents(engine.sensorEventQueue, &event, 1);
+                    engine_drain_sensor(&engine);
                 }
             }
             if (state->destroyRequested != 0) {
                 engine_term_display(&engine);
+                LOGI("spawn requests dropped: %d, simulation steps skipped: %d",
+                     engine.sim.spawns.dropped, engine.skippedSteps);
+                LOGI("accelerometer: %u batches, largest %u events, %u overwritten before use",
+                     engine.motion.batches, engine.motion.maxBatch, engine.motion.overruns);
+                log_pool_metrics(&engine.sim.particles);
+                sim_pipeline_destroy(engine.pipeline);
+                job_system_destroy(engine.jobs);
+                if (engine.textAsset != nullptr) {
+                    AAsset_close(engine.textAsset);
+                }
+                fireworks_sim_free(&engine.sim);
                 return;
             }
         }
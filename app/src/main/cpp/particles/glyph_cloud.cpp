@@ -0,0 +1,31 @@
+#include "glyph_cloud.h"
+
+#include <cstring>
+
+int glyph_cloud_view(const void *data, size_t size, GlyphCloud *cloud) {
+    memset(cloud, 0, sizeof(*cloud));
+    if (data == nullptr || size < sizeof(GlyphCloudHeader) || ((uintptr_t) data & 3) != 0) {
+        return -1;
+    }
+    const auto *header = (const GlyphCloudHeader *) data;
+    if (header->magic != GLYPH_CLOUD_MAGIC || header->version != GLYPH_CLOUD_VERSION ||
+        header->headerSize < sizeof(GlyphCloudHeader) || header->headerSize > size ||
+        (header->headerSize & 3) != 0) {
+        return -1;
+    }
+    size_t count = header->count;
+    if (count > (size - header->headerSize) / (5 * sizeof(float))) {
+        return -1;
+    }
+
+    const float *columns = (const float *) ((const char *) data + header->headerSize);
+    cloud->count = (int) count;
+    cloud->extentX = header->extentX;
+    cloud->extentY = header->extentY;
+    cloud->x = columns;
+    cloud->y = columns + count;
+    cloud->dx = columns + 2 * count;
+    cloud->dy = columns + 3 * count;
+    cloud->weight = columns + 4 * count;
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef NATIVE_ACTIVITY_GLYPH_CLOUD_H
+#define NATIVE_ACTIVITY_GLYPH_CLOUD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------- 文字点云资源（.gpc）----------
+// 由 tools/glyph_cloud_tool 离线把字符串光栅化后按覆盖率加权采样生成。
+// 文件布局（小端，4 字节对齐）：
+//   GlyphCloudHeader
+//   float x[count], y[count]      位置，整段文字高度为 1，中心在原点
+//   float dx[count], dy[count]    从所属字形中心向外的单位方向（爆炸速度方向）
+//   float weight[count]           (0, 1]，采样像素的覆盖率，边缘较小
+// 采样点彼此独立同分布，任意前缀都是整体形状的均匀样本，可直接截取前 n 个使用。
+// 运行时不解析、不拷贝：glyph_cloud_view 只校验头部并让各列指针指向原始数据。
+
+#define GLYPH_CLOUD_MAGIC   0x31435047u   // "GPC1"
+#define GLYPH_CLOUD_VERSION 1
+
+typedef struct GlyphCloudHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;     // sizeof(GlyphCloudHeader)，列数据紧随其后
+    uint32_t count;
+    float extentX;           // x 方向半宽
+    float extentY;           // y 方向半高（0.5）
+    uint32_t reserved[3];
+} GlyphCloudHeader;
+
+typedef struct GlyphCloud {
+    int count;
+    float extentX, extentY;
+    const float *x, *y;
+    const float *dx, *dy;
+    const float *weight;
+} GlyphCloud;
+
+// 在 data（至少 4 字节对齐）上建立只读视图，格式不符返回 -1。data 需在使用期间保持有效。
+int glyph_cloud_view(const void *data, size_t size, GlyphCloud *cloud);
+
+#endif //NATIVE_ACTIVITY_GLYPH_CLOUD_H
@@ -0,0 +1,98 @@
+#include "particle_arena.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+
+#define DEVICE_BUDGET_LOW  (4u << 20)    // 约 5 万粒子
+#define DEVICE_BUDGET_MID  (16u << 20)   // 约 20 万粒子
+#define DEVICE_BUDGET_HIGH (96u << 20)   // 约 120 万粒子
+
+static size_t round_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int particle_arena_reserve(ParticleArena *arena, size_t bytes, int flags) {
+    memset(arena, 0, sizeof(*arena));
+    if (bytes == 0) {
+        return -1;
+    }
+    const int prot = PROT_READ | PROT_WRITE;
+    const int mapFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    const int huge = (flags & PARTICLE_ARENA_HUGE_PAGES) && bytes >= PARTICLE_HUGE_PAGE_SIZE;
+
+#ifdef MAP_HUGETLB
+    if (huge) {
+        // 需要系统预留了 hugetlb 页（多数手机没有），失败时退回普通映射。
+        // 不能带 MAP_NORESERVE：预留页不足时 mmap 会直接失败，而不是在首次写入时 SIGBUS
+        size_t size = round_up(bytes, PARTICLE_HUGE_PAGE_SIZE);
+        void *mapping = mmap(nullptr, size, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED) {
+            arena->base = arena->mapping = mapping;
+            arena->size = arena->mappingSize = size;
+            arena->pages = PARTICLE_PAGES_HUGETLB;
+            return 0;
+        }
+    }
+#endif
+
+    // 透明大页要求 2 MB 对齐，多保留一个大页的余量再对齐起点
+    size_t alignment = huge ? PARTICLE_HUGE_PAGE_SIZE : (size_t) sysconf(_SC_PAGESIZE);
+    size_t size = round_up(bytes, alignment);
+    size_t mappingSize = huge ? size + alignment : size;
+    void *mapping = mmap(nullptr, mappingSize, prot, mapFlags, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return -1;
+    }
+    arena->mapping = mapping;
+    arena->mappingSize = mappingSize;
+    arena->base = (void *) round_up((uintptr_t) mapping, alignment);
+    arena->size = size;
+    arena->pages = PARTICLE_PAGES_NORMAL;
+#ifdef MADV_HUGEPAGE
+    if (huge && madvise(arena->base, size, MADV_HUGEPAGE) == 0) {
+        arena->pages = PARTICLE_PAGES_TRANSPARENT;
+    }
+#endif
+    return 0;
+}
+
+void particle_arena_release(ParticleArena *arena) {
+    if (arena->mapping != nullptr) {
+        munmap(arena->mapping, arena->mappingSize);
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+int particle_device_class(void) {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    long cores = sysconf(_SC_NPROCESSORS_CONF);
+    double gigabytes = pages > 0 && pageSize > 0 ? (double) pages * (double) pageSize / (1u << 30) : 0.0;
+    // 标称 4/8 GB 的设备可用于内核的内存略少，阈值留出余量
+    if (gigabytes < 3.5 || cores < 6) {
+        return PARTICLE_DEVICE_LOW;
+    }
+    if (gigabytes < 7.0) {
+        return PARTICLE_DEVICE_MID;
+    }
+    return PARTICLE_DEVICE_HIGH;
+}
+
+size_t particle_device_budget(int deviceClass) {
+    switch (deviceClass) {
+        case PARTICLE_DEVICE_HIGH:
+            return DEVICE_BUDGET_HIGH;
+        case PARTICLE_DEVICE_MID:
+            return DEVICE_BUDGET_MID;
+        default:
+            return DEVICE_BUDGET_LOW;
+    }
+}
+
+const char *particle_device_class_name(int deviceClass) {
+    static const char *names[] = {"low", "mid", "high"};
+    return deviceClass >= PARTICLE_DEVICE_LOW && deviceClass <= PARTICLE_DEVICE_HIGH ? names[deviceClass] : "?";
+}
@@ -0,0 +1,45 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_ARENA_H
+#define NATIVE_ACTIVITY_PARTICLE_ARENA_H
+
+#include <stddef.h>
+
+// ---------- 粒子内存区 ----------
+// 一次性保留按最大容量计算的虚拟地址空间（匿名 mmap，MAP_NORESERVE），
+// 物理页在首次写入时才由内核分配：粒子池扩容只是提高可用上限，不搬移、不重新分配。
+// 大于一个大页时按 2 MB 对齐并请求大页：先尝试 hugetlb，失败则 madvise(MADV_HUGEPAGE) 交给透明大页。
+
+#define PARTICLE_ARENA_HUGE_PAGES 1     // 请求大页（仅对不小于 PARTICLE_HUGE_PAGE_SIZE 的区域生效）
+#define PARTICLE_HUGE_PAGE_SIZE   (2u << 20)
+
+enum ParticleArenaPages {
+    PARTICLE_PAGES_NORMAL,
+    PARTICLE_PAGES_TRANSPARENT,  // 已 madvise，是否真正使用大页由内核决定
+    PARTICLE_PAGES_HUGETLB       // hugetlb 显式大页
+};
+
+typedef struct ParticleArena {
+    void *base;          // 对齐后的起点
+    size_t size;         // 可用字节数
+    void *mapping;       // mmap 返回的原始区域（含对齐余量）
+    size_t mappingSize;
+    int pages;           // ParticleArenaPages
+} ParticleArena;
+
+// 保留至少 bytes 字节（内容为 0），成功返回 0，失败返回 -1
+int particle_arena_reserve(ParticleArena *arena, size_t bytes, int flags);
+void particle_arena_release(ParticleArena *arena);
+
+// ---------- 设备档次与内存预算 ----------
+enum ParticleDeviceClass {
+    PARTICLE_DEVICE_LOW,     // 内存不到约 4 GB 或少于 6 核
+    PARTICLE_DEVICE_MID,     // 内存不到约 8 GB
+    PARTICLE_DEVICE_HIGH
+};
+
+// 按物理内存和 CPU 核心数估计设备档次
+int particle_device_class(void);
+// 各档次给粒子池的默认内存预算（字节）
+size_t particle_device_budget(int deviceClass);
+const char *particle_device_class_name(int deviceClass);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_ARENA_H
@@ -0,0 +1,165 @@
+#include "particle_cull.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+enum {
+    SUM_WEIGHT, SUM_X, SUM_Y, SUM_R, SUM_G, SUM_B, SUM_AREA,
+    SUM_COUNT
+};
+
+void particle_cull_stats_add(ParticleCullStats *total, const ParticleCullStats *stats) {
+    total->input += stats->input;
+    total->offscreen += stats->offscreen;
+    total->faint += stats->faint;
+    total->tiny += stats->tiny;
+    total->aggregates += stats->aggregates;
+    total->output += stats->output;
+}
+
+// 每批先算分类码（无分支，编译器可向量化），再按码压实
+#define CULL_BATCH 256
+
+enum {
+    CULL_KEEP,
+    CULL_OFFSCREEN,
+    CULL_FAINT,
+    CULL_TINY
+};
+
+int particle_cull_range(const ParticlePool *pool, int begin, int end, float alpha,
+                        const ParticleCullParams *params, ParticleVertex *out,
+                        int32_t *tiny, int *tinyCount, ParticleCullStats *stats) {
+    // 点半径（世界单位）= size / 2 / pixelsPerUnit
+    const float radiusScale = 0.5f / params->pixelsPerUnit;
+    const float left = params->left, right = params->right, bottom = params->bottom, top = params->top;
+    const float minAlpha = params->minAlpha, minSize = params->minSize;
+    const int merge = params->mergeTile > 0.0f;
+    int kept = begin, tinyEnd = begin;
+    int counts[4] = {0, 0, 0, 0};
+    uint8_t codes[CULL_BATCH];
+    for (int first = begin; first < end; first += CULL_BATCH) {
+        const int n = end - first < CULL_BATCH ? end - first : CULL_BATCH;
+        const float *x = pool->x + first, *y = pool->y + first;
+        const float *px = pool->px + first, *py = pool->py + first;
+        const float *size = pool->size + first, *a = pool->a + first;
+        for (int k = 0; k < n; k++) {
+            float cx = px[k] + (x[k] - px[k]) * alpha;
+            float cy = py[k] + (y[k] - py[k]) * alpha;
+            float radius = size[k] * radiusScale;
+            int outside = (cx + radius < left) | (cx - radius > right) |
+                          (cy + radius < bottom) | (cy - radius > top);
+            int dim = a[k] < minAlpha;
+            int small = size[k] < minSize;
+            // 优先级：屏幕外 > 过淡 > 过小
+            int code = small ? CULL_TINY : CULL_KEEP;
+            code = dim ? CULL_FAINT : code;
+            codes[k] = (uint8_t) (outside ? CULL_OFFSCREEN : code);
+        }
+        // 压实也不分支：每个元素都写一次，只按条件移动写指针（kept/tinyEnd 不会超过当前下标）
+        for (int k = 0; k < n; k++) {
+            const int code = codes[k];
+            counts[code]++;
+            out[kept] = out[first + k];
+            kept += code == CULL_KEEP;
+            tiny[tinyEnd] = first + k;
+            tinyEnd += (code == CULL_TINY) & merge;
+        }
+    }
+    *tinyCount = tinyEnd - begin;
+    stats->input += end - begin;
+    stats->offscreen += counts[CULL_OFFSCREEN];
+    stats->faint += counts[CULL_FAINT];
+    stats->tiny += counts[CULL_TINY];
+    stats->output += kept - begin;
+    return kept - begin;
+}
+
+void particle_tile_merge_free(ParticleTileMerge *merge) {
+    free(merge->sums);
+    free(merge->touched);
+    memset(merge, 0, sizeof(*merge));
+}
+
+static int prepare_grid(ParticleTileMerge *merge, const ParticleCullParams *params) {
+    float tileUnits = params->mergeTile / params->pixelsPerUnit;
+    int cols = (int) ceilf((params->right - params->left) / tileUnits);
+    int rows = (int) ceilf((params->top - params->bottom) / tileUnits);
+    cols = cols > 0 ? cols : 1;
+    rows = rows > 0 ? rows : 1;
+    if (cols * rows > merge->tileCapacity) {
+        // 只在可见区域变大时重新分配；新网格整体清零
+        int capacity = cols * rows;
+        auto *sums = (float *) calloc((size_t) capacity * SUM_COUNT, sizeof(float));
+        auto *touched = (int32_t *) malloc((size_t) capacity * sizeof(int32_t));
+        if (sums == nullptr || touched == nullptr) {
+            free(sums);
+            free(touched);
+            return -1;
+        }
+        particle_tile_merge_free(merge);
+        merge->sums = sums;
+        merge->touched = touched;
+        merge->tileCapacity = capacity;
+    }
+    merge->cols = cols;
+    merge->rows = rows;
+    return 0;
+}
+
+int particle_tile_merge(ParticleTileMerge *merge, const ParticlePool *pool, float alpha,
+                        const ParticleCullParams *params, const int32_t *tiny, int count,
+                        ParticleVertex *out) {
+    if (count == 0) {
+        return 0;
+    }
+    if (prepare_grid(merge, params) != 0) {
+        return -1;
+    }
+    const float tilesPerUnit = params->pixelsPerUnit / params->mergeTile;
+    merge->touchedCount = 0;
+    for (int k = 0; k < count; k++) {
+        int i = tiny[k];
+        float area = pool->size[i] * pool->size[i];
+        if (area <= 0.0f) {
+            continue;   // 面积为 0 的点不可见，也不能用来标记瓦片
+        }
+        float x = pool->px[i] + (pool->x[i] - pool->px[i]) * alpha;
+        float y = pool->py[i] + (pool->y[i] - pool->py[i]) * alpha;
+        int col = (int) ((x - params->left) * tilesPerUnit);
+        int row = (int) ((y - params->bottom) * tilesPerUnit);
+        // 半径跨出可见区域的粒子归到边缘瓦片
+        col = col < 0 ? 0 : (col >= merge->cols ? merge->cols - 1 : col);
+        row = row < 0 ? 0 : (row >= merge->rows ? merge->rows - 1 : row);
+        int tile = row * merge->cols + col;
+        float *sum = merge->sums + (size_t) tile * SUM_COUNT;
+        float weight = pool->a[i] * area;
+        if (sum[SUM_AREA] == 0.0f) {
+            merge->touched[merge->touchedCount++] = tile;
+        }
+        sum[SUM_WEIGHT] += weight;
+        sum[SUM_X] += weight * x;
+        sum[SUM_Y] += weight * y;
+        sum[SUM_R] += weight * pool->r[i];
+        sum[SUM_G] += weight * pool->g[i];
+        sum[SUM_B] += weight * pool->b[i];
+        sum[SUM_AREA] += area;
+    }
+
+    const float maxSize = params->mergeTile;
+    int written = 0;
+    for (int t = 0; t < merge->touchedCount; t++) {
+        float *sum = merge->sums + (size_t) merge->touched[t] * SUM_COUNT;
+        if (sum[SUM_WEIGHT] > 0.0f) {
+            float inv = 1.0f / sum[SUM_WEIGHT];
+            float size = sqrtf(sum[SUM_AREA]);
+            size = size < maxSize ? size : maxSize;
+            particle_pack_vertex(sum[SUM_X] * inv, sum[SUM_Y] * inv,
+                                 sum[SUM_R] * inv, sum[SUM_G] * inv, sum[SUM_B] * inv,
+                                 sum[SUM_WEIGHT] / (size * size), size, &out[written++]);
+        }
+        memset(sum, 0, SUM_COUNT * sizeof(float));
+    }
+    return written;
+}
@@ -0,0 +1,60 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_CULL_H
+#define NATIVE_ACTIVITY_PARTICLE_CULL_H
+
+#include <stdint.h>
+
+#include "particle_pack.h"
+#include "particle_pool.h"
+
+// ---------- 剔除与细节层次 ----------
+// 位于更新和提交之间：顶点照常（SIMD）打包后，逐粒子判断是否值得画，保留的顶点在原位前移压实。
+//   - 屏幕外：插值后的位置加上点半径仍在可见区域外
+//   - 过淡：alpha 低于 minAlpha（量化后基本为 0）
+//   - 过小：点大小低于 minSize 像素。mergeTile > 0 时不丢弃，而是按屏幕瓦片合并，
+//     每个瓦片输出一个聚合点：面积守恒（size² 求和），位置和颜色按 alpha * size² 加权，
+//     alpha 取总亮度除以聚合面积，整体亮度与逐个绘制时相近。
+
+typedef struct ParticleCullParams {
+    float left, right, bottom, top;  // 可见区域（世界坐标）
+    float pixelsPerUnit;             // 世界单位对应的像素数
+    float minSize;                   // 像素，低于此值的粒子不单独绘制
+    float minAlpha;
+    float mergeTile;                 // 合并瓦片边长（像素），0 表示直接丢弃过小的粒子
+} ParticleCullParams;
+
+typedef struct ParticleCullStats {
+    int64_t input;       // 参与剔除的粒子数
+    int64_t offscreen;
+    int64_t faint;
+    int64_t tiny;        // 过小的粒子（合并或丢弃）
+    int64_t aggregates;  // 合并输出的聚合点数
+    int64_t output;      // 最终提交的顶点数
+} ParticleCullStats;
+
+void particle_cull_stats_add(ParticleCullStats *total, const ParticleCullStats *stats);
+
+// 剔除 [begin, end) 区间已打包到 out[begin, end) 的顶点，保留的顶点前移到 out[begin] 起，返回保留数。
+// 开启合并时过小粒子的下标写入 tiny[begin] 起，个数写到 *tinyCount。stats 只累加本区间。
+// 各区间只读写自己的范围，可分块并行。
+int particle_cull_range(const ParticlePool *pool, int begin, int end, float alpha,
+                        const ParticleCullParams *params, ParticleVertex *out,
+                        int32_t *tiny, int *tinyCount, ParticleCullStats *stats);
+
+// ---------- 瓦片合并 ----------
+typedef struct ParticleTileMerge {
+    int cols, rows;
+    int tileCapacity;
+    float *sums;         // 每瓦片 7 个累加量：权重、x、y、r、g、b、面积
+    int32_t *touched;    // 本帧用到的瓦片，输出后只清这些
+    int touchedCount;
+} ParticleTileMerge;
+
+void particle_tile_merge_free(ParticleTileMerge *merge);
+
+// 把 count 个过小粒子按瓦片合并，聚合点写到 out，返回个数（不超过 count）。失败返回 -1。
+// 瓦片网格按 params 的可见区域和 mergeTile 确定，尺寸变化时重新分配。
+int particle_tile_merge(ParticleTileMerge *merge, const ParticlePool *pool, float alpha,
+                        const ParticleCullParams *params, const int32_t *tiny, int count,
+                        ParticleVertex *out);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_CULL_H
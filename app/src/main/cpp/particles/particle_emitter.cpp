@@ -0,0 +1,313 @@
+#include "particle_emitter.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLE_EMITTER_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLE_EMITTER_SSE2 1
+#endif
+
+// 每块处理的粒子数，随机数与中间结果都放在栈上
+#define EMIT_CHUNK 64
+// 每个粒子使用的随机数：方向/vx、速度/vy、大小、寿命、x 偏移、y 偏移，颜色抖动时再加 r g b
+#define EMIT_RANDOMS       9
+#define EMIT_RANDOMS_PLAIN 6
+
+// ---------- sincos ----------
+// 先按 2π 取整归约到 [-π, π]（2π 拆成高低两部分，高位乘整数无舍入），
+// sin 再折叠到 [-π/2, π/2]，cos(x) = sin(π/2 - |x|)，两者共用到 x^11 的奇次泰勒多项式，
+// 截断误差 < 6e-8。
+#define SC_INV_TWO_PI 0.159154943f
+#define SC_TWO_PI_HI  6.28125f
+#define SC_TWO_PI_LO  1.93530717e-3f
+#define SC_PI         3.14159265f
+#define SC_HALF_PI    1.57079633f
+#define SC_C3  (-1.66666667e-1f)
+#define SC_C5  8.33333333e-3f
+#define SC_C7  (-1.98412698e-4f)
+#define SC_C9  2.75573192e-6f
+#define SC_C11 (-2.50521084e-8f)
+
+static inline float sin_poly(float y) {
+    float y2 = y * y;
+    float p = SC_C9 + y2 * SC_C11;
+    p = SC_C7 + y2 * p;
+    p = SC_C5 + y2 * p;
+    p = SC_C3 + y2 * p;
+    return y + y * y2 * p;
+}
+
+static void sincos_scalar(const float *angles, float *sines, float *cosines, int count) {
+    for (int i = 0; i < count; i++) {
+        float q = angles[i] * SC_INV_TWO_PI;
+        float k = (float) (int) (q + (q < 0.0f ? -0.5f : 0.5f));
+        float x = (angles[i] - k * SC_TWO_PI_HI) - k * SC_TWO_PI_LO;
+        float fold = (x < 0.0f ? -SC_PI : SC_PI) - x;
+        sines[i] = sin_poly(fabsf(x) > SC_HALF_PI ? fold : x);
+        cosines[i] = sin_poly(SC_HALF_PI - fabsf(x));
+    }
+}
+
+#if defined(PARTICLE_EMITTER_NEON)
+
+static inline float32x4_t sin_poly4(float32x4_t y) {
+    float32x4_t y2 = vmulq_f32(y, y);
+    float32x4_t p = vmlaq_f32(vdupq_n_f32(SC_C9), y2, vdupq_n_f32(SC_C11));
+    p = vmlaq_f32(vdupq_n_f32(SC_C7), y2, p);
+    p = vmlaq_f32(vdupq_n_f32(SC_C5), y2, p);
+    p = vmlaq_f32(vdupq_n_f32(SC_C3), y2, p);
+    return vmlaq_f32(y, vmulq_f32(y, y2), p);
+}
+
+static int sincos_simd(const float *angles, float *sines, float *cosines, int count) {
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t angle = vld1q_f32(angles + i);
+        float32x4_t q = vmulq_f32(angle, vdupq_n_f32(SC_INV_TWO_PI));
+        // 加 ±0.5 后截断即四舍五入
+        float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(q), signMask),
+                                                           vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+        float32x4_t k = vcvtq_f32_s32(vcvtq_s32_f32(vaddq_f32(q, half)));
+        float32x4_t x = vmlsq_f32(vmlsq_f32(angle, k, vdupq_n_f32(SC_TWO_PI_HI)), k, vdupq_n_f32(SC_TWO_PI_LO));
+        float32x4_t ax = vabsq_f32(x);
+        float32x4_t pi = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x), signMask),
+                                                         vreinterpretq_u32_f32(vdupq_n_f32(SC_PI))));
+        uint32x4_t outer = vcgtq_f32(ax, vdupq_n_f32(SC_HALF_PI));
+        float32x4_t y = vbslq_f32(outer, vsubq_f32(pi, x), x);
+        vst1q_f32(sines + i, sin_poly4(y));
+        vst1q_f32(cosines + i, sin_poly4(vsubq_f32(vdupq_n_f32(SC_HALF_PI), ax)));
+    }
+    return i;
+}
+
+#elif defined(PARTICLE_EMITTER_SSE2)
+
+static inline __m128 sin_poly4(__m128 y) {
+    __m128 y2 = _mm_mul_ps(y, y);
+    __m128 p = _mm_add_ps(_mm_set1_ps(SC_C9), _mm_mul_ps(y2, _mm_set1_ps(SC_C11)));
+    p = _mm_add_ps(_mm_set1_ps(SC_C7), _mm_mul_ps(y2, p));
+    p = _mm_add_ps(_mm_set1_ps(SC_C5), _mm_mul_ps(y2, p));
+    p = _mm_add_ps(_mm_set1_ps(SC_C3), _mm_mul_ps(y2, p));
+    return _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(y, y2), p));
+}
+
+static int sincos_simd(const float *angles, float *sines, float *cosines, int count) {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int) 0x80000000u));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 angle = _mm_loadu_ps(angles + i);
+        __m128 q = _mm_mul_ps(angle, _mm_set1_ps(SC_INV_TWO_PI));
+        // 加 ±0.5 后截断即四舍五入
+        __m128 half = _mm_or_ps(_mm_and_ps(q, signMask), _mm_set1_ps(0.5f));
+        __m128 k = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_add_ps(q, half)));
+        __m128 x = _mm_sub_ps(_mm_sub_ps(angle, _mm_mul_ps(k, _mm_set1_ps(SC_TWO_PI_HI))),
+                              _mm_mul_ps(k, _mm_set1_ps(SC_TWO_PI_LO)));
+        __m128 ax = _mm_andnot_ps(signMask, x);
+        __m128 pi = _mm_or_ps(_mm_and_ps(x, signMask), _mm_set1_ps(SC_PI));
+        __m128 outer = _mm_cmpgt_ps(ax, _mm_set1_ps(SC_HALF_PI));
+        __m128 y = _mm_or_ps(_mm_and_ps(outer, _mm_sub_ps(pi, x)), _mm_andnot_ps(outer, x));
+        _mm_storeu_ps(sines + i, sin_poly4(y));
+        _mm_storeu_ps(cosines + i, sin_poly4(_mm_sub_ps(_mm_set1_ps(SC_HALF_PI), ax)));
+    }
+    return i;
+}
+
+#else
+
+static int sincos_simd(const float *, float *, float *, int) {
+    return 0;
+}
+
+#endif
+
+void particle_sincos(const float *angles, float *sines, float *cosines, int count) {
+    int done = sincos_simd(angles, sines, cosines, count);
+    sincos_scalar(angles + done, sines + done, cosines + done, count - done);
+}
+
+// ---------- 发射 ----------
+
+// 在暂存池末尾预留 count 个槽位，返回起始下标，*granted 为实际可写数量
+static int reserve(ParticleSpawnBuffer *buffer, int count, int *granted) {
+    ParticlePool *staged = &buffer->staged;
+    int n = staged->capacity - staged->count;
+    if (n > count) {
+        n = count;
+    }
+    buffer->dropped += count - n;
+    *granted = n;
+    int begin = staged->count;
+    staged->count += n;
+    return begin;
+}
+
+// 为一块 n 个粒子生成随机数，按列存放：random[k * EMIT_CHUNK + i] 是第 i 个粒子的第 k 个随机数
+static void fill_chunk(ParticleRandom *rng, const ParticleEmitter *emitter, float *random, int n) {
+    int columns = emitter->colorJitter > 0.0f ? EMIT_RANDOMS : EMIT_RANDOMS_PLAIN;
+    for (int k = 0; k < columns; k++) {
+        particle_random_fill(rng, random + k * EMIT_CHUNK, n);
+    }
+}
+
+// 发射点加随机偏移
+static void write_positions(ParticlePool *pool, int dst, const ParticleEmitter *emitter,
+                            const float *random, int n) {
+    const float *uX = random + 4 * EMIT_CHUNK;
+    const float *uY = random + 5 * EMIT_CHUNK;
+    float *x = pool->x + dst, *y = pool->y + dst;
+    for (int i = 0; i < n; i++) {
+        x[i] = emitter->x + (uX[i] - 0.5f) * emitter->jitter;
+        y[i] = emitter->y + (uY[i] - 0.5f) * emitter->jitter;
+    }
+}
+
+// 写入一块粒子的公共列；位置和速度由调用方写好
+static void write_common(ParticlePool *pool, int dst, const ParticleEmitter *emitter,
+                         const float *random, int n) {
+    const float *uSize = random + 2 * EMIT_CHUNK;
+    const float *uLife = random + 3 * EMIT_CHUNK;
+    const float sizeRange = emitter->sizeMax - emitter->sizeMin;
+    const float lifeRange = emitter->lifeMax - emitter->lifeMin;
+    float *size = pool->size + dst, *life = pool->life + dst, *fade = pool->fade + dst;
+    for (int i = 0; i < n; i++) {
+        size[i] = emitter->sizeMin + uSize[i] * sizeRange;
+        life[i] = emitter->lifeMin + uLife[i] * lifeRange;
+        fade[i] = emitter->alphaScale / life[i];
+    }
+    float *r = pool->r + dst, *g = pool->g + dst, *b = pool->b + dst;
+    if (emitter->colorJitter > 0.0f) {
+        const float *uR = random + 6 * EMIT_CHUNK;
+        const float *uG = random + 7 * EMIT_CHUNK;
+        const float *uB = random + 8 * EMIT_CHUNK;
+        const float base = 1.0f - emitter->colorJitter;
+        for (int i = 0; i < n; i++) {
+            r[i] = emitter->r * (base + uR[i] * emitter->colorJitter);
+            g[i] = emitter->g * (base + uG[i] * emitter->colorJitter);
+            b[i] = emitter->b * (base + uB[i] * emitter->colorJitter);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            r[i] = emitter->r;
+            g[i] = emitter->g;
+            b[i] = emitter->b;
+        }
+    }
+    const float shrink = logf(emitter->sizeDecay);
+    for (int i = 0; i < n; i++) {
+        pool->ax[dst + i] = emitter->ax;
+        pool->ay[dst + i] = emitter->ay;
+        pool->a[dst + i] = emitter->a;
+        pool->shrink[dst + i] = shrink;
+        pool->type[dst + i] = emitter->type;
+    }
+}
+
+int particle_emit_cone(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                       float direction, float spread, float speedMin, float speedMax,
+                       int count, ParticleRandom *rng) {
+    int granted;
+    int begin = reserve(buffer, count, &granted);
+    ParticlePool *pool = &buffer->staged;
+    const float speedRange = speedMax - speedMin;
+
+    float random[EMIT_RANDOMS * EMIT_CHUNK];
+    float angles[EMIT_CHUNK], sines[EMIT_CHUNK], cosines[EMIT_CHUNK];
+    for (int done = 0; done < granted; done += EMIT_CHUNK) {
+        int n = granted - done < EMIT_CHUNK ? granted - done : EMIT_CHUNK;
+        fill_chunk(rng, emitter, random, n);
+        const float *uAngle = random, *uSpeed = random + EMIT_CHUNK;
+        for (int i = 0; i < n; i++) {
+            angles[i] = direction + (uAngle[i] - 0.5f) * spread;
+        }
+        particle_sincos(angles, sines, cosines, n);
+
+        int dst = begin + done;
+        float *vx = pool->vx + dst, *vy = pool->vy + dst;
+        for (int i = 0; i < n; i++) {
+            float speed = speedMin + uSpeed[i] * speedRange;
+            vx[i] = cosines[i] * speed;
+            vy[i] = sines[i] * speed;
+        }
+        write_positions(pool, dst, emitter, random, n);
+        write_common(pool, dst, emitter, random, n);
+    }
+    return granted;
+}
+
+int particle_emit_burst(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                        float speedMin, float speedMax, int count, ParticleRandom *rng) {
+    return particle_emit_cone(buffer, emitter, SC_PI, 2.0f * SC_PI, speedMin, speedMax, count, rng);
+}
+
+int particle_emit_jitter(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                         float vxMin, float vxMax, float vyMin, float vyMax,
+                         int count, ParticleRandom *rng) {
+    int granted;
+    int begin = reserve(buffer, count, &granted);
+    ParticlePool *pool = &buffer->staged;
+
+    float random[EMIT_RANDOMS * EMIT_CHUNK];
+    for (int done = 0; done < granted; done += EMIT_CHUNK) {
+        int n = granted - done < EMIT_CHUNK ? granted - done : EMIT_CHUNK;
+        fill_chunk(rng, emitter, random, n);
+        const float *uVx = random, *uVy = random + EMIT_CHUNK;
+        int dst = begin + done;
+        float *vx = pool->vx + dst, *vy = pool->vy + dst;
+        for (int i = 0; i < n; i++) {
+            vx[i] = vxMin + uVx[i] * (vxMax - vxMin);
+            vy[i] = vyMin + uVy[i] * (vyMax - vyMin);
+        }
+        write_positions(pool, dst, emitter, random, n);
+        write_common(pool, dst, emitter, random, n);
+    }
+    return granted;
+}
+
+int particle_emit_cloud(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                        const GlyphCloud *cloud, float scale, float speedMin, float speedMax,
+                        int count, ParticleRandom *rng) {
+    if (count > cloud->count) {
+        count = cloud->count;
+    }
+    int granted;
+    int begin = reserve(buffer, count, &granted);
+    ParticlePool *pool = &buffer->staged;
+
+    // 位置与方向整列拷贝（点云已是粒子池的列布局），再原地缩放平移
+    memcpy(pool->x + begin, cloud->x, granted * sizeof(float));
+    memcpy(pool->y + begin, cloud->y, granted * sizeof(float));
+    memcpy(pool->vx + begin, cloud->dx, granted * sizeof(float));
+    memcpy(pool->vy + begin, cloud->dy, granted * sizeof(float));
+    float *x = pool->x + begin, *y = pool->y + begin;
+    for (int i = 0; i < granted; i++) {
+        x[i] = emitter->x + x[i] * scale;
+        y[i] = emitter->y + y[i] * scale;
+    }
+
+    const float speedRange = speedMax - speedMin;
+    float random[EMIT_RANDOMS * EMIT_CHUNK];
+    for (int done = 0; done < granted; done += EMIT_CHUNK) {
+        int n = granted - done < EMIT_CHUNK ? granted - done : EMIT_CHUNK;
+        fill_chunk(rng, emitter, random, n);
+        int dst = begin + done;
+        float *vx = pool->vx + dst, *vy = pool->vy + dst;
+        for (int i = 0; i < n; i++) {
+            float speed = speedMin + random[EMIT_CHUNK + i] * speedRange;
+            vx[i] *= speed;
+            vy[i] *= speed;
+        }
+        write_common(pool, dst, emitter, random, n);
+        // 覆盖率低的边缘点画得小一些
+        const float *weight = cloud->weight + done;
+        float *size = pool->size + dst;
+        for (int i = 0; i < n; i++) {
+            size[i] *= weight[i];
+        }
+    }
+    return granted;
+}
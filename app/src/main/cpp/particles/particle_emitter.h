@@ -0,0 +1,49 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_EMITTER_H
+#define NATIVE_ACTIVITY_PARTICLE_EMITTER_H
+
+#include "glyph_cloud.h"
+#include "particle_random.h"
+#include "particle_spawn.h"
+
+// ---------- 批量发射器 ----------
+// 一次调用生成 count 个粒子，按列直接写进发射缓冲暂存池的空闲槽位（不经过 Particle 结构），
+// 随机数按块批量生成，角度用 SIMD sincos 近似。超出预算的部分计入 buffer->dropped。
+
+// 同一批粒子共享的属性
+typedef struct ParticleEmitter {
+    float x, y;                  // 发射点
+    float jitter;                // 发射点随机偏移范围（每轴 ±jitter/2），0 表示不偏移
+    float ax, ay;                // 加速度
+    float r, g, b, a;            // 颜色
+    float colorJitter;           // 每通道乘以 [1 - colorJitter, 1) 的随机数，0 表示统一颜色
+    float sizeMin, sizeMax;      // 大小在 [sizeMin, sizeMax) 均匀分布
+    float lifeMin, lifeMax;      // 寿命在 [lifeMin, lifeMax) 均匀分布
+    float alphaScale;
+    float sizeDecay;             // 每秒尺寸缩放系数（见 Particle::sizeDecay）
+    int type;
+} ParticleEmitter;
+
+// 圆形爆发：方向在全周均匀分布，速度在 [speedMin, speedMax)
+int particle_emit_burst(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                        float speedMin, float speedMax, int count, ParticleRandom *rng);
+
+// 锥形：方向在 direction ± spread/2（弧度）内均匀分布
+int particle_emit_cone(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                       float direction, float spread, float speedMin, float speedMax,
+                       int count, ParticleRandom *rng);
+
+// 抖动点：速度在 [vxMin, vxMax) x [vyMin, vyMax) 的矩形内均匀分布（尾迹等）
+int particle_emit_jitter(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                         float vxMin, float vxMax, float vyMin, float vyMax,
+                         int count, ParticleRandom *rng);
+
+// 文字点云：位置和方向整列拷贝自 cloud 的前 count 个点（按 scale 缩放后平移到发射点），
+// 速度大小在 [speedMin, speedMax)，大小再乘以点的权重。jitter 不使用。
+int particle_emit_cloud(ParticleSpawnBuffer *buffer, const ParticleEmitter *emitter,
+                        const GlyphCloud *cloud, float scale, float speedMin, float speedMax,
+                        int count, ParticleRandom *rng);
+
+// 批量 sin/cos 近似（SIMD），|angle| <= 1000 时最大绝对误差 < 3e-7
+void particle_sincos(const float *angles, float *sines, float *cosines, int count);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_EMITTER_H
@@ -0,0 +1,172 @@
+#include "particle_forces.h"
+
+#include <cmath>
+#include <cstring>
+
+// 碰撞内核需要向量开方和除法：AArch64 NEON 或 SSE，其余平台（含 32 位 ARM）用标量循环
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define PARTICLE_FORCES_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLE_FORCES_SSE 1
+#endif
+
+#define ATTRACTOR_SOFTENING 1e-4f   // 中心附近方向的软化（d² 的下限），避免除零
+
+void particle_attract_range(ParticlePool *pool, const ParticleAttractor *attractors, int attractorCount,
+                            int begin, int end, float dt) {
+    const float *x = pool->x, *y = pool->y;
+    float *vx = pool->vx, *vy = pool->vy;
+    // 吸引点在外层循环：内层对连续的列做同样的运算，没有分支，编译器可以向量化
+    for (int a = 0; a < attractorCount; a++) {
+        const ParticleAttractor attractor = attractors[a];
+        const float invRadius2 = 1.0f / (attractor.radius * attractor.radius);
+        const float strength = attractor.strength * dt;
+        for (int i = begin; i < end; i++) {
+            const float dx = attractor.x - x[i], dy = attractor.y - y[i];
+            const float d2 = dx * dx + dy * dy;
+            float w = 1.0f - d2 * invRadius2;
+            w = w > 0.0f ? w * w : 0.0f;   // 半径外为 0
+            const float k = strength * w / sqrtf(d2 + ATTRACTOR_SOFTENING);
+            vx[i] += dx * k;
+            vy[i] += dy * k;
+        }
+    }
+}
+
+// 一个格的碰撞候选：相邻 3x3 格的粒子位置，同一行相邻的三格在排序后的数组里连续，按行整段拷贝。
+// 每行最多取 PARTICLE_MAX_NEIGHBORS 个，密集处每个粒子的代价有上界（按固定顺序，与线程数无关）；
+// 本行的窗口以这个格的起点为中心，先取离它最近的粒子
+struct Candidates {
+    float x[3 * PARTICLE_MAX_NEIGHBORS + 4];
+    float y[3 * PARTICLE_MAX_NEIGHBORS + 4];
+    int count;    // 补齐到 4 的倍数，补的位置放在远处，权重为 0
+};
+
+#define CANDIDATE_FAR 1e18f
+
+static void append_row(const ParticleGrid *grid, int begin, int end, Candidates *out) {
+    end = end - begin > PARTICLE_MAX_NEIGHBORS ? begin + PARTICLE_MAX_NEIGHBORS : end;
+    memcpy(out->x + out->count, grid->sortedX + begin, (size_t) (end - begin) * sizeof(float));
+    memcpy(out->y + out->count, grid->sortedY + begin, (size_t) (end - begin) * sizeof(float));
+    out->count += end - begin;
+}
+
+static void gather_candidates(const ParticleGrid *grid, int cell, Candidates *out) {
+    const int32_t *cellStart = grid->cellStart;
+    const int cols = grid->cols;
+    const int row = cell / cols, col = cell - row * cols;
+    const int col0 = col > 0 ? col - 1 : 0, col1 = col < cols - 1 ? col + 1 : col;
+    out->count = 0;
+    int begin = cellStart[row * cols + col0];
+    begin = cellStart[cell] - PARTICLE_MAX_NEIGHBORS / 2 > begin ? cellStart[cell] - PARTICLE_MAX_NEIGHBORS / 2 : begin;
+    append_row(grid, begin, cellStart[row * cols + col1 + 1], out);
+    if (row > 0) {
+        append_row(grid, cellStart[(row - 1) * cols + col0], cellStart[(row - 1) * cols + col1 + 1], out);
+    }
+    if (row < grid->rows - 1) {
+        append_row(grid, cellStart[(row + 1) * cols + col0], cellStart[(row + 1) * cols + col1 + 1], out);
+    }
+    while (out->count & 3) {
+        out->x[out->count] = CANDIDATE_FAR;
+        out->y[out->count] = CANDIDATE_FAR;
+        out->count++;
+    }
+}
+
+// (xi, yi) 受候选粒子的排斥加速度之和（已乘 dt）。
+// (R - d) / R * stiffness，方向 (dx, dy) / d，即 stiffness / R * (R / d - 1) * (dx, dy)；
+// 距离外、自己和完全重合的粒子权重为 0，没有分支
+static void collide_candidates(const Candidates *c, float xi, float yi, float radius, float scale,
+                               float *outX, float *outY) {
+    const float radius2 = radius * radius;
+#if defined(PARTICLE_FORCES_NEON)
+    const float32x4_t vxi = vdupq_n_f32(xi), vyi = vdupq_n_f32(yi);
+    const float32x4_t vr = vdupq_n_f32(radius), vr2 = vdupq_n_f32(radius2), vscale = vdupq_n_f32(scale);
+    const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f), tiny = vdupq_n_f32(1e-20f);
+    float32x4_t fx = zero, fy = zero;
+    for (int q = 0; q < c->count; q += 4) {
+        float32x4_t dx = vsubq_f32(vxi, vld1q_f32(c->x + q));
+        float32x4_t dy = vsubq_f32(vyi, vld1q_f32(c->y + q));
+        float32x4_t d2 = vmlaq_f32(vmulq_f32(dx, dx), dy, dy);
+        float32x4_t push = vmulq_f32(vscale, vsubq_f32(vdivq_f32(vr, vsqrtq_f32(vmaxq_f32(d2, tiny))), one));
+        uint32x4_t inside = vandq_u32(vcltq_f32(d2, vr2), vcgtq_f32(d2, zero));
+        float32x4_t w = vbslq_f32(inside, push, zero);
+        fx = vmlaq_f32(fx, dx, w);
+        fy = vmlaq_f32(fy, dy, w);
+    }
+    *outX = vaddvq_f32(fx);
+    *outY = vaddvq_f32(fy);
+#elif defined(PARTICLE_FORCES_SSE)
+    const __m128 vxi = _mm_set1_ps(xi), vyi = _mm_set1_ps(yi);
+    const __m128 vr = _mm_set1_ps(radius), vr2 = _mm_set1_ps(radius2), vscale = _mm_set1_ps(scale);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), tiny = _mm_set1_ps(1e-20f);
+    __m128 fx = zero, fy = zero;
+    for (int q = 0; q < c->count; q += 4) {
+        __m128 dx = _mm_sub_ps(vxi, _mm_loadu_ps(c->x + q));
+        __m128 dy = _mm_sub_ps(vyi, _mm_loadu_ps(c->y + q));
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 push = _mm_mul_ps(vscale, _mm_sub_ps(_mm_div_ps(vr, _mm_sqrt_ps(_mm_max_ps(d2, tiny))), one));
+        __m128 inside = _mm_and_ps(_mm_cmplt_ps(d2, vr2), _mm_cmpgt_ps(d2, zero));
+        __m128 w = _mm_and_ps(inside, push);
+        fx = _mm_add_ps(fx, _mm_mul_ps(dx, w));
+        fy = _mm_add_ps(fy, _mm_mul_ps(dy, w));
+    }
+    float lanesX[4], lanesY[4];
+    _mm_storeu_ps(lanesX, fx);
+    _mm_storeu_ps(lanesY, fy);
+    *outX = (lanesX[0] + lanesX[1]) + (lanesX[2] + lanesX[3]);
+    *outY = (lanesY[0] + lanesY[1]) + (lanesY[2] + lanesY[3]);
+#else
+    float fx = 0.0f, fy = 0.0f;
+    for (int q = 0; q < c->count; q++) {
+        const float dx = xi - c->x[q], dy = yi - c->y[q];
+        const float d2 = dx * dx + dy * dy;
+        const float push = scale * (radius / sqrtf(d2 > 1e-20f ? d2 : 1e-20f) - 1.0f);
+        const float w = d2 < radius2 && d2 > 0.0f ? push : 0.0f;
+        fx += dx * w;
+        fy += dy * w;
+    }
+    *outX = fx;
+    *outY = fy;
+#endif
+}
+
+void particle_collide_range(ParticlePool *pool, const ParticleGrid *grid, const ParticleCollision *params,
+                            int begin, int end, float dt) {
+    float *vx = pool->vx, *vy = pool->vy;
+    const int32_t *indices = grid->indices;
+    const float radius = params->radius;
+    const float scale = params->stiffness / radius * dt;
+    // 同一格的粒子共用一份候选，逐格收集一次
+    Candidates candidates;
+    int cachedCell = -1;
+    for (int k = begin; k < end; k++) {
+        const int i = indices[k];
+        const int cell = grid->cellOf[i];
+        if (cell != cachedCell) {
+            gather_candidates(grid, cell, &candidates);
+            cachedCell = cell;
+        }
+        float fx, fy;
+        collide_candidates(&candidates, grid->sortedX[k], grid->sortedY[k], radius, scale, &fx, &fy);
+        vx[i] += fx;
+        vy[i] += fy;
+    }
+}
+
+void particle_bounce_range(ParticlePool *pool, const ParticleBounds *bounds, int begin, int end) {
+    float *x = pool->x, *y = pool->y, *vx = pool->vx, *vy = pool->vy;
+    const float left = bounds->left, right = bounds->right, bottom = bounds->bottom;
+    const float restitution = bounds->restitution;
+    for (int i = begin; i < end; i++) {
+        // 越界时镜像位置并反转法向速度；没越界时各项都取原值（选择而非分支）
+        const float xi = x[i], yi = y[i];
+        const int outLeft = xi < left, outRight = xi > right, outBottom = yi < bottom;
+        x[i] = outLeft ? 2.0f * left - xi : (outRight ? 2.0f * right - xi : xi);
+        y[i] = outBottom ? 2.0f * bottom - yi : yi;
+        vx[i] = (outLeft | outRight) ? -vx[i] * restitution : vx[i];
+        vy[i] = outBottom ? -vy[i] * restitution : vy[i];
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_FORCES_H
+#define NATIVE_ACTIVITY_PARTICLE_FORCES_H
+
+#include "particle_grid.h"
+#include "particle_pool.h"
+
+// ---------- 粒子间与外部的力 ----------
+// 在积分之前按分块并行执行：每个粒子只读位置（任何粒子的）、只写自己的速度，
+// 各块写入互不重叠，结果与线程数无关。
+
+#define PARTICLE_MAX_ATTRACTORS 8
+#define PARTICLE_MAX_NEIGHBORS  32  // 碰撞时相邻 3x3 格的每一行最多检查的粒子数
+
+// 吸引/排斥点：半径内的粒子获得指向中心（strength < 0 时背离中心）的加速度，
+// 大小按 (1 - d²/r²)² 从中心的 |strength| 平滑衰减到半径处的 0
+typedef struct ParticleAttractor {
+    float x, y;
+    float radius;
+    float strength;   // 世界单位/秒²
+} ParticleAttractor;
+
+// 对 [begin, end) 区间的粒子施加全部吸引点的力（逐粒子遍历吸引点，不需要网格）
+void particle_attract_range(ParticlePool *pool, const ParticleAttractor *attractors, int attractorCount,
+                            int begin, int end, float dt);
+
+// 火花碰撞：距离小于 radius 的两个粒子按重叠比例互相推开（软球），完全重叠时加速度为 stiffness，
+// 密集处每行只看 PARTICLE_MAX_NEIGHBORS 个粒子
+typedef struct ParticleCollision {
+    float radius;      // 网格格子须不小于 radius
+    float stiffness;
+} ParticleCollision;
+
+// 对网格排序后的第 [begin, end) 个粒子（0..grid->count）施加碰撞力。按格的顺序处理，
+// 相邻粒子查询的是同一片格子，缓存命中好；每个粒子只出现一次，写入互不重叠
+void particle_collide_range(ParticlePool *pool, const ParticleGrid *grid, const ParticleCollision *params,
+                            int begin, int end, float dt);
+
+// 屏幕边缘反弹：越过左右边缘或底部的粒子镜像回来，法向速度按 restitution 反向。顶部不反弹（火箭要飞出顶部爆炸）
+typedef struct ParticleBounds {
+    float left, right, bottom;
+    float restitution;
+} ParticleBounds;
+
+void particle_bounce_range(ParticlePool *pool, const ParticleBounds *bounds, int begin, int end);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_FORCES_H
@@ -0,0 +1,108 @@
+#include "particle_grid.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+void particle_grid_free(ParticleGrid *grid) {
+    free(grid->cellStart);
+    free(grid->indices);
+    free(grid->cellOf);
+    free(grid->sortedX);
+    free(grid->sortedY);
+    memset(grid, 0, sizeof(*grid));
+}
+
+static int reserve(ParticleGrid *grid, int cells, int particles) {
+    if (cells + 1 > grid->cellCapacity) {
+        auto *cellStart = (int32_t *) realloc(grid->cellStart, (size_t) (cells + 1) * sizeof(int32_t));
+        if (cellStart == nullptr) {
+            return -1;
+        }
+        grid->cellStart = cellStart;
+        grid->cellCapacity = cells + 1;
+    }
+    if (particles > grid->particleCapacity) {
+        auto *indices = (int32_t *) realloc(grid->indices, (size_t) particles * sizeof(int32_t));
+        if (indices != nullptr) {
+            grid->indices = indices;
+        }
+        auto *cellOf = (int32_t *) realloc(grid->cellOf, (size_t) particles * sizeof(int32_t));
+        if (cellOf != nullptr) {
+            grid->cellOf = cellOf;
+        }
+        auto *sortedX = (float *) realloc(grid->sortedX, (size_t) particles * sizeof(float));
+        if (sortedX != nullptr) {
+            grid->sortedX = sortedX;
+        }
+        auto *sortedY = (float *) realloc(grid->sortedY, (size_t) particles * sizeof(float));
+        if (sortedY != nullptr) {
+            grid->sortedY = sortedY;
+        }
+        if (indices == nullptr || cellOf == nullptr || sortedX == nullptr || sortedY == nullptr) {
+            return -1;
+        }
+        grid->particleCapacity = particles;
+    }
+    return 0;
+}
+
+int particle_grid_build(ParticleGrid *grid, const ParticlePool *pool, float left, float bottom,
+                        float right, float top, float cellSize, uint32_t typeMask) {
+    float width = right - left, height = top - bottom;
+    // 格数超过上限时按面积比例放大格子
+    float cells = ceilf(width / cellSize) * ceilf(height / cellSize);
+    if (cells > (float) PARTICLE_GRID_MAX_CELLS) {
+        cellSize *= sqrtf(cells / (float) PARTICLE_GRID_MAX_CELLS) * 1.01f;
+    }
+    int cols = (int) ceilf(width / cellSize);
+    int rows = (int) ceilf(height / cellSize);
+    cols = cols > 0 ? cols : 1;
+    rows = rows > 0 ? rows : 1;
+    const int count = pool->count;
+    if (reserve(grid, cols * rows, pool->capacity > count ? pool->capacity : count) != 0) {
+        grid->count = 0;
+        return -1;
+    }
+    grid->left = left;
+    grid->bottom = bottom;
+    grid->cellSize = cellSize;
+    grid->cellsPerUnit = 1.0f / cellSize;
+    grid->cols = cols;
+    grid->rows = rows;
+
+    // 第一遍：所在格与各格计数（计数先放在 cellStart[c + 1]）
+    int32_t *cellStart = grid->cellStart;
+    int32_t *cellOf = grid->cellOf;
+    memset(cellStart, 0, (size_t) (cols * rows + 1) * sizeof(int32_t));
+    const float *x = pool->x, *y = pool->y;
+    const int32_t *type = pool->type;
+    for (int i = 0; i < count; i++) {
+        int cell = particle_grid_row(grid, y[i]) * cols + particle_grid_col(grid, x[i]);
+        int included = ((typeMask >> type[i]) & 1) & (x[i] >= left) & (x[i] <= right) & (y[i] >= bottom) &
+                       (y[i] <= top);
+        cellOf[i] = included ? cell : -1;
+        cellStart[cell + 1] += included;
+    }
+    // 前缀和：cellStart[c] 为第 c 格的起点
+    for (int c = 0; c < cols * rows; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    // 第二遍：按下标顺序散列，用 cellStart[c] 作写指针，结束后它指向第 c 格的终点（即 c + 1 格的起点），
+    // 整体后移一位恢复
+    int32_t *indices = grid->indices;
+    float *sortedX = grid->sortedX, *sortedY = grid->sortedY;
+    for (int i = 0; i < count; i++) {
+        int cell = cellOf[i];
+        if (cell >= 0) {
+            int k = cellStart[cell]++;
+            indices[k] = i;
+            sortedX[k] = x[i];
+            sortedY[k] = y[i];
+        }
+    }
+    memmove(cellStart + 1, cellStart, (size_t) (cols * rows) * sizeof(int32_t));
+    cellStart[0] = 0;
+    grid->count = cellStart[cols * rows];
+    return 0;
+}
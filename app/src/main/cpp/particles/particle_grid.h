@@ -0,0 +1,50 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_GRID_H
+#define NATIVE_ACTIVITY_PARTICLE_GRID_H
+
+#include <stdint.h>
+
+#include "particle_pool.h"
+
+// ---------- 均匀网格 ----------
+// 每步按当前位置整体重建（计数排序，两遍线性扫描，没有逐粒子的分配和链表）：
+//   1. 算出每个粒子所在的格并统计各格粒子数
+//   2. 前缀和得到各格起点，再按粒子下标顺序散列到 indices
+// 散列时顺带把位置按格的顺序拷一份，查询相邻格时是连续内存。
+// 格内粒子按下标升序，结果只取决于粒子池的内容。格子边长不小于查询半径时，
+// 近邻只需要看相邻的 3x3 格。网格范围外的粒子不收录（屏幕外的粒子不参与碰撞，
+// 也不会全部堆进边缘格拖慢查询）。
+
+#define PARTICLE_GRID_MAX_CELLS 65536  // 格数上限，超过时放大格子
+
+typedef struct ParticleGrid {
+    float left, bottom;       // 网格左下角（世界坐标）
+    float cellSize;
+    float cellsPerUnit;       // 1 / cellSize
+    int cols, rows;
+    int32_t *cellStart;       // cols * rows + 1 项，第 c 格的粒子为 indices[cellStart[c], cellStart[c + 1])
+    int32_t *indices;         // 按格排序的粒子下标
+    float *sortedX, *sortedY; // 按同样顺序排列的位置副本，近邻查询顺序读取，不按下标跳着访问粒子池
+    int32_t *cellOf;          // 每个粒子所在的格，未收录（类型不符或在范围外）为 -1
+    int cellCapacity;
+    int particleCapacity;
+    int count;                // 收录的粒子数
+} ParticleGrid;
+
+void particle_grid_free(ParticleGrid *grid);
+
+// 在 [left, right] x [bottom, top] 上以边长 cellSize 重建网格，只收录范围内、typeMask 中的类型（位 1 << type）。
+// 成功返回 0，内存不足返回 -1
+int particle_grid_build(ParticleGrid *grid, const ParticlePool *pool, float left, float bottom,
+                        float right, float top, float cellSize, uint32_t typeMask);
+
+static inline int particle_grid_col(const ParticleGrid *grid, float x) {
+    int col = (int) ((x - grid->left) * grid->cellsPerUnit);
+    return col < 0 ? 0 : (col >= grid->cols ? grid->cols - 1 : col);
+}
+
+static inline int particle_grid_row(const ParticleGrid *grid, float y) {
+    int row = (int) ((y - grid->bottom) * grid->cellsPerUnit);
+    return row < 0 ? 0 : (row >= grid->rows ? grid->rows - 1 : row);
+}
+
+#endif //NATIVE_ACTIVITY_PARTICLE_GRID_H
@@ -0,0 +1,194 @@
+#include "particle_pack.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLE_PACK_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLE_PACK_SSE2 1
+#endif
+
+// 半精度最大有限值，以及把单精度指数偏移 127 改成半精度 15 的系数 2^-112。
+// 乘以 2^-112 后单精度的位模式右移 13 位就是半精度（含非规格化数）。
+#define HALF_MAX      65504.0f
+#define HALF_REBIAS   1.92592994e-34f
+#define SIZE_MAX_PX   (65535.0f / PARTICLE_SIZE_SCALE)
+#define MOTION_MAX    127.0f
+
+uint16_t particle_float_to_half(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    float magnitude = fabsf(value);
+    if (!(magnitude <= HALF_MAX)) {
+        magnitude = HALF_MAX;
+    }
+    float scaled = magnitude * HALF_REBIAS;
+    uint32_t scaledBits;
+    memcpy(&scaledBits, &scaled, sizeof(scaledBits));
+    return (uint16_t) (sign | ((scaledBits + 0x1000u) >> 13));
+}
+
+static uint8_t pack_unorm8(float value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return (uint8_t) (value * 255.0f + 0.5f);
+}
+
+static uint16_t pack_size(float value) {
+    value = value < 0.0f ? 0.0f : (value > SIZE_MAX_PX ? SIZE_MAX_PX : value);
+    return (uint16_t) (value * PARTICLE_SIZE_SCALE + 0.5f);
+}
+
+// 向零截断，与 SIMD 路径的截断转换一致
+static int8_t pack_motion(float delta) {
+    float value = delta * PARTICLE_MOTION_SCALE;
+    value = value < -MOTION_MAX ? -MOTION_MAX : (value > MOTION_MAX ? MOTION_MAX : value);
+    return (int8_t) value;
+}
+
+void particle_pack_vertex(float x, float y, float r, float g, float b, float a, float size, ParticleVertex *out) {
+    out->x = particle_float_to_half(x);
+    out->y = particle_float_to_half(y);
+    out->r = pack_unorm8(r);
+    out->g = pack_unorm8(g);
+    out->b = pack_unorm8(b);
+    out->a = pack_unorm8(a);
+    out->size = pack_size(size);
+    out->mx = 0;
+    out->my = 0;
+}
+
+static void pack_scalar(const ParticlePool *pool, int begin, int end, float alpha, ParticleVertex *out) {
+    for (int i = begin; i < end; i++) {
+        ParticleVertex *v = &out[i];
+        v->x = particle_float_to_half(pool->px[i] + (pool->x[i] - pool->px[i]) * alpha);
+        v->y = particle_float_to_half(pool->py[i] + (pool->y[i] - pool->py[i]) * alpha);
+        v->r = pack_unorm8(pool->r[i]);
+        v->g = pack_unorm8(pool->g[i]);
+        v->b = pack_unorm8(pool->b[i]);
+        v->a = pack_unorm8(pool->a[i]);
+        v->size = pack_size(pool->size[i]);
+        v->mx = pack_motion(pool->x[i] - pool->px[i]);
+        v->my = pack_motion(pool->y[i] - pool->py[i]);
+    }
+}
+
+#if defined(PARTICLE_PACK_NEON)
+
+static inline uint32x4_t half_bits(float32x4_t v) {
+    uint32x4_t sign = vshrq_n_u32(vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000u)), 16);
+    float32x4_t magnitude = vminq_f32(vabsq_f32(v), vdupq_n_f32(HALF_MAX));
+    uint32x4_t scaled = vreinterpretq_u32_f32(vmulq_f32(magnitude, vdupq_n_f32(HALF_REBIAS)));
+    return vorrq_u32(sign, vshrq_n_u32(vaddq_u32(scaled, vdupq_n_u32(0x1000u)), 13));
+}
+
+static inline uint32x4_t unorm8(float32x4_t v) {
+    v = vmaxq_f32(vminq_f32(v, vdupq_n_f32(1.0f)), vdupq_n_f32(0.0f));
+    return vcvtq_u32_f32(vmlaq_f32(vdupq_n_f32(0.5f), v, vdupq_n_f32(255.0f)));
+}
+
+// 位移量化成 8 位有符号数，放在字的低 8 位（截断转换，补码取低 8 位）
+static inline uint32x4_t motion8(float32x4_t delta) {
+    float32x4_t v = vmulq_f32(delta, vdupq_n_f32(PARTICLE_MOTION_SCALE));
+    v = vmaxq_f32(vminq_f32(v, vdupq_n_f32(MOTION_MAX)), vdupq_n_f32(-MOTION_MAX));
+    return vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(v)), vdupq_n_u32(0xffu));
+}
+
+static int pack_simd(const ParticlePool *pool, int begin, int end, float alpha, ParticleVertex *out) {
+    int i = begin;
+    const float32x4_t t = vdupq_n_f32(alpha);
+    for (; i + 4 <= end; i += 4) {
+        float32x4_t px = vld1q_f32(pool->px + i), py = vld1q_f32(pool->py + i);
+        float32x4_t dx = vsubq_f32(vld1q_f32(pool->x + i), px);
+        float32x4_t dy = vsubq_f32(vld1q_f32(pool->y + i), py);
+        float32x4_t x = vmlaq_f32(px, dx, t);
+        float32x4_t y = vmlaq_f32(py, dy, t);
+        uint32x4x3_t words;
+        words.val[0] = vorrq_u32(half_bits(x), vshlq_n_u32(half_bits(y), 16));
+        words.val[1] = vorrq_u32(vorrq_u32(unorm8(vld1q_f32(pool->r + i)),
+                                           vshlq_n_u32(unorm8(vld1q_f32(pool->g + i)), 8)),
+                                 vorrq_u32(vshlq_n_u32(unorm8(vld1q_f32(pool->b + i)), 16),
+                                           vshlq_n_u32(unorm8(vld1q_f32(pool->a + i)), 24)));
+        float32x4_t size = vmaxq_f32(vminq_f32(vld1q_f32(pool->size + i), vdupq_n_f32(SIZE_MAX_PX)),
+                                     vdupq_n_f32(0.0f));
+        uint32x4_t motion = vorrq_u32(motion8(dx), vshlq_n_u32(motion8(dy), 8));
+        words.val[2] = vorrq_u32(vcvtq_u32_f32(vmlaq_f32(vdupq_n_f32(0.5f), size, vdupq_n_f32(PARTICLE_SIZE_SCALE))),
+                                 vshlq_n_u32(motion, 16));
+        // 三路交错写出：每个粒子依次是 位置、颜色、大小和运动 三个 32 位字
+        vst3q_u32((uint32_t *) (out + i), words);
+    }
+    return i;
+}
+
+#elif defined(PARTICLE_PACK_SSE2)
+
+static inline __m128i half_bits(__m128 v) {
+    const __m128i signMask = _mm_set1_epi32((int) 0x80000000u);
+    __m128i sign = _mm_srli_epi32(_mm_and_si128(_mm_castps_si128(v), signMask), 16);
+    __m128 magnitude = _mm_min_ps(_mm_andnot_ps(_mm_castsi128_ps(signMask), v), _mm_set1_ps(HALF_MAX));
+    __m128i scaled = _mm_castps_si128(_mm_mul_ps(magnitude, _mm_set1_ps(HALF_REBIAS)));
+    return _mm_or_si128(sign, _mm_srli_epi32(_mm_add_epi32(scaled, _mm_set1_epi32(0x1000)), 13));
+}
+
+static inline __m128i unorm8(__m128 v) {
+    v = _mm_max_ps(_mm_min_ps(v, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+}
+
+// 位移量化成 8 位有符号数，放在字的低 8 位（截断转换，补码取低 8 位）
+static inline __m128i motion8(__m128 delta) {
+    __m128 v = _mm_mul_ps(delta, _mm_set1_ps(PARTICLE_MOTION_SCALE));
+    v = _mm_max_ps(_mm_min_ps(v, _mm_set1_ps(MOTION_MAX)), _mm_set1_ps(-MOTION_MAX));
+    return _mm_and_si128(_mm_cvttps_epi32(v), _mm_set1_epi32(0xff));
+}
+
+static int pack_simd(const ParticlePool *pool, int begin, int end, float alpha, ParticleVertex *out) {
+    int i = begin;
+    alignas(16) uint32_t words[3][4];
+    const __m128 t = _mm_set1_ps(alpha);
+    for (; i + 4 <= end; i += 4) {
+        __m128 px = _mm_loadu_ps(pool->px + i), py = _mm_loadu_ps(pool->py + i);
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(pool->x + i), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(pool->y + i), py);
+        __m128 x = _mm_add_ps(px, _mm_mul_ps(dx, t));
+        __m128 y = _mm_add_ps(py, _mm_mul_ps(dy, t));
+        __m128i position = _mm_or_si128(half_bits(x), _mm_slli_epi32(half_bits(y), 16));
+        __m128i color = _mm_or_si128(_mm_or_si128(unorm8(_mm_loadu_ps(pool->r + i)),
+                                                  _mm_slli_epi32(unorm8(_mm_loadu_ps(pool->g + i)), 8)),
+                                     _mm_or_si128(_mm_slli_epi32(unorm8(_mm_loadu_ps(pool->b + i)), 16),
+                                                  _mm_slli_epi32(unorm8(_mm_loadu_ps(pool->a + i)), 24)));
+        __m128 size = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(pool->size + i), _mm_set1_ps(SIZE_MAX_PX)),
+                                 _mm_setzero_ps());
+        __m128i fixed = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(size, _mm_set1_ps(PARTICLE_SIZE_SCALE)),
+                                                    _mm_set1_ps(0.5f)));
+        __m128i motion = _mm_or_si128(motion8(dx), _mm_slli_epi32(motion8(dy), 8));
+        fixed = _mm_or_si128(fixed, _mm_slli_epi32(motion, 16));
+        _mm_store_si128((__m128i *) words[0], position);
+        _mm_store_si128((__m128i *) words[1], color);
+        _mm_store_si128((__m128i *) words[2], fixed);
+        // SSE2 没有三路交错存储，逐个粒子写出三个 32 位字
+        uint32_t *dst = (uint32_t *) (out + i);
+        for (int k = 0; k < 4; k++) {
+            dst[k * 3 + 0] = words[0][k];
+            dst[k * 3 + 1] = words[1][k];
+            dst[k * 3 + 2] = words[2][k];
+        }
+    }
+    return i;
+}
+
+#else
+
+static int pack_simd(const ParticlePool *, int begin, int, float, ParticleVertex *) {
+    return begin;
+}
+
+#endif
+
+void particle_pack_range(const ParticlePool *pool, int begin, int end, float alpha, ParticleVertex *out) {
+    int done = pack_simd(pool, begin, end, alpha, out);
+    pack_scalar(pool, done, end, alpha, out);
+}
@@ -0,0 +1,34 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_PACK_H
+#define NATIVE_ACTIVITY_PARTICLE_PACK_H
+
+#include <stdint.h>
+
+#include "particle_pool.h"
+
+// ---------- 压缩的粒子顶点（12 字节）----------
+// 位置：两个半精度浮点（GL_HALF_FLOAT）
+// 颜色：RGBA8 归一化（GL_UNSIGNED_BYTE, normalized）
+// 大小：16 位无符号定点，单位 1/PARTICLE_SIZE_SCALE 像素（GL_UNSIGNED_SHORT，着色器里乘回）
+// 运动：最近一步的位移 x - px、y - py，两个 8 位有符号定点，单位 1/PARTICLE_MOTION_SCALE 世界单位
+//      （GL_BYTE，四边形路径沿运动方向拉伸；点精灵路径不读取）
+#define PARTICLE_SIZE_SCALE 16.0f
+#define PARTICLE_MOTION_SCALE 4096.0f  // 每步最多约 0.031（60 Hz 下约 1.9 单位/秒），超出截断
+
+typedef struct ParticleVertex {
+    uint16_t x, y;
+    uint8_t r, g, b, a;
+    uint16_t size;
+    int8_t mx, my;       // 同时保持 4 字节对齐
+} ParticleVertex;
+
+// 把 [begin, end) 区间的粒子打包成顶点，第 i 个粒子写到 out[i]。
+// 位置在上一步与当前步之间插值：px + (x - px) * alpha，alpha ∈ [0, 1]
+void particle_pack_range(const ParticlePool *pool, int begin, int end, float alpha, ParticleVertex *out);
+
+// 打包单个顶点（剔除阶段的聚合点等不在粒子池里的顶点）
+void particle_pack_vertex(float x, float y, float r, float g, float b, float a, float size, ParticleVertex *out);
+
+// 单精度转半精度（截断到 ±65504，就近舍入），供标量路径和校验使用
+uint16_t particle_float_to_half(float value);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_PACK_H
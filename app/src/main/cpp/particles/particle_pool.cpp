@@ -0,0 +1,456 @@
+#include "particle_pool.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLE_USE_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLE_USE_SSE 1
+#endif
+
+// 每列起始地址按缓存行对齐
+#define PARTICLE_COLUMN_ALIGN 64
+
+enum {
+    COLUMN_FLOATS = 16,  // x y px py vx vy ax ay r g b a size life fade shrink
+    COLUMN_INTS = 4,     // type expiryNext expiryPrev expiryBucket
+};
+
+static size_t column_bytes(int capacity, size_t elemSize) {
+    size_t bytes = (size_t)capacity * elemSize;
+    return (bytes + PARTICLE_COLUMN_ALIGN - 1) & ~(size_t)(PARTICLE_COLUMN_ALIGN - 1);
+}
+
+static int round_to_simd(int capacity) {
+    return (capacity + PARTICLE_SIMD_WIDTH - 1) & ~(PARTICLE_SIMD_WIDTH - 1);
+}
+
+int particle_pool_init(ParticlePool *pool, int capacity) {
+    return particle_pool_reserve(pool, capacity, capacity, 0);
+}
+
+int particle_pool_reserve(ParticlePool *pool, int capacity, int maxCapacity, int flags) {
+    memset(pool, 0, sizeof(*pool));
+    if (capacity <= 0 || maxCapacity < capacity) {
+        return -1;
+    }
+    // 容量向上取整到 SIMD 宽度，内核可以整组处理而无需标量尾部
+    capacity = round_to_simd(capacity);
+    maxCapacity = round_to_simd(maxCapacity);
+
+    // 每列按最大容量留出空间；匿名映射本身为 0，只有实际写到的页才占用物理内存
+    size_t floatBytes = column_bytes(maxCapacity, sizeof(float));
+    size_t intBytes = column_bytes(maxCapacity, sizeof(int32_t));
+    size_t total = floatBytes * COLUMN_FLOATS + intBytes * COLUMN_INTS;
+    if (particle_arena_reserve(&pool->arena, total, flags) != 0) {
+        return -1;
+    }
+
+    char *cursor = (char *) pool->arena.base;
+    float **columns[] = {
+        &pool->x, &pool->y, &pool->px, &pool->py, &pool->vx, &pool->vy, &pool->ax, &pool->ay,
+        &pool->r, &pool->g, &pool->b, &pool->a, &pool->size, &pool->life,
+        &pool->fade, &pool->shrink
+    };
+    for (float **column : columns) {
+        *column = (float *) cursor;
+        cursor += floatBytes;
+    }
+    int32_t **intColumns[] = {
+        &pool->type, &pool->expiryNext, &pool->expiryPrev, &pool->expiryBucket
+    };
+    for (int32_t **column : intColumns) {
+        *column = (int32_t *) cursor;
+        cursor += intBytes;
+    }
+
+    pool->capacity = capacity;
+    pool->maxCapacity = maxCapacity;
+    particle_pool_clear(pool);
+    return 0;
+}
+
+void particle_pool_free(ParticlePool *pool) {
+    particle_arena_release(&pool->arena);
+    memset(pool, 0, sizeof(*pool));
+}
+
+int particle_pool_capacity_for_budget(size_t budgetBytes) {
+    size_t capacity = budgetBytes / PARTICLE_POOL_BYTES_PER_PARTICLE;
+    if (capacity > (size_t) INT32_MAX / 2) {
+        capacity = (size_t) INT32_MAX / 2;
+    }
+    return (int) capacity & ~(PARTICLE_SIMD_WIDTH - 1);
+}
+
+int particle_pool_grow(ParticlePool *pool, int capacity) {
+    if (capacity > pool->capacity) {
+        // 至少翻倍，避免逐步扩容的次数随粒子数线性增长
+        int doubled = pool->capacity * 2;
+        capacity = capacity > doubled ? capacity : doubled;
+        capacity = capacity < pool->maxCapacity ? round_to_simd(capacity) : pool->maxCapacity;
+        if (capacity > pool->capacity) {
+            pool->capacity = capacity;
+            pool->grows++;
+        }
+    }
+    return pool->capacity;
+}
+
+void particle_pool_metrics(const ParticlePool *pool, ParticlePoolMetrics *metrics) {
+    metrics->capacity = pool->capacity;
+    metrics->maxCapacity = pool->maxCapacity;
+    metrics->used = pool->count;
+    metrics->evictions = pool->evictions;
+    metrics->grows = pool->grows;
+    metrics->reservedBytes = pool->arena.size;
+    metrics->committedBytes = (size_t) pool->capacity * PARTICLE_POOL_BYTES_PER_PARTICLE;
+    metrics->pages = pool->arena.pages;
+}
+
+void particle_pool_clear(ParticlePool *pool) {
+    pool->count = 0;
+    for (int b = 0; b < PARTICLE_EXPIRY_BUCKETS; b++) {
+        pool->expiryHeads[b] = -1;
+    }
+}
+
+// 复制单个槽位的全部数据列（不含过期索引）
+static void copy_slot(ParticlePool *dst, int i, const ParticlePool *src, int k) {
+    dst->x[i] = src->x[k];
+    dst->y[i] = src->y[k];
+    dst->px[i] = src->px[k];
+    dst->py[i] = src->py[k];
+    dst->vx[i] = src->vx[k];
+    dst->vy[i] = src->vy[k];
+    dst->ax[i] = src->ax[k];
+    dst->ay[i] = src->ay[k];
+    dst->r[i] = src->r[k];
+    dst->g[i] = src->g[k];
+    dst->b[i] = src->b[k];
+    dst->a[i] = src->a[k];
+    dst->size[i] = src->size[k];
+    dst->life[i] = src->life[k];
+    dst->fade[i] = src->fade[k];
+    dst->shrink[i] = src->shrink[k];
+    dst->type[i] = src->type[k];
+}
+
+// ---------- 过期时间桶环 ----------
+
+static int expiry_bucket_of(double time) {
+    return (int) ((int64_t) (time * PARTICLE_EXPIRY_BUCKETS_PER_SEC) & (PARTICLE_EXPIRY_BUCKETS - 1));
+}
+
+static void expiry_link(ParticlePool *pool, int i) {
+    // 环只覆盖有限时间窗口，更长的寿命归入窗口末端的桶
+    const float maxLife = (float) (PARTICLE_EXPIRY_BUCKETS - 2) / PARTICLE_EXPIRY_BUCKETS_PER_SEC;
+    float life = pool->life[i] < maxLife ? pool->life[i] : maxLife;
+    int b = expiry_bucket_of(pool->now + life);
+    int head = pool->expiryHeads[b];
+    pool->expiryBucket[i] = b;
+    pool->expiryPrev[i] = -1;
+    pool->expiryNext[i] = head;
+    if (head >= 0) {
+        pool->expiryPrev[head] = i;
+    }
+    pool->expiryHeads[b] = i;
+}
+
+static void expiry_unlink(ParticlePool *pool, int i) {
+    int prev = pool->expiryPrev[i];
+    int next = pool->expiryNext[i];
+    if (prev >= 0) {
+        pool->expiryNext[prev] = next;
+    } else {
+        pool->expiryHeads[pool->expiryBucket[i]] = next;
+    }
+    if (next >= 0) {
+        pool->expiryPrev[next] = prev;
+    }
+}
+
+// 槽位 from 的粒子搬到槽位 to，修正链表中指向它的邻居
+static void expiry_move(ParticlePool *pool, int from, int to) {
+    int prev = pool->expiryPrev[from];
+    int next = pool->expiryNext[from];
+    if (prev >= 0) {
+        pool->expiryNext[prev] = to;
+    } else {
+        pool->expiryHeads[pool->expiryBucket[from]] = to;
+    }
+    if (next >= 0) {
+        pool->expiryPrev[next] = to;
+    }
+    pool->expiryPrev[to] = prev;
+    pool->expiryNext[to] = next;
+    pool->expiryBucket[to] = pool->expiryBucket[from];
+}
+
+// 从当前时刻的前一个桶开始向后找第一个非空桶（包含本帧刚过期、尚未移除的粒子），
+// 最多扫描固定的 PARTICLE_EXPIRY_BUCKETS 个桶，与粒子数无关
+static int expiry_oldest(const ParticlePool *pool) {
+    int start = expiry_bucket_of(pool->now) + PARTICLE_EXPIRY_BUCKETS - 1;
+    for (int k = 0; k < PARTICLE_EXPIRY_BUCKETS; k++) {
+        int head = pool->expiryHeads[(start + k) & (PARTICLE_EXPIRY_BUCKETS - 1)];
+        if (head >= 0) {
+            return head;
+        }
+    }
+    return 0;
+}
+
+int particle_pool_emit(ParticlePool *pool, const Particle *p) {
+    int i;
+    if (pool->count == pool->capacity) {
+        particle_pool_grow(pool, pool->count + 1);
+    }
+    if (pool->count < pool->capacity) {
+        i = pool->count++;
+    } else {
+        i = expiry_oldest(pool);
+        expiry_unlink(pool, i);
+        pool->evictions++;
+    }
+    particle_pool_store(pool, i, p);
+    expiry_link(pool, i);
+    return i;
+}
+
+void particle_pool_emit_bulk(ParticlePool *pool, const ParticlePool *src) {
+    if (pool->count + src->count > pool->capacity) {
+        particle_pool_grow(pool, pool->count + src->count);
+    }
+    int n = pool->capacity - pool->count;
+    if (n > src->count) {
+        n = src->count;
+    }
+    if (n > 0) {
+        int dst = pool->count;
+        // 新粒子还没有上一步，px/py 直接取 x/y
+        float *dstColumns[] = {
+            pool->x, pool->y, pool->px, pool->py, pool->vx, pool->vy, pool->ax, pool->ay,
+            pool->r, pool->g, pool->b, pool->a, pool->size, pool->life,
+            pool->fade, pool->shrink
+        };
+        const float *srcColumns[] = {
+            src->x, src->y, src->x, src->y, src->vx, src->vy, src->ax, src->ay,
+            src->r, src->g, src->b, src->a, src->size, src->life,
+            src->fade, src->shrink
+        };
+        for (int c = 0; c < COLUMN_FLOATS; c++) {
+            memcpy(dstColumns[c] + dst, srcColumns[c], n * sizeof(float));
+        }
+        memcpy(pool->type + dst, src->type, n * sizeof(int32_t));
+        pool->count += n;
+        for (int i = dst; i < dst + n; i++) {
+            expiry_link(pool, i);
+        }
+    }
+
+    // 空闲槽位不够时逐个替换最早过期的粒子
+    for (int k = n; k < src->count; k++) {
+        int i = expiry_oldest(pool);
+        expiry_unlink(pool, i);
+        pool->evictions++;
+        copy_slot(pool, i, src, k);
+        pool->px[i] = pool->x[i];
+        pool->py[i] = pool->y[i];
+        expiry_link(pool, i);
+    }
+}
+
+void particle_pool_store(ParticlePool *pool, int i, const Particle *p) {
+    pool->x[i] = p->x;
+    pool->y[i] = p->y;
+    pool->px[i] = p->x;
+    pool->py[i] = p->y;
+    pool->vx[i] = p->vx;
+    pool->vy[i] = p->vy;
+    pool->ax[i] = p->ax;
+    pool->ay[i] = p->ay;
+    pool->r[i] = p->r;
+    pool->g[i] = p->g;
+    pool->b[i] = p->b;
+    pool->a[i] = p->a;
+    pool->size[i] = p->size;
+    pool->life[i] = p->life;
+    pool->fade[i] = p->alphaScale / p->maxLife;
+    pool->shrink[i] = logf(p->sizeDecay);
+    pool->type[i] = p->type;
+}
+
+void particle_pool_load(const ParticlePool *pool, int i, Particle *p) {
+    p->x = pool->x[i];
+    p->y = pool->y[i];
+    p->vx = pool->vx[i];
+    p->vy = pool->vy[i];
+    p->ax = pool->ax[i];
+    p->ay = pool->ay[i];
+    p->r = pool->r[i];
+    p->g = pool->g[i];
+    p->b = pool->b[i];
+    p->a = pool->a[i];
+    p->size = pool->size[i];
+    p->life = pool->life[i];
+    p->alphaScale = 1.0f;
+    p->maxLife = 1.0f / pool->fade[i];
+    p->sizeDecay = expf(pool->shrink[i]);
+    p->type = pool->type[i];
+}
+
+void particle_pool_remove(ParticlePool *pool, int i) {
+    int last = --pool->count;
+    expiry_unlink(pool, i);
+    if (i == last) {
+        return;
+    }
+    expiry_move(pool, last, i);
+    copy_slot(pool, i, pool, last);
+}
+
+// ---------- 积分内核 ----------
+
+static void integrate_scalar_range(ParticlePool *pool, int begin, int end, float dt, float fieldX, float fieldY) {
+    float *x = pool->x, *y = pool->y;
+    float *px = pool->px, *py = pool->py;
+    float *vx = pool->vx, *vy = pool->vy;
+    const float *ax = pool->ax, *ay = pool->ay;
+    float *a = pool->a, *size = pool->size, *life = pool->life;
+    const float *fade = pool->fade, *shrink = pool->shrink;
+    for (int i = begin; i < end; i++) {
+        px[i] = x[i];
+        py[i] = y[i];
+        life[i] -= dt;
+        vx[i] += (ax[i] + fieldX) * dt;
+        vy[i] += (ay[i] + fieldY) * dt;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        a[i] = life[i] * fade[i];
+        size[i] *= expf(shrink[i] * dt);
+    }
+}
+
+// exp(x) = 2^n * 2^f，n 为 x*log2(e) 四舍五入，f ∈ [-0.5, 0.5] 用 6 次泰勒多项式，相对误差约 1e-7。
+// shrink 为 0 的粒子（绝大多数）结果精确为 1。
+#define EXP_LOG2E 1.44269504f
+#define EXP_C1 0.693147181f
+#define EXP_C2 0.240226507f
+#define EXP_C3 0.0555041087f
+#define EXP_C4 0.00961812911f
+#define EXP_C5 0.00133335581f
+#define EXP_C6 0.000154035304f
+
+#if defined(PARTICLE_USE_NEON)
+
+static inline float32x4_t exp4(float32x4_t x) {
+    float32x4_t t = vmulq_f32(x, vdupq_n_f32(EXP_LOG2E));
+    t = vmaxq_f32(vminq_f32(t, vdupq_n_f32(126.0f)), vdupq_n_f32(-126.0f));
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(t), vdupq_n_u32(0x80000000u));
+    float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+    int32x4_t n = vcvtq_s32_f32(vaddq_f32(t, half));
+    float32x4_t f = vsubq_f32(t, vcvtq_f32_s32(n));
+    float32x4_t p = vmlaq_f32(vdupq_n_f32(EXP_C5), f, vdupq_n_f32(EXP_C6));
+    p = vmlaq_f32(vdupq_n_f32(EXP_C4), f, p);
+    p = vmlaq_f32(vdupq_n_f32(EXP_C3), f, p);
+    p = vmlaq_f32(vdupq_n_f32(EXP_C2), f, p);
+    p = vmlaq_f32(vdupq_n_f32(EXP_C1), f, p);
+    p = vmlaq_f32(vdupq_n_f32(1.0f), f, p);
+    return vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(p), vshlq_n_s32(n, 23)));
+}
+
+#elif defined(PARTICLE_USE_SSE)
+
+static inline __m128 exp4(__m128 x) {
+    __m128 t = _mm_mul_ps(x, _mm_set1_ps(EXP_LOG2E));
+    t = _mm_max_ps(_mm_min_ps(t, _mm_set1_ps(126.0f)), _mm_set1_ps(-126.0f));
+    __m128i n = _mm_cvtps_epi32(t);  // 默认舍入模式为就近舍入
+    __m128 f = _mm_sub_ps(t, _mm_cvtepi32_ps(n));
+    __m128 p = _mm_add_ps(_mm_set1_ps(EXP_C5), _mm_mul_ps(f, _mm_set1_ps(EXP_C6)));
+    p = _mm_add_ps(_mm_set1_ps(EXP_C4), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(EXP_C3), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(EXP_C2), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(EXP_C1), _mm_mul_ps(f, p));
+    p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, p));
+    return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(p), _mm_slli_epi32(n, 23)));
+}
+
+#endif
+
+void particle_integrate_scalar(ParticlePool *pool, float dt) {
+    integrate_scalar_range(pool, 0, pool->count, dt, 0.0f, 0.0f);
+    pool->now += dt;
+}
+
+void particle_integrate_range(ParticlePool *pool, int begin, int end, float dt) {
+    particle_integrate_field_range(pool, begin, end, dt, 0.0f, 0.0f);
+}
+
+void particle_integrate_field_range(ParticlePool *pool, int begin, int end, float dt, float fieldX, float fieldY) {
+    // 容量按 SIMD 宽度对齐，尾部多出的槽位也一并计算，结果不会被使用
+    end = (end + PARTICLE_SIMD_WIDTH - 1) & ~(PARTICLE_SIMD_WIDTH - 1);
+#if defined(PARTICLE_USE_NEON)
+    float32x4_t vdt = vdupq_n_f32(dt);
+    float32x4_t vfx = vdupq_n_f32(fieldX);
+    float32x4_t vfy = vdupq_n_f32(fieldY);
+    for (int i = begin; i < end; i += 4) {
+        float32x4_t oldX = vld1q_f32(pool->x + i);
+        float32x4_t oldY = vld1q_f32(pool->y + i);
+        float32x4_t life = vsubq_f32(vld1q_f32(pool->life + i), vdt);
+        float32x4_t vx = vmlaq_f32(vld1q_f32(pool->vx + i), vaddq_f32(vld1q_f32(pool->ax + i), vfx), vdt);
+        float32x4_t vy = vmlaq_f32(vld1q_f32(pool->vy + i), vaddq_f32(vld1q_f32(pool->ay + i), vfy), vdt);
+        float32x4_t x = vmlaq_f32(oldX, vx, vdt);
+        float32x4_t y = vmlaq_f32(oldY, vy, vdt);
+        float32x4_t a = vmulq_f32(life, vld1q_f32(pool->fade + i));
+        float32x4_t size = vmulq_f32(vld1q_f32(pool->size + i), exp4(vmulq_f32(vld1q_f32(pool->shrink + i), vdt)));
+        vst1q_f32(pool->px + i, oldX);
+        vst1q_f32(pool->py + i, oldY);
+        vst1q_f32(pool->life + i, life);
+        vst1q_f32(pool->vx + i, vx);
+        vst1q_f32(pool->vy + i, vy);
+        vst1q_f32(pool->x + i, x);
+        vst1q_f32(pool->y + i, y);
+        vst1q_f32(pool->a + i, a);
+        vst1q_f32(pool->size + i, size);
+    }
+#elif defined(PARTICLE_USE_SSE)
+    __m128 vdt = _mm_set1_ps(dt);
+    __m128 vfx = _mm_set1_ps(fieldX);
+    __m128 vfy = _mm_set1_ps(fieldY);
+    for (int i = begin; i < end; i += 4) {
+        __m128 oldX = _mm_load_ps(pool->x + i);
+        __m128 oldY = _mm_load_ps(pool->y + i);
+        __m128 life = _mm_sub_ps(_mm_load_ps(pool->life + i), vdt);
+        __m128 vx = _mm_add_ps(_mm_load_ps(pool->vx + i), _mm_mul_ps(_mm_add_ps(_mm_load_ps(pool->ax + i), vfx), vdt));
+        __m128 vy = _mm_add_ps(_mm_load_ps(pool->vy + i), _mm_mul_ps(_mm_add_ps(_mm_load_ps(pool->ay + i), vfy), vdt));
+        __m128 x = _mm_add_ps(oldX, _mm_mul_ps(vx, vdt));
+        __m128 y = _mm_add_ps(oldY, _mm_mul_ps(vy, vdt));
+        __m128 a = _mm_mul_ps(life, _mm_load_ps(pool->fade + i));
+        __m128 size = _mm_mul_ps(_mm_load_ps(pool->size + i), exp4(_mm_mul_ps(_mm_load_ps(pool->shrink + i), vdt)));
+        _mm_store_ps(pool->px + i, oldX);
+        _mm_store_ps(pool->py + i, oldY);
+        _mm_store_ps(pool->life + i, life);
+        _mm_store_ps(pool->vx + i, vx);
+        _mm_store_ps(pool->vy + i, vy);
+        _mm_store_ps(pool->x + i, x);
+        _mm_store_ps(pool->y + i, y);
+        _mm_store_ps(pool->a + i, a);
+        _mm_store_ps(pool->size + i, size);
+    }
+#else
+    integrate_scalar_range(pool, begin, end, dt, fieldX, fieldY);
+#endif
+}
+
+void particle_pool_advance(ParticlePool *pool, float dt) {
+    pool->now += dt;
+}
+
+void particle_integrate(ParticlePool *pool, float dt) {
+    particle_integrate_range(pool, 0, pool->count, dt);
+    particle_pool_advance(pool, dt);
+}
@@ -0,0 +1,123 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_POOL_H
+#define NATIVE_ACTIVITY_PARTICLE_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "particle_arena.h"
+
+// ---------- 粒子类型 ----------
+enum ParticleType {
+    PARTICLE_ROCKET,
+    PARTICLE_EXPLOSION,
+    PARTICLE_TRAIL,
+    PARTICLE_TEXT
+};
+
+// ---------- 粒子描述（发射时使用的 AoS 结构）----------
+typedef struct Particle {
+    float x, y;          // 位置
+    float vx, vy;        // 速度
+    float ax, ay;        // 加速度
+    float r, g, b, a;    // 颜色
+    float size;          // 大小
+    float life;          // 剩余生命
+    float maxLife;       // 最大生命
+    float alphaScale;    // 透明度系数：a = life / maxLife * alphaScale
+    float sizeDecay;     // 每秒尺寸缩放系数（1 表示不变，0.05 表示一秒后剩 5%），与步长无关
+    int type;            // 粒子类型
+} Particle;
+
+// SIMD 内核每次处理的粒子数，容量按此对齐
+#define PARTICLE_SIMD_WIDTH 4
+
+// 过期时间桶环：每桶 1/32 秒，256 个桶覆盖 8 秒，超过的寿命归入最后一个桶
+#define PARTICLE_EXPIRY_BUCKETS        256
+#define PARTICLE_EXPIRY_BUCKETS_PER_SEC 32
+
+// ---------- 粒子池（SoA 布局）----------
+// 每个字段一个连续数组，积分内核只触碰它需要的列。
+typedef struct ParticlePool {
+    int capacity;        // 当前可用槽位数，满了先扩容，到 maxCapacity 后才替换最早过期的粒子
+    int maxCapacity;     // 保留的地址空间能容纳的槽位数
+    int count;
+    float *x, *y;
+    float *px, *py;      // 上一步的位置，渲染时在两步之间插值
+    float *vx, *vy;
+    float *ax, *ay;
+    float *r, *g, *b, *a;
+    float *size;
+    float *life;
+    float *fade;         // alphaScale / maxLife，积分时 a = life * fade
+    float *shrink;       // ln(sizeDecay)，积分时 size *= exp(shrink * dt)
+    int32_t *type;
+
+    // 按过期时间分桶的双向链表，满池时 O(1) 找到最早过期的粒子
+    int32_t *expiryNext;
+    int32_t *expiryPrev;
+    int32_t *expiryBucket;
+    int32_t expiryHeads[PARTICLE_EXPIRY_BUCKETS];
+    double now;          // 粒子池时钟，随积分推进
+    int evictions;       // 因池满而被替换的粒子数
+    int grows;           // 扩容次数
+
+    ParticleArena arena; // 所有列共用的内存区，每列按 maxCapacity 留出连续空间
+} ParticlePool;
+
+// 每个粒子占用的字节数（全部数据列和过期索引列）
+#define PARTICLE_POOL_BYTES_PER_PARTICLE (16 * sizeof(float) + 4 * sizeof(int32_t))
+
+// 粒子池指标
+typedef struct ParticlePoolMetrics {
+    int capacity;
+    int maxCapacity;
+    int used;
+    int evictions;
+    int grows;
+    size_t reservedBytes;   // 保留的地址空间
+    size_t committedBytes;  // 当前容量对应的字节数（物理页只会在这个范围内被写入）
+    int pages;              // ParticleArenaPages
+} ParticlePoolMetrics;
+
+// 分配容量为 capacity 的粒子池（不扩容），成功返回 0，失败返回 -1
+int particle_pool_init(ParticlePool *pool, int capacity);
+// 保留 maxCapacity 个槽位的地址空间，初始可用 capacity 个，需要时按倍数扩容到 maxCapacity。
+// flags 传给 particle_arena_reserve（PARTICLE_ARENA_HUGE_PAGES）。
+int particle_pool_reserve(ParticlePool *pool, int capacity, int maxCapacity, int flags);
+// 预算 budgetBytes 能容纳的槽位数（按 SIMD 宽度向下取整）
+int particle_pool_capacity_for_budget(size_t budgetBytes);
+// 把可用容量提高到至少 capacity（不超过 maxCapacity），已有粒子原地不动；返回新的容量
+int particle_pool_grow(ParticlePool *pool, int capacity);
+void particle_pool_metrics(const ParticlePool *pool, ParticlePoolMetrics *metrics);
+void particle_pool_free(ParticlePool *pool);
+
+// 清空粒子池
+void particle_pool_clear(ParticlePool *pool);
+
+// 添加粒子，池满时 O(1) 替换最早过期的粒子，返回所在槽位
+int particle_pool_emit(ParticlePool *pool, const Particle *p);
+
+// 批量添加 src 中的全部粒子：先按列整段复制到空闲槽位，剩余的逐个替换最早过期的粒子。
+// 新粒子的上一步位置取当前位置（src 的 px/py 不使用）
+void particle_pool_emit_bulk(ParticlePool *pool, const ParticlePool *src);
+
+// 直接写入第 i 个槽位的各列（不维护过期索引）
+void particle_pool_store(ParticlePool *pool, int i, const Particle *p);
+// 读出第 i 个槽位
+void particle_pool_load(const ParticlePool *pool, int i, Particle *p);
+// 用最后一个粒子覆盖第 i 个粒子并减少计数
+void particle_pool_remove(ParticlePool *pool, int i);
+
+// 积分并淡出：p = x, life -= dt, v += a*dt, x += v*dt, a = life*fade, size *= exp(shrink*dt)
+void particle_integrate(ParticlePool *pool, float dt);
+// 只积分 [begin, end) 区间、不推进时钟，供分块并行使用；begin 须为 PARTICLE_SIMD_WIDTH 的倍数
+void particle_integrate_range(ParticlePool *pool, int begin, int end, float dt);
+// 同上，另外给全部粒子统一叠加加速度 (fieldX, fieldY)：v += (a + field) * dt。
+// 场为 0 时结果与 particle_integrate_range 逐位相同
+void particle_integrate_field_range(ParticlePool *pool, int begin, int end, float dt, float fieldX, float fieldY);
+// 推进粒子池时钟，分块积分全部完成后调用一次
+void particle_pool_advance(ParticlePool *pool, float dt);
+// 标量版本（用于对比和不支持 SIMD 的平台）
+void particle_integrate_scalar(ParticlePool *pool, float dt);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_POOL_H
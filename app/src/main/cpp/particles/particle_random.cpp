@@ -0,0 +1,139 @@
+#include "particle_random.h"
+
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLE_RANDOM_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define PARTICLE_RANDOM_SSE2 1
+#endif
+
+// 取高 24 位映射到 [0, 1)，与 float 尾数位数一致，结果严格小于 1
+#define RANDOM_FLOAT_SCALE (1.0f / 16777216.0f)
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void particle_random_seed(ParticleRandom *rng, uint64_t seed, uint32_t stream) {
+    memset(rng, 0, sizeof(*rng));
+    uint64_t state = seed ^ ((uint64_t) stream * 0xD1B54A32D192ED03ULL);
+    for (int lane = 0; lane < PARTICLE_RANDOM_LANES; lane++) {
+        for (int k = 0; k < 4; k += 2) {
+            uint64_t word = splitmix64(&state);
+            rng->s[k][lane] = (uint32_t) word;
+            rng->s[k + 1][lane] = (uint32_t) (word >> 32);
+        }
+        // xoshiro 的状态不能全为 0
+        if ((rng->s[0][lane] | rng->s[1][lane] | rng->s[2][lane] | rng->s[3][lane]) == 0) {
+            rng->s[0][lane] = 1;
+        }
+    }
+    rng->next = PARTICLE_RANDOM_LANES;
+}
+
+// 4 路各推进一步，把结果写到 out[0..3]
+#if defined(PARTICLE_RANDOM_NEON)
+
+static inline void step(ParticleRandom *rng, float *out) {
+    uint32x4_t s0 = vld1q_u32(rng->s[0]);
+    uint32x4_t s1 = vld1q_u32(rng->s[1]);
+    uint32x4_t s2 = vld1q_u32(rng->s[2]);
+    uint32x4_t s3 = vld1q_u32(rng->s[3]);
+    uint32x4_t result = vaddq_u32(s0, s3);
+    uint32x4_t t = vshlq_n_u32(s1, 9);
+    s2 = veorq_u32(s2, s0);
+    s3 = veorq_u32(s3, s1);
+    s1 = veorq_u32(s1, s2);
+    s0 = veorq_u32(s0, s3);
+    s2 = veorq_u32(s2, t);
+    s3 = vorrq_u32(vshlq_n_u32(s3, 11), vshrq_n_u32(s3, 21));
+    vst1q_u32(rng->s[0], s0);
+    vst1q_u32(rng->s[1], s1);
+    vst1q_u32(rng->s[2], s2);
+    vst1q_u32(rng->s[3], s3);
+    vst1q_f32(out, vmulq_n_f32(vcvtq_f32_u32(vshrq_n_u32(result, 8)), RANDOM_FLOAT_SCALE));
+}
+
+#elif defined(PARTICLE_RANDOM_SSE2)
+
+static inline void step(ParticleRandom *rng, float *out) {
+    __m128i s0 = _mm_loadu_si128((const __m128i *) rng->s[0]);
+    __m128i s1 = _mm_loadu_si128((const __m128i *) rng->s[1]);
+    __m128i s2 = _mm_loadu_si128((const __m128i *) rng->s[2]);
+    __m128i s3 = _mm_loadu_si128((const __m128i *) rng->s[3]);
+    __m128i result = _mm_add_epi32(s0, s3);
+    __m128i t = _mm_slli_epi32(s1, 9);
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+    _mm_storeu_si128((__m128i *) rng->s[0], s0);
+    _mm_storeu_si128((__m128i *) rng->s[1], s1);
+    _mm_storeu_si128((__m128i *) rng->s[2], s2);
+    _mm_storeu_si128((__m128i *) rng->s[3], s3);
+    // 右移 8 位后不超过 2^24，按有符号转换也是精确的
+    __m128 values = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+    _mm_storeu_ps(out, _mm_mul_ps(values, _mm_set1_ps(RANDOM_FLOAT_SCALE)));
+}
+
+#else
+
+static inline void step(ParticleRandom *rng, float *out) {
+    for (int lane = 0; lane < PARTICLE_RANDOM_LANES; lane++) {
+        uint32_t s0 = rng->s[0][lane], s1 = rng->s[1][lane];
+        uint32_t s2 = rng->s[2][lane], s3 = rng->s[3][lane];
+        uint32_t result = s0 + s3;
+        uint32_t t = s1 << 9;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 11) | (s3 >> 21);
+        rng->s[0][lane] = s0;
+        rng->s[1][lane] = s1;
+        rng->s[2][lane] = s2;
+        rng->s[3][lane] = s3;
+        out[lane] = (float) (result >> 8) * RANDOM_FLOAT_SCALE;
+    }
+}
+
+#endif
+
+float particle_random_float(ParticleRandom *rng) {
+    if (rng->next >= PARTICLE_RANDOM_LANES) {
+        step(rng, rng->cached);
+        rng->next = 0;
+    }
+    return rng->cached[rng->next++];
+}
+
+int particle_random_int(ParticleRandom *rng, int n) {
+    int value = (int) (particle_random_float(rng) * (float) n);
+    return value < n ? value : n - 1;
+}
+
+void particle_random_fill(ParticleRandom *rng, float *out, int count) {
+    // 先用完上一批剩下的结果，保证与逐个取数的序列一致
+    while (count > 0 && rng->next < PARTICLE_RANDOM_LANES) {
+        *out++ = rng->cached[rng->next++];
+        count--;
+    }
+    for (; count >= PARTICLE_RANDOM_LANES; count -= PARTICLE_RANDOM_LANES) {
+        step(rng, out);
+        out += PARTICLE_RANDOM_LANES;
+    }
+    if (count > 0) {
+        step(rng, rng->cached);
+        memcpy(out, rng->cached, count * sizeof(float));
+        rng->next = count;
+    }
+}
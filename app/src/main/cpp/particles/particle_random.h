@@ -0,0 +1,37 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_RANDOM_H
+#define NATIVE_ACTIVITY_PARTICLE_RANDOM_H
+
+#include <stdint.h>
+
+// ---------- 发射器随机数（xoshiro128+，4 路交错）----------
+// 4 条独立的 xoshiro128+ 序列按列存放，SIMD 一次推进 4 路，得到 4 个均匀分布的 float。
+// 标量取数从同一批结果里依次取，因此单个取数和批量填充产出同一条序列：
+// 相同的种子在任何平台、任何取数方式下都得到相同的发射结果，可用于基准和回放。
+// 状态不加锁，每个线程（或每个模拟实例）各自持有一个。
+
+#define PARTICLE_RANDOM_LANES 4
+
+typedef struct ParticleRandom {
+    uint32_t s[4][PARTICLE_RANDOM_LANES];  // s[k][lane]：第 lane 路的第 k 个状态字
+    float cached[PARTICLE_RANDOM_LANES];   // 最近一批结果，标量取数用
+    int next;                              // cached 中下一个未用的位置
+} ParticleRandom;
+
+// 用 64 位种子初始化（splitmix64 展开），stream 区分同一种子下的不同线程/用途
+void particle_random_seed(ParticleRandom *rng, uint64_t seed, uint32_t stream);
+
+// [0, 1) 均匀分布
+float particle_random_float(ParticleRandom *rng);
+
+// [lo, hi) 均匀分布
+static inline float particle_random_range(ParticleRandom *rng, float lo, float hi) {
+    return lo + particle_random_float(rng) * (hi - lo);
+}
+
+// [0, n) 的整数
+int particle_random_int(ParticleRandom *rng, int n);
+
+// 批量填充 count 个 [0, 1) 的 float（SIMD），序列与逐个调用 particle_random_float 相同
+void particle_random_fill(ParticleRandom *rng, float *out, int count);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_RANDOM_H
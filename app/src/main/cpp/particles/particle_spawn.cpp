@@ -0,0 +1,32 @@
+#include "particle_spawn.h"
+
+#include <cstring>
+
+int particle_spawn_init(ParticleSpawnBuffer *buffer, int budget) {
+    memset(buffer, 0, sizeof(*buffer));
+    return particle_pool_init(&buffer->staged, budget);
+}
+
+void particle_spawn_free(ParticleSpawnBuffer *buffer) {
+    particle_pool_free(&buffer->staged);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+int particle_spawn_push(ParticleSpawnBuffer *buffer, const Particle *p) {
+    ParticlePool *staged = &buffer->staged;
+    if (staged->count >= staged->capacity) {
+        buffer->dropped++;
+        return -1;
+    }
+    particle_pool_store(staged, staged->count++, p);
+    return 0;
+}
+
+void particle_spawn_reset(ParticleSpawnBuffer *buffer) {
+    buffer->staged.count = 0;
+}
+
+void particle_spawn_apply(ParticlePool *pool, ParticleSpawnBuffer *buffer) {
+    particle_pool_emit_bulk(pool, &buffer->staged);
+    buffer->staged.count = 0;
+}
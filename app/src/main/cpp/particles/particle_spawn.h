@@ -0,0 +1,27 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_SPAWN_H
+#define NATIVE_ACTIVITY_PARTICLE_SPAWN_H
+
+#include "particle_pool.h"
+
+// ---------- 每帧发射缓冲 ----------
+// 发射器只往缓冲里写请求，积分和移除结束后由 particle_spawn_apply 一次性写入粒子池，
+// 更新循环因此不会修改正在遍历的数组。
+typedef struct ParticleSpawnBuffer {
+    ParticlePool staged;  // 与粒子池相同的 SoA 列，容量即每帧发射预算
+    int dropped;          // 超出预算被丢弃的请求总数
+} ParticleSpawnBuffer;
+
+// 创建预算为 budget 的发射缓冲，成功返回 0，失败返回 -1
+int particle_spawn_init(ParticleSpawnBuffer *buffer, int budget);
+void particle_spawn_free(ParticleSpawnBuffer *buffer);
+
+// 写入一个发射请求，超出预算时丢弃并返回 -1
+int particle_spawn_push(ParticleSpawnBuffer *buffer, const Particle *p);
+
+// 丢弃本帧尚未应用的请求
+void particle_spawn_reset(ParticleSpawnBuffer *buffer);
+
+// 把本帧的请求批量写入粒子池并清空缓冲
+void particle_spawn_apply(ParticlePool *pool, ParticleSpawnBuffer *buffer);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_SPAWN_H
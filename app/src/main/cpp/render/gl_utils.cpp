@@ -0,0 +1,77 @@
+#include "gl_utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "render_log.h"
+
+GLuint gl_compile_shader(GLenum type, const char *source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+    GLint compiled = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        GLint infoLen = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen > 1) {
+            char *infoLog = (char *) malloc(infoLen);
+            glGetShaderInfoLog(shader, infoLen, nullptr, infoLog);
+            RENDER_LOGW("Error compiling shader:[%s]", infoLog);
+            free(infoLog);
+        }
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint gl_link_program(GLuint vertexShader, GLuint fragmentShader,
+                       const char *const *varyings, int varyingCount) {
+    if (vertexShader == 0 || (fragmentShader == 0 && varyings == nullptr)) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    if (fragmentShader != 0) {
+        glAttachShader(program, fragmentShader);
+    }
+    if (varyings != nullptr) {
+        glTransformFeedbackVaryings(program, varyingCount, varyings, GL_INTERLEAVED_ATTRIBS);
+    }
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLint infoLen = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen > 1) {
+            char *infoLog = (char *) malloc(infoLen);
+            glGetProgramInfoLog(program, infoLen, nullptr, infoLog);
+            RENDER_LOGW("Error linking program:[%s]", infoLog);
+            free(infoLog);
+        }
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+int gl_context_version() {
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major <= 0) {
+        // ES 2.0 上下文不支持 GL_MAJOR_VERSION 查询
+        const char *version = (const char *) glGetString(GL_VERSION);
+        if (version == nullptr || sscanf(version, "OpenGL ES %d.%d", &major, &minor) != 2) {
+            return 0;
+        }
+    }
+    return major * 10 + minor;
+}
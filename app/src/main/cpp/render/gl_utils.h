@@ -0,0 +1,17 @@
+#ifndef NATIVE_ACTIVITY_GL_UTILS_H
+#define NATIVE_ACTIVITY_GL_UTILS_H
+
+#include <GLES3/gl31.h>
+
+// 编译着色器，失败时输出日志并返回 0
+GLuint gl_compile_shader(GLenum type, const char *source);
+
+// 链接程序并删除传入的着色器，失败时输出日志并返回 0。
+// varyings 非空时在链接前设置交错模式的变换反馈输出。
+GLuint gl_link_program(GLuint vertexShader, GLuint fragmentShader,
+                       const char *const *varyings, int varyingCount);
+
+// 当前上下文的 GLES 版本（如 30、31、32），无法解析时返回 0
+int gl_context_version();
+
+#endif //NATIVE_ACTIVITY_GL_UTILS_H
@@ -0,0 +1,313 @@
+#include "gpu_particle_sim.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "gl_utils.h"
+#include "render_log.h"
+
+#define GPU_PARTICLE_STRIDE (GPU_PARTICLE_FLOATS * sizeof(GLfloat))
+#define COMPUTE_GROUP_SIZE  64
+
+// ---------- 变换反馈：每个顶点就是一个粒子 ----------
+static const char *kFeedbackVertexSrc =
+    "#version 300 es\n"
+    "uniform float uDt;\n"
+    "uniform vec2 uField;\n"                      // 全局加速度，所有粒子相同
+    "layout(location = 0) in vec4 aPosVel;\n"    // x y vx vy
+    "layout(location = 1) in vec2 aAccel;\n"     // ax ay
+    "layout(location = 2) in vec4 aColor;\n"     // r g b a
+    "layout(location = 3) in vec4 aSizeLife;\n"  // size life fade shrink
+    "out vec4 vPosVel;\n"
+    "out vec2 vAccel;\n"
+    "out vec4 vColor;\n"
+    "out vec4 vSizeLife;\n"
+    "void main() {\n"
+    "    float life = aSizeLife.y - uDt;\n"
+    "    vec2 vel = aPosVel.zw + (aAccel + uField) * uDt;\n"
+    "    vec2 pos = aPosVel.xy + vel * uDt;\n"
+    "    float alive = life > 0.0 ? 1.0 : 0.0;\n"
+    "    vPosVel = vec4(pos, vel);\n"
+    "    vAccel = aAccel;\n"
+    "    vColor = vec4(aColor.rgb, life * aSizeLife.z * alive);\n"
+    "    vSizeLife = vec4(aSizeLife.x * exp(aSizeLife.w * uDt) * alive, life, aSizeLife.zw);\n"
+    "}\n";
+
+// ES 3.0 链接程序必须带片段着色器，光栅化被丢弃所以不会执行
+static const char *kFeedbackFragmentSrc =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = vec4(0.0);\n"
+    "}\n";
+
+static const char *const kFeedbackVaryings[] = {"vPosVel", "vAccel", "vColor", "vSizeLife"};
+
+// ---------- 计算着色器：原地更新 ----------
+static const char *kComputeSrc =
+    "#version 310 es\n"
+    "layout(local_size_x = 64) in;\n"
+    "layout(std430, binding = 0) buffer State { float s[]; };\n"
+    "uniform float uDt;\n"
+    "uniform vec2 uField;\n"
+    "uniform uint uCount;\n"
+    "void main() {\n"
+    "    uint i = gl_GlobalInvocationID.x;\n"
+    "    if (i >= uCount) return;\n"
+    "    uint o = i * 14u;\n"
+    "    float life = s[o + 11u] - uDt;\n"
+    "    float vx = s[o + 2u] + (s[o + 4u] + uField.x) * uDt;\n"
+    "    float vy = s[o + 3u] + (s[o + 5u] + uField.y) * uDt;\n"
+    "    float alive = life > 0.0 ? 1.0 : 0.0;\n"
+    "    s[o + 0u] += vx * uDt;\n"
+    "    s[o + 1u] += vy * uDt;\n"
+    "    s[o + 2u] = vx;\n"
+    "    s[o + 3u] = vy;\n"
+    "    s[o + 9u] = life * s[o + 12u] * alive;\n"
+    "    s[o + 10u] = s[o + 10u] * exp(s[o + 13u] * uDt) * alive;\n"
+    "    s[o + 11u] = life;\n"
+    "}\n";
+
+int gpu_particle_sim_supports_compute() {
+    return gl_context_version() >= 31;
+}
+
+static void setup_sim_vao(GLuint vao, GLuint buffer) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (0 * sizeof(GLfloat)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (4 * sizeof(GLfloat)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (6 * sizeof(GLfloat)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (10 * sizeof(GLfloat)));
+    for (GLuint i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(i);
+    }
+}
+
+static void setup_draw_vao(GLuint vao, GLuint buffer) {
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (0 * sizeof(GLfloat)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (6 * sizeof(GLfloat)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, GPU_PARTICLE_STRIDE, (void *) (10 * sizeof(GLfloat)));
+    for (GLuint i = 0; i < 3; i++) {
+        glEnableVertexAttribArray(i);
+    }
+}
+
+int gpu_particle_sim_init(GpuParticleSim *sim, int mode, int capacity) {
+    memset(sim, 0, sizeof(*sim));
+    if (capacity <= 0) {
+        return -1;
+    }
+    if (mode == GPU_SIM_COMPUTE) {
+        if (!gpu_particle_sim_supports_compute()) {
+            RENDER_LOGW("compute shaders need GLES 3.1");
+            return -1;
+        }
+        GLuint shader = gl_compile_shader(GL_COMPUTE_SHADER, kComputeSrc);
+        if (shader == 0) {
+            return -1;
+        }
+        sim->program = glCreateProgram();
+        glAttachShader(sim->program, shader);
+        glLinkProgram(sim->program);
+        glDeleteShader(shader);
+        GLint linked = 0;
+        glGetProgramiv(sim->program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            RENDER_LOGW("particle compute program link failed");
+            glDeleteProgram(sim->program);
+            sim->program = 0;
+            return -1;
+        }
+        sim->uCount = glGetUniformLocation(sim->program, "uCount");
+    } else {
+        sim->program = gl_link_program(gl_compile_shader(GL_VERTEX_SHADER, kFeedbackVertexSrc),
+                                       gl_compile_shader(GL_FRAGMENT_SHADER, kFeedbackFragmentSrc),
+                                       kFeedbackVaryings, 4);
+        if (sim->program == 0) {
+            return -1;
+        }
+        sim->uCount = -1;
+    }
+    sim->uDt = glGetUniformLocation(sim->program, "uDt");
+    sim->uField = glGetUniformLocation(sim->program, "uField");
+    sim->mode = mode;
+    sim->capacity = capacity;
+
+    // 计算着色器原地更新只需要一个缓冲
+    int bufferCount = mode == GPU_SIM_COMPUTE ? 1 : 2;
+    glGenBuffers(bufferCount, sim->buffers);
+    glGenVertexArrays(bufferCount, sim->drawVaos);
+    for (int i = 0; i < bufferCount; i++) {
+        glBindBuffer(GL_ARRAY_BUFFER, sim->buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) capacity * GPU_PARTICLE_STRIDE, nullptr, GL_DYNAMIC_COPY);
+        setup_draw_vao(sim->drawVaos[i], sim->buffers[i]);
+    }
+    if (mode == GPU_SIM_TRANSFORM_FEEDBACK) {
+        glGenVertexArrays(2, sim->simVaos);
+        for (int i = 0; i < 2; i++) {
+            setup_sim_vao(sim->simVaos[i], sim->buffers[i]);
+        }
+        glGenTransformFeedbacks(1, &sim->feedback);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return 0;
+}
+
+void gpu_particle_sim_free(GpuParticleSim *sim) {
+    if (sim->program != 0) {
+        glDeleteProgram(sim->program);
+        glDeleteBuffers(2, sim->buffers);
+        glDeleteVertexArrays(2, sim->drawVaos);
+        glDeleteVertexArrays(2, sim->simVaos);
+        if (sim->feedback != 0) {
+            glDeleteTransformFeedbacks(1, &sim->feedback);
+        }
+    }
+    free(sim->upload);
+    memset(sim, 0, sizeof(*sim));
+}
+
+void gpu_particle_sim_clear(GpuParticleSim *sim) {
+    sim->used = 0;
+    sim->head = 0;
+}
+
+void gpu_particle_sim_emit(GpuParticleSim *sim, const ParticlePool *spawns) {
+    int count = spawns->count;
+    int first = 0;
+    if (count > sim->capacity) {
+        // 一次发射超过容量时只保留最后 capacity 个
+        first = count - sim->capacity;
+        count = sim->capacity;
+    }
+    if (count <= 0) {
+        return;
+    }
+    if (count > sim->uploadCapacity) {
+        free(sim->upload);
+        sim->upload = (float *) malloc((size_t) count * GPU_PARTICLE_STRIDE);
+        sim->uploadCapacity = sim->upload != nullptr ? count : 0;
+        if (sim->upload == nullptr) {
+            return;
+        }
+    }
+
+    // SoA 暂存列交错成 GPU 记录
+    float *out = sim->upload;
+    for (int k = first; k < first + count; k++) {
+        out[0] = spawns->x[k];
+        out[1] = spawns->y[k];
+        out[2] = spawns->vx[k];
+        out[3] = spawns->vy[k];
+        out[4] = spawns->ax[k];
+        out[5] = spawns->ay[k];
+        out[6] = spawns->r[k];
+        out[7] = spawns->g[k];
+        out[8] = spawns->b[k];
+        out[9] = spawns->a[k];
+        out[10] = spawns->size[k];
+        out[11] = spawns->life[k];
+        out[12] = spawns->fade[k];
+        out[13] = spawns->shrink[k];
+        out += GPU_PARTICLE_FLOATS;
+    }
+
+    if (sim->mode == GPU_SIM_COMPUTE) {
+        // 上一步计算着色器的写入必须先完成
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+    // 环形写入，最多分两段
+    glBindBuffer(GL_ARRAY_BUFFER, sim->buffers[sim->current]);
+    int written = 0;
+    while (written < count) {
+        int n = sim->capacity - sim->head;
+        if (n > count - written) {
+            n = count - written;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr) sim->head * GPU_PARTICLE_STRIDE,
+                        (GLsizeiptr) n * GPU_PARTICLE_STRIDE,
+                        sim->upload + (size_t) written * GPU_PARTICLE_FLOATS);
+        written += n;
+        sim->head = (sim->head + n) % sim->capacity;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    sim->used += count;
+    if (sim->used > sim->capacity) {
+        sim->used = sim->capacity;
+    }
+}
+
+void gpu_particle_sim_set_field(GpuParticleSim *sim, float fieldX, float fieldY) {
+    sim->fieldX = fieldX;
+    sim->fieldY = fieldY;
+}
+
+void gpu_particle_sim_step(GpuParticleSim *sim, float dt) {
+    if (sim->used == 0) {
+        return;
+    }
+    glUseProgram(sim->program);
+    glUniform1f(sim->uDt, dt);
+    glUniform2f(sim->uField, sim->fieldX, sim->fieldY);
+
+    if (sim->mode == GPU_SIM_COMPUTE) {
+        glUniform1ui(sim->uCount, (GLuint) sim->used);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, sim->buffers[0]);
+        glDispatchCompute((sim->used + COMPUTE_GROUP_SIZE - 1) / COMPUTE_GROUP_SIZE, 1, 1);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+        // 接下来作为顶点属性读取
+        glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+        return;
+    }
+
+    int next = 1 - sim->current;
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(sim->simVaos[sim->current]);
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, sim->feedback);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, sim->buffers[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, sim->used);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    sim->current = next;
+}
+
+void gpu_particle_sim_draw(const GpuParticleSim *sim) {
+    if (sim->used == 0) {
+        return;
+    }
+    glBindVertexArray(sim->drawVaos[sim->current]);
+    glDrawArrays(GL_POINTS, 0, sim->used);
+    glBindVertexArray(0);
+}
+
+int gpu_particle_sim_read(const GpuParticleSim *sim, float *out, int count) {
+    if (count > sim->used) {
+        count = sim->used;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+    if (sim->mode == GPU_SIM_COMPUTE) {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    }
+    GLsizeiptr bytes = (GLsizeiptr) count * GPU_PARTICLE_STRIDE;
+    glBindBuffer(GL_ARRAY_BUFFER, sim->buffers[sim->current]);
+    void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+    if (mapped == nullptr) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return 0;
+    }
+    memcpy(out, mapped, bytes);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return count;
+}
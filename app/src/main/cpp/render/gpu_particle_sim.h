@@ -0,0 +1,67 @@
+#ifndef NATIVE_ACTIVITY_GPU_PARTICLE_SIM_H
+#define NATIVE_ACTIVITY_GPU_PARTICLE_SIM_H
+
+#include <GLES3/gl31.h>
+
+#include "particle_pool.h"
+
+// ---------- GPU 常驻粒子模拟 ----------
+// 粒子状态保存在 GPU 缓冲里，每帧只上传新发射的粒子（环形写入，覆盖最早发射的槽位）。
+// ES 3.0 使用变换反馈在两个缓冲之间乒乓更新，ES 3.1+ 可以用计算着色器原地更新。
+// 每个粒子 14 个 float，与 ParticlePool 的列顺序一致：
+//   x y vx vy ax ay r g b a size life fade shrink
+// shrink 为 ln(每秒尺寸系数)，每步 size *= exp(shrink * dt)。
+// 死亡粒子（life <= 0）的 a 和 size 被置 0，留在槽位里直到被新粒子覆盖。
+
+#define GPU_PARTICLE_FLOATS 14
+
+enum GpuSimMode {
+    GPU_SIM_TRANSFORM_FEEDBACK,
+    GPU_SIM_COMPUTE
+};
+
+typedef struct GpuParticleSim {
+    int mode;
+    int capacity;
+    int used;                // 已写入过的槽位数（绘制/更新的范围）
+    int head;                // 下一个写入的槽位
+    int current;             // 当前状态所在的缓冲（变换反馈乒乓）
+    GLuint buffers[2];
+    GLuint simVaos[2];       // 变换反馈输入
+    GLuint drawVaos[2];      // 绘制：location 0 位置，1 颜色，2 大小
+    GLuint feedback;
+    GLuint program;
+    GLint uDt;
+    GLint uField;
+    GLint uCount;
+    float fieldX, fieldY;    // 全局加速度，见 gpu_particle_sim_set_field
+    float *upload;           // 上传前的交错暂存
+    int uploadCapacity;
+} GpuParticleSim;
+
+// 当前上下文是否支持计算着色器路径（ES 3.1+）
+int gpu_particle_sim_supports_compute();
+
+// 在当前 GL 上下文中创建，成功返回 0，失败返回 -1（例如计算着色器不可用）
+int gpu_particle_sim_init(GpuParticleSim *sim, int mode, int capacity);
+void gpu_particle_sim_free(GpuParticleSim *sim);
+
+// 丢弃全部粒子
+void gpu_particle_sim_clear(GpuParticleSim *sim);
+
+// 上传 spawns 中的新粒子（通常是 ParticleSpawnBuffer 的暂存池）
+void gpu_particle_sim_emit(GpuParticleSim *sim, const ParticlePool *spawns);
+
+// 设置全局加速度（与 FireworksSim::fieldX/fieldY 相同），从下一次 gpu_particle_sim_step 起生效
+void gpu_particle_sim_set_field(GpuParticleSim *sim, float fieldX, float fieldY);
+
+// 在 GPU 上推进一步
+void gpu_particle_sim_step(GpuParticleSim *sim, float dt);
+
+// 用当前绑定的粒子着色器把全部槽位画成点精灵
+void gpu_particle_sim_draw(const GpuParticleSim *sim);
+
+// 读回前 count 个槽位的状态（校验用，会等待 GPU），返回读到的粒子数
+int gpu_particle_sim_read(const GpuParticleSim *sim, float *out, int count);
+
+#endif //NATIVE_ACTIVITY_GPU_PARTICLE_SIM_H
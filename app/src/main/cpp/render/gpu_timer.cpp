@@ -0,0 +1,87 @@
+#include "gpu_timer.h"
+
+#include <cstring>
+
+// GL_EXT_disjoint_timer_query（ES 3 上与核心查询函数一起使用）
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+
+static int has_extension(const char *name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char *extension = (const char *) glGetStringi(GL_EXTENSIONS, i);
+        if (extension != nullptr && strcmp(extension, name) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int gpu_timer_init(GpuTimer *timer) {
+    memset(timer, 0, sizeof(*timer));
+    if (!has_extension("GL_EXT_disjoint_timer_query")) {
+        return -1;
+    }
+    glGenQueries(GPU_TIMER_QUERIES, timer->queries);
+    // 清掉之前残留的 disjoint 标志
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    timer->supported = 1;
+    return 0;
+}
+
+void gpu_timer_free(GpuTimer *timer) {
+    if (timer->supported) {
+        glDeleteQueries(GPU_TIMER_QUERIES, timer->queries);
+    }
+    memset(timer, 0, sizeof(*timer));
+}
+
+void gpu_timer_begin(GpuTimer *timer) {
+    if (!timer->supported || timer->pending[timer->next]) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED_EXT, timer->queries[timer->next]);
+    timer->active = 1;
+}
+
+void gpu_timer_end(GpuTimer *timer) {
+    if (!timer->active) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    timer->active = 0;
+    timer->pending[timer->next] = 1;
+    timer->next = (timer->next + 1) % GPU_TIMER_QUERIES;
+}
+
+int gpu_timer_poll(GpuTimer *timer) {
+    if (!timer->supported) {
+        return 0;
+    }
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    int collected = 0;
+    for (int i = 0; i < GPU_TIMER_QUERIES; i++) {
+        if (!timer->pending[i]) {
+            continue;
+        }
+        GLuint available = 0;
+        glGetQueryObjectuiv(timer->queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available && !disjoint) {
+            continue;
+        }
+        timer->pending[i] = 0;
+        if (disjoint) {
+            continue;
+        }
+        GLuint ns = 0;
+        glGetQueryObjectuiv(timer->queries[i], GL_QUERY_RESULT, &ns);
+        timer->lastMs = ns * 1e-6;
+        timer->totalMs += timer->lastMs;
+        timer->samples++;
+        collected++;
+    }
+    return collected;
+}
@@ -0,0 +1,35 @@
+#ifndef NATIVE_ACTIVITY_GPU_TIMER_H
+#define NATIVE_ACTIVITY_GPU_TIMER_H
+
+#include <GLES3/gl3.h>
+
+// ---------- GPU 计时 ----------
+// 基于 GL_EXT_disjoint_timer_query 的 GL_TIME_ELAPSED 查询，多个查询轮流使用，
+// 结果在几帧之后可用时再读取，不阻塞 CPU。发生 disjoint（频率切换等）的那批结果丢弃。
+// 不支持该扩展时 begin/end/poll 都是空操作。
+
+#define GPU_TIMER_QUERIES 4
+
+typedef struct GpuTimer {
+    int supported;
+    GLuint queries[GPU_TIMER_QUERIES];
+    int pending[GPU_TIMER_QUERIES];  // 已结束、等待读取结果
+    int next;                        // 下一次 begin 使用的查询
+    int active;                      // begin 之后、end 之前
+    double lastMs;                   // 最近一次读到的结果
+    double totalMs;                  // 累计（可由调用方清零分段统计）
+    int samples;
+} GpuTimer;
+
+// 在当前上下文中创建，扩展不可用返回 -1（计时器仍可安全调用）
+int gpu_timer_init(GpuTimer *timer);
+void gpu_timer_free(GpuTimer *timer);
+
+// 包围要计时的 GL 命令；上一轮同一查询的结果还没取回时跳过本次
+void gpu_timer_begin(GpuTimer *timer);
+void gpu_timer_end(GpuTimer *timer);
+
+// 取回已完成的结果，返回本次新取到的样本数
+int gpu_timer_poll(GpuTimer *timer);
+
+#endif //NATIVE_ACTIVITY_GPU_TIMER_H
@@ -0,0 +1,143 @@
+#include "particle_quads.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "gl_utils.h"
+#include "particle_pack.h"
+
+// 属性位置与点精灵着色器一致（0 位置、1 颜色、2 大小），3 运动、4 角点
+enum {
+    ATTRIB_POSITION,
+    ATTRIB_COLOR,
+    ATTRIB_SIZE,
+    ATTRIB_MOTION,
+    ATTRIB_CORNER
+};
+
+// 运动量是 GL_BYTE 归一化（c / 127），uStretch 已乘回 127 / PARTICLE_MOTION_SCALE
+static const char QUAD_VS[] =
+        "#version 300 es\n"
+        "uniform mat4 uMatrix;\n"
+        "uniform float uSizeScale;\n"
+        "uniform float uPixelsPerUnit;\n"
+        "uniform vec2 uPixelToClip;\n"
+        "uniform float uStretch;\n"
+        "layout(location = 0) in vec2 aPosition;\n"
+        "layout(location = 1) in vec4 aColor;\n"
+        "layout(location = 2) in float aSize;\n"
+        "layout(location = 3) in vec2 aMotion;\n"
+        "layout(location = 4) in vec2 aCorner;\n"
+        "out vec4 vColor;\n"
+        "out vec2 vTexCoord;\n"
+        "void main() {\n"
+        "    float size = aSize * uSizeScale;\n"
+        "    vec2 motion = aMotion * (uStretch * uPixelsPerUnit);\n"
+        "    float travel = length(motion);\n"
+        "    vec2 dir = travel > 1e-3 ? motion / travel : vec2(1.0, 0.0);\n"
+        "    float along = size + travel;\n"
+        "    vec2 offset = aCorner.x * along * dir + aCorner.y * size * vec2(-dir.y, dir.x);\n"
+        "    gl_Position = uMatrix * vec4(aPosition, 0.0, 1.0);\n"
+        "    gl_Position.xy += offset * uPixelToClip * gl_Position.w;\n"
+        "    vColor = vec4(aColor.rgb, aColor.a * size / max(along, 1e-3));\n"
+        "    vTexCoord = aCorner + 0.5;\n"
+        "}\n";
+
+static const char QUAD_FS[] =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform sampler2D uTexture;\n"
+        "in vec4 vColor;\n"
+        "in vec2 vTexCoord;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "    fragColor = vColor * texture(uTexture, vTexCoord);\n"
+        "}\n";
+
+// 三角形带顺序的 4 个角点，单位正方形居中于原点
+static const GLfloat QUAD_CORNERS[] = {
+        -0.5f, -0.5f,
+        0.5f, -0.5f,
+        -0.5f, 0.5f,
+        0.5f, 0.5f,
+};
+
+static void set_instance_pointers(GLintptr offset) {
+    const GLsizei stride = sizeof(ParticleVertex);
+    glVertexAttribPointer(ATTRIB_POSITION, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+                          (void *) (offset + offsetof(ParticleVertex, x)));
+    glVertexAttribPointer(ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                          (void *) (offset + offsetof(ParticleVertex, r)));
+    glVertexAttribPointer(ATTRIB_SIZE, 1, GL_UNSIGNED_SHORT, GL_FALSE, stride,
+                          (void *) (offset + offsetof(ParticleVertex, size)));
+    glVertexAttribPointer(ATTRIB_MOTION, 2, GL_BYTE, GL_TRUE, stride,
+                          (void *) (offset + offsetof(ParticleVertex, mx)));
+}
+
+int particle_quads_init(ParticleQuadRenderer *renderer, GLuint instanceBuffer) {
+    memset(renderer, 0, sizeof(*renderer));
+    renderer->program = gl_link_program(gl_compile_shader(GL_VERTEX_SHADER, QUAD_VS),
+                                        gl_compile_shader(GL_FRAGMENT_SHADER, QUAD_FS), nullptr, 0);
+    if (renderer->program == 0) {
+        return -1;
+    }
+    renderer->uMatrix = glGetUniformLocation(renderer->program, "uMatrix");
+    renderer->uTexture = glGetUniformLocation(renderer->program, "uTexture");
+    renderer->uSizeScale = glGetUniformLocation(renderer->program, "uSizeScale");
+    renderer->uPixelsPerUnit = glGetUniformLocation(renderer->program, "uPixelsPerUnit");
+    renderer->uPixelToClip = glGetUniformLocation(renderer->program, "uPixelToClip");
+    renderer->uStretch = glGetUniformLocation(renderer->program, "uStretch");
+    renderer->instanceBuffer = instanceBuffer;
+
+    glGenBuffers(1, &renderer->cornerBuffer);
+    glGenVertexArrays(1, &renderer->vao);
+    glBindVertexArray(renderer->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer->cornerBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD_CORNERS), QUAD_CORNERS, GL_STATIC_DRAW);
+    glVertexAttribPointer(ATTRIB_CORNER, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(ATTRIB_CORNER);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    set_instance_pointers(0);
+    for (GLuint attrib = ATTRIB_POSITION; attrib <= ATTRIB_MOTION; attrib++) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return 0;
+}
+
+void particle_quads_free(ParticleQuadRenderer *renderer) {
+    if (renderer->vao != 0) {
+        glDeleteVertexArrays(1, &renderer->vao);
+    }
+    if (renderer->cornerBuffer != 0) {
+        glDeleteBuffers(1, &renderer->cornerBuffer);
+    }
+    if (renderer->program != 0) {
+        glDeleteProgram(renderer->program);
+    }
+    memset(renderer, 0, sizeof(*renderer));
+}
+
+void particle_quads_draw(ParticleQuadRenderer *renderer, const ParticleQuadParams *params,
+                         GLintptr offset, GLsizei count) {
+    if (count <= 0) {
+        return;
+    }
+    glUseProgram(renderer->program);
+    glUniformMatrix4fv(renderer->uMatrix, 1, GL_FALSE, params->matrix);
+    glUniform1i(renderer->uTexture, params->textureUnit);
+    glUniform1f(renderer->uSizeScale, params->sizeScale);
+    glUniform1f(renderer->uPixelsPerUnit, params->pixelsPerUnit);
+    glUniform2f(renderer->uPixelToClip, 2.0f / params->viewportWidth, 2.0f / params->viewportHeight);
+    glUniform1f(renderer->uStretch, params->stretch * 127.0f / PARTICLE_MOTION_SCALE);
+
+    glBindVertexArray(renderer->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, renderer->instanceBuffer);
+    set_instance_pointers(offset);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
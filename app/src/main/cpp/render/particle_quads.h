@@ -0,0 +1,40 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_QUADS_H
+#define NATIVE_ACTIVITY_PARTICLE_QUADS_H
+
+#include <GLES3/gl3.h>
+
+// ---------- 实例化四边形粒子 ----------
+// 点精灵的 gl_PointSize 受 GL_ALIASED_POINT_SIZE_RANGE 限制（不少驱动上限只有 64 或 128 像素），
+// 不同驱动对超限和裁剪的处理也不一致，且只能画正方形。这里每个粒子画一个四边形：
+// 4 个角点是共享的静态顶点，粒子的 ParticleVertex（位置、颜色、大小、运动）作为逐实例属性，
+// 一次 glDrawArraysInstanced 画完。四边形沿运动方向旋转并拉长（长轴 = 大小 + 运动距离），
+// alpha 按面积比例降低，拉长后总亮度不变。纹理坐标与 gl_PointCoord 相同，片段着色器可共用。
+
+typedef struct ParticleQuadParams {
+    const float *matrix;     // 4x4 投影矩阵（列主序）
+    GLint textureUnit;       // 粒子纹理所在的纹理单元
+    float sizeScale;         // 顶点大小换算成像素的系数
+    float pixelsPerUnit;     // 世界单位对应的像素数
+    float viewportWidth;     // 像素，用于把像素偏移换算到裁剪空间
+    float viewportHeight;
+    float stretch;           // 拉伸长度 = 一步位移 * stretch（0 关闭拉伸和旋转）
+} ParticleQuadParams;
+
+typedef struct ParticleQuadRenderer {
+    GLuint program;
+    GLint uMatrix, uTexture, uSizeScale, uPixelsPerUnit, uPixelToClip, uStretch;
+    GLuint cornerBuffer;     // 4 个角点（三角形带）
+    GLuint vao;
+    GLuint instanceBuffer;   // 逐实例 ParticleVertex 所在的缓冲
+} ParticleQuadRenderer;
+
+// 创建着色器和 VAO，instanceBuffer 为 ParticleVertex 数组所在的缓冲（如流式缓冲），成功返回 0
+int particle_quads_init(ParticleQuadRenderer *renderer, GLuint instanceBuffer);
+void particle_quads_free(ParticleQuadRenderer *renderer);
+
+// 画 instanceBuffer 中从字节偏移 offset 开始的 count 个粒子。
+// ES 3.0 没有 baseInstance，逐实例属性的起点通过每次重设属性指针的偏移指定。
+void particle_quads_draw(ParticleQuadRenderer *renderer, const ParticleQuadParams *params,
+                         GLintptr offset, GLsizei count);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_QUADS_H
@@ -0,0 +1,194 @@
+#include "particle_target.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "gl_utils.h"
+#include "render_log.h"
+
+// 全屏三角形，顶点由 gl_VertexID 生成
+static const char COMPOSITE_VS[] =
+        "#version 300 es\n"
+        "out vec2 vUv;\n"
+        "void main() {\n"
+        "    vec2 p = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+        "    vUv = p;\n"
+        "    gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);\n"
+        "}\n";
+
+// %s 处插入滤波宏
+static const char COMPOSITE_FS[] =
+        "#version 300 es\n"
+        "%s"
+        "precision mediump float;\n"
+        "uniform sampler2D uTexture;\n"
+        "uniform vec2 uTexelSize;\n"
+        "in vec2 vUv;\n"
+        "out vec4 fragColor;\n"
+        "#ifdef BICUBIC\n"
+        // Catmull-Rom 权重，中间两个采样合并成一次双线性采样，3x3 次采样完成 4x4 滤波
+        "vec4 sampleCatmullRom(vec2 uv) {\n"
+        "    vec2 texSize = 1.0 / uTexelSize;\n"
+        "    vec2 pos = uv * texSize;\n"
+        "    vec2 p1 = floor(pos - 0.5) + 0.5;\n"
+        "    vec2 f = pos - p1;\n"
+        "    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));\n"
+        "    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);\n"
+        "    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));\n"
+        "    vec2 w3 = f * f * (-0.5 + 0.5 * f);\n"
+        "    vec2 w12 = w1 + w2;\n"
+        "    vec2 t0 = (p1 - 1.0) * uTexelSize;\n"
+        "    vec2 t3 = (p1 + 2.0) * uTexelSize;\n"
+        "    vec2 t12 = (p1 + w2 / w12) * uTexelSize;\n"
+        "    vec4 c = texture(uTexture, vec2(t0.x, t0.y)) * w0.x * w0.y\n"
+        "           + texture(uTexture, vec2(t12.x, t0.y)) * w12.x * w0.y\n"
+        "           + texture(uTexture, vec2(t3.x, t0.y)) * w3.x * w0.y\n"
+        "           + texture(uTexture, vec2(t0.x, t12.y)) * w0.x * w12.y\n"
+        "           + texture(uTexture, vec2(t12.x, t12.y)) * w12.x * w12.y\n"
+        "           + texture(uTexture, vec2(t3.x, t12.y)) * w3.x * w12.y\n"
+        "           + texture(uTexture, vec2(t0.x, t3.y)) * w0.x * w3.y\n"
+        "           + texture(uTexture, vec2(t12.x, t3.y)) * w12.x * w3.y\n"
+        "           + texture(uTexture, vec2(t3.x, t3.y)) * w3.x * w3.y;\n"
+        // 负瓣会产生负值和超过 alpha 的预乘颜色，夹回有效范围
+        "    c.a = clamp(c.a, 0.0, 1.0);\n"
+        "    c.rgb = clamp(c.rgb, 0.0, c.a);\n"
+        "    return c;\n"
+        "}\n"
+        "#endif\n"
+        "void main() {\n"
+        "#ifdef BICUBIC\n"
+        "    fragColor = sampleCatmullRom(vUv);\n"
+        "#else\n"
+        "    fragColor = texture(uTexture, vUv);\n"
+        "#endif\n"
+        "}\n";
+
+static const char *const FILTER_DEFINES[PARTICLE_UPSAMPLE_COUNT] = {
+        "",
+        "#define BICUBIC\n",
+};
+
+int particle_target_init(ParticleTarget *target) {
+    memset(target, 0, sizeof(*target));
+    target->divisor = 1;
+    char source[sizeof(COMPOSITE_FS) + 32];
+    for (int i = 0; i < PARTICLE_UPSAMPLE_COUNT; i++) {
+        snprintf(source, sizeof(source), COMPOSITE_FS, FILTER_DEFINES[i]);
+        GLuint program = gl_link_program(gl_compile_shader(GL_VERTEX_SHADER, COMPOSITE_VS),
+                                         gl_compile_shader(GL_FRAGMENT_SHADER, source),
+                                         nullptr, 0);
+        if (program == 0) {
+            particle_target_free(target);
+            return -1;
+        }
+        target->programs[i] = program;
+        target->uTexture[i] = glGetUniformLocation(program, "uTexture");
+        target->uTexelSize[i] = glGetUniformLocation(program, "uTexelSize");
+    }
+    glGenVertexArrays(1, &target->vao);
+    return 0;
+}
+
+static void release_surface(ParticleTarget *target) {
+    if (target->framebuffer != 0) {
+        glDeleteFramebuffers(1, &target->framebuffer);
+        target->framebuffer = 0;
+    }
+    if (target->texture != 0) {
+        glDeleteTextures(1, &target->texture);
+        target->texture = 0;
+    }
+    target->width = 0;
+    target->height = 0;
+}
+
+void particle_target_free(ParticleTarget *target) {
+    release_surface(target);
+    for (int i = 0; i < PARTICLE_UPSAMPLE_COUNT; i++) {
+        if (target->programs[i] != 0) {
+            glDeleteProgram(target->programs[i]);
+        }
+    }
+    if (target->vao != 0) {
+        glDeleteVertexArrays(1, &target->vao);
+    }
+    memset(target, 0, sizeof(*target));
+}
+
+int particle_target_resize(ParticleTarget *target, int screenWidth, int screenHeight, int divisor) {
+    target->screenWidth = screenWidth;
+    target->screenHeight = screenHeight;
+    if (divisor <= 1 && !target->offscreen) {
+        release_surface(target);
+        target->divisor = 1;
+        return 0;
+    }
+    divisor = divisor > 1 ? divisor : 1;
+    // 向上取整，保证放大后覆盖整个屏幕
+    int width = (screenWidth + divisor - 1) / divisor;
+    int height = (screenHeight + divisor - 1) / divisor;
+    if (target->texture != 0 && width == target->width && height == target->height) {
+        target->divisor = divisor;
+        return 0;
+    }
+    release_surface(target);
+
+    glGenTextures(1, &target->texture);
+    glBindTexture(GL_TEXTURE_2D, target->texture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &target->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        RENDER_LOGW("particle target %dx%d incomplete: 0x%x", width, height, status);
+        release_surface(target);
+        target->divisor = 1;
+        return -1;
+    }
+    target->width = width;
+    target->height = height;
+    target->divisor = divisor;
+    return 0;
+}
+
+void particle_target_begin(const ParticleTarget *target) {
+    if (target->framebuffer == 0) {
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    glViewport(0, 0, target->width, target->height);
+    // 不改动清屏颜色状态，屏幕清屏仍用调用方的设置
+    static const GLfloat transparent[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, transparent);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void particle_target_end(const ParticleTarget *target) {
+    if (target->framebuffer == 0) {
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, target->screenWidth, target->screenHeight);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    const int filter = target->filter;
+    glUseProgram(target->programs[filter]);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, target->texture);
+    glUniform1i(target->uTexture[filter], 0);
+    glUniform2f(target->uTexelSize[filter], 1.0f / (float) target->width, 1.0f / (float) target->height);
+    glBindVertexArray(target->vao);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
@@ -0,0 +1,47 @@
+#ifndef NATIVE_ACTIVITY_PARTICLE_TARGET_H
+#define NATIVE_ACTIVITY_PARTICLE_TARGET_H
+
+#include <GLES3/gl3.h>
+
+// ---------- 降分辨率粒子渲染目标 ----------
+// 粒子先画进 1/divisor 分辨率的离屏纹理，再放大合成到当前帧缓冲，片段数减少到 1/divisor²。
+// 离屏纹理保存预乘颜色：绘制时颜色按 SRC_ALPHA / ONE_MINUS_SRC_ALPHA、alpha 按 ONE / ONE_MINUS_SRC_ALPHA 混合，
+// 从透明清屏开始累积的结果正好是预乘的 "over"，合成时用 ONE / ONE_MINUS_SRC_ALPHA 叠到背景上，
+// 与直接画到屏幕上的结果一致（只差采样分辨率）。
+// 放大滤波：双线性，或 9 次采样的 Catmull-Rom 双三次（点精灵边缘更锐利）。
+// 场景没有深度，按深度判断边缘的放大方式在这里无从使用，用双三次代替。
+
+enum ParticleUpsampleFilter {
+    PARTICLE_UPSAMPLE_BILINEAR,
+    PARTICLE_UPSAMPLE_BICUBIC,
+    PARTICLE_UPSAMPLE_COUNT
+};
+
+typedef struct ParticleTarget {
+    int divisor;                  // 1 表示全分辨率
+    int offscreen;                // 测量模式：divisor 为 1 时也画进离屏纹理再合成，GPU 计时与降分辨率可比
+    int width, height;            // 离屏纹理尺寸
+    int screenWidth, screenHeight;
+    int filter;                   // ParticleUpsampleFilter
+    GLuint framebuffer;
+    GLuint texture;
+    GLuint programs[PARTICLE_UPSAMPLE_COUNT];
+    GLint uTexture[PARTICLE_UPSAMPLE_COUNT];
+    GLint uTexelSize[PARTICLE_UPSAMPLE_COUNT];
+    GLuint vao;                   // 全屏三角形不需要顶点数据，绑定一个空 VAO
+} ParticleTarget;
+
+// 编译合成着色器（需要 GL 上下文），成功返回 0
+int particle_target_init(ParticleTarget *target);
+void particle_target_free(ParticleTarget *target);
+
+// 设置屏幕尺寸和缩小倍数（1、2、4），尺寸变化时重建离屏纹理，成功返回 0。
+// divisor 为 1 且未设置 offscreen 时释放离屏纹理
+int particle_target_resize(ParticleTarget *target, int screenWidth, int screenHeight, int divisor);
+
+// 开始粒子绘制：有离屏纹理时绑定离屏目标、清成透明并设置预乘混合，否则什么都不做
+void particle_target_begin(const ParticleTarget *target);
+// 结束粒子绘制：有离屏纹理时合成到 0 号帧缓冲并恢复视口和 SRC_ALPHA 混合
+void particle_target_end(const ParticleTarget *target);
+
+#endif //NATIVE_ACTIVITY_PARTICLE_TARGET_H
@@ -0,0 +1,314 @@
+#include "program_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <EGL/egl.h>
+
+#include "render_log.h"
+
+// 与 GL_OES_get_program_binary 的枚举值相同，ES 2.0 头文件里没有核心名字
+#define CACHE_PROGRAM_BINARY_LENGTH       0x8741
+#define CACHE_NUM_PROGRAM_BINARY_FORMATS  0x87FE
+
+#define CACHE_MAGIC        0x43424750u  // "PGBC"
+#define CACHE_VERSION      1u
+#define CACHE_MAX_BINARY   (16 << 20)   // 超过的文件视为损坏
+
+// 缓存文件头，后面紧跟 length 字节的程序二进制
+typedef struct ProgramCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;        // 与文件名相同，防止改名或截断的文件被误用
+    uint32_t format;     // glGetProgramBinary 返回的 binaryFormat
+    uint32_t length;
+} ProgramCacheHeader;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec * 1e-6;
+}
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *) data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// 字符串连同结尾的 0 一起计入，"ab"+"c" 与 "a"+"bc" 得到不同的哈希；NULL 与空串相同
+static uint64_t fnv1a_string(uint64_t hash, const char *string) {
+    if (string == NULL) {
+        string = "";
+    }
+    return fnv1a(hash, string, strlen(string) + 1);
+}
+
+static int has_extension(const char *name) {
+    const char *extensions = (const char *) glGetString(GL_EXTENSIONS);
+    size_t length = strlen(name);
+    while (extensions != NULL && (extensions = strstr(extensions, name)) != NULL) {
+        if (extensions[length] == ' ' || extensions[length] == 0) {
+            return 1;
+        }
+        extensions += length;
+    }
+    return 0;
+}
+
+int program_cache_init(ProgramCache *cache, const char *dir) {
+    memset(cache, 0, sizeof(*cache));
+    if (dir != NULL) {
+        snprintf(cache->dir, sizeof(cache->dir), "%s", dir);
+    }
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = fnv1a_string(hash, (const char *) glGetString(GL_RENDERER));
+    hash = fnv1a_string(hash, (const char *) glGetString(GL_VERSION));
+    cache->driverHash = hash;
+
+    int major = 0, minor = 0;
+    const char *version = (const char *) glGetString(GL_VERSION);
+    if (version != NULL) {
+        sscanf(version, "OpenGL ES %d.%d", &major, &minor);
+    }
+    if (major >= 3) {
+        cache->core = 1;
+        cache->getBinary = glGetProgramBinary;
+        cache->programBinary = glProgramBinary;
+    } else if (has_extension("GL_OES_get_program_binary")) {
+        cache->getBinary = (ProgramCacheGetBinaryFn) eglGetProcAddress("glGetProgramBinaryOES");
+        cache->programBinary = (ProgramCacheBinaryFn) eglGetProcAddress("glProgramBinaryOES");
+    }
+    GLint formats = 0;
+    if (cache->getBinary != NULL && cache->programBinary != NULL) {
+        glGetIntegerv(CACHE_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    cache->supported = formats > 0;
+    RENDER_LOGI("program cache: %s, %d binary formats, dir [%s]",
+                cache->supported ? (cache->core ? "core" : "OES") : "unsupported", formats, cache->dir);
+    return cache->supported ? 0 : -1;
+}
+
+// defines 插在 #version 行之后（#version 必须是第一行），没有 #version 时放在最前面
+static GLuint compile_shader(GLenum type, const char *source, const char *defines, const char *name) {
+    const char *strings[3];
+    GLint lengths[3];
+    GLsizei count = 0;
+    if (defines != NULL && defines[0] != 0) {
+        const char *body = source;
+        if (strncmp(source, "#version", 8) == 0) {
+            const char *newline = strchr(source, '\n');
+            body = newline != NULL ? newline + 1 : source + strlen(source);
+            strings[count] = source;
+            lengths[count++] = (GLint) (body - source);
+        }
+        strings[count] = defines;
+        lengths[count++] = -1;
+        strings[count] = body;
+        lengths[count++] = -1;
+    } else {
+        strings[count] = source;
+        lengths[count++] = -1;
+    }
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, count, strings, lengths);
+    glCompileShader(shader);
+    GLint compiled = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        GLint infoLen = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen > 1) {
+            char *infoLog = (char *) malloc((size_t) infoLen);
+            glGetShaderInfoLog(shader, infoLen, NULL, infoLog);
+            RENDER_LOGW("Error compiling %s shader [%s]:[%s]", type == GL_VERTEX_SHADER ? "vertex" : "fragment",
+                        name, infoLog);
+            free(infoLog);
+        }
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static GLuint link_source(const ProgramCache *cache, const char *name, const char *vertexSource,
+                          const char *fragmentSource, const char *defines,
+                          const char *const *attributes, int attributeCount, int retrievable) {
+    GLuint vertexShader = compile_shader(GL_VERTEX_SHADER, vertexSource, defines, name);
+    GLuint fragmentShader = compile_shader(GL_FRAGMENT_SHADER, fragmentSource, defines, name);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    for (int i = 0; i < attributeCount; i++) {
+        if (attributes[i] != NULL) {
+            glBindAttribLocation(program, (GLuint) i, attributes[i]);
+        }
+    }
+    if (retrievable && cache->core) {
+        // OES 扩展没有这个提示，二进制总是可取
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLint infoLen = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen > 1) {
+            char *infoLog = (char *) malloc((size_t) infoLen);
+            glGetProgramInfoLog(program, infoLen, NULL, infoLog);
+            RENDER_LOGW("Error linking program [%s]:[%s]", name, infoLog);
+            free(infoLog);
+        }
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// 返回加载成功的程序；文件不存在时 *found 为 0，存在但无法使用时 *found 为 1 并返回 0
+static GLuint load_binary(const ProgramCache *cache, const char *path, uint64_t key, int *found) {
+    *found = 0;
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    *found = 1;
+    ProgramCacheHeader header;
+    void *binary = NULL;
+    GLuint program = 0;
+    if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == CACHE_MAGIC &&
+        header.version == CACHE_VERSION && header.key == key &&
+        header.length > 0 && header.length <= CACHE_MAX_BINARY &&
+        (binary = malloc(header.length)) != NULL && fread(binary, header.length, 1, file) == 1) {
+        program = glCreateProgram();
+        cache->programBinary(program, (GLenum) header.format, binary, (GLsizei) header.length);
+        GLint linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            // 格式不被接受（驱动更新后常见）时 glProgramBinary 会产生 GL_INVALID_ENUM，清掉以免干扰后续检查
+            while (glGetError() != GL_NO_ERROR) {
+            }
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    free(binary);
+    fclose(file);
+    return program;
+}
+
+// 先写临时文件再改名，进程中途被杀也不会留下半个缓存文件
+static int store_binary(const ProgramCache *cache, const char *path, uint64_t key, GLuint program) {
+    // 临时文件名放不下时不缓存：截断的名字会让之后的 rename 写到别处或失败
+    char tempPath[PROGRAM_CACHE_PATH_MAX + 32];
+    int tempLength = snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    if (tempLength < 0 || (size_t) tempLength >= sizeof(tempPath)) {
+        return -1;
+    }
+    GLint length = 0;
+    glGetProgramiv(program, CACHE_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || length > CACHE_MAX_BINARY) {
+        return -1;
+    }
+    void *binary = malloc((size_t) length);
+    if (binary == NULL) {
+        return -1;
+    }
+    ProgramCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    GLenum format = 0;
+    GLsizei written = 0;
+    cache->getBinary(program, length, &written, &format, binary);
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = (uint32_t) written;
+
+    int result = -1;
+    FILE *file = written > 0 ? fopen(tempPath, "wb") : NULL;
+    if (file != NULL) {
+        int ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, (size_t) written, 1, file) == 1;
+        ok = fclose(file) == 0 && ok;
+        if (ok && rename(tempPath, path) == 0) {
+            result = 0;
+        } else {
+            remove(tempPath);
+        }
+    }
+    free(binary);
+    return result;
+}
+
+GLuint program_cache_link(ProgramCache *cache, const char *name, const char *vertexSource,
+                          const char *fragmentSource, const char *defines,
+                          const char *const *attributes, int attributeCount) {
+    int useFiles = cache->supported && cache->dir[0] != 0;
+    char path[PROGRAM_CACHE_PATH_MAX + 32];
+    uint64_t key = cache->driverHash;
+    key = fnv1a_string(key, vertexSource);
+    key = fnv1a_string(key, fragmentSource);
+    key = fnv1a_string(key, defines);
+    for (int i = 0; i < attributeCount; i++) {
+        key = fnv1a_string(key, attributes[i]);
+    }
+
+    int found = 0;
+    if (useFiles) {
+        snprintf(path, sizeof(path), "%sprogram-%016llx.bin", cache->dir, (unsigned long long) key);
+        double start = now_ms();
+        GLuint program = load_binary(cache, path, key, &found);
+        if (program != 0) {
+            double elapsed = now_ms() - start;
+            cache->hits++;
+            cache->warmMs += elapsed;
+            RENDER_LOGI("program [%s]: warm %.2f ms (cache hit)", name, elapsed);
+            return program;
+        }
+        if (found) {
+            RENDER_LOGW("program [%s]: cached binary rejected, recompiling", name);
+            remove(path);
+        }
+    }
+
+    double start = now_ms();
+    GLuint program = link_source(cache, name, vertexSource, fragmentSource, defines, attributes, attributeCount,
+                                 useFiles);
+    double elapsed = now_ms() - start;
+    if (program == 0) {
+        return 0;
+    }
+    if (found) {
+        cache->rejected++;
+    } else {
+        cache->misses++;
+    }
+    cache->coldMs += elapsed;
+    int stored = useFiles && store_binary(cache, path, key, program) == 0;
+    if (stored) {
+        cache->stored++;
+    }
+    RENDER_LOGI("program [%s]: cold %.2f ms (%s)", name, elapsed,
+                stored ? "stored" : (useFiles ? "store failed" : "not cached"));
+    return program;
+}
+
+void program_cache_log(const ProgramCache *cache) {
+    int cold = cache->misses + cache->rejected;
+    RENDER_LOGI("program cache: %d hits (avg %.2f ms), %d compiled (avg %.2f ms, %d rejected), %d stored",
+                cache->hits, cache->hits > 0 ? cache->warmMs / cache->hits : 0.0,
+                cold, cold > 0 ? cache->coldMs / cold : 0.0, cache->rejected, cache->stored);
+}
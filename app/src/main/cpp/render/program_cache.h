@@ -0,0 +1,59 @@
+#ifndef NATIVE_ACTIVITY_PROGRAM_CACHE_H
+#define NATIVE_ACTIVITY_PROGRAM_CACHE_H
+
+#include <stdint.h>
+#include <GLES3/gl3.h>
+
+// ---------- 着色器程序二进制缓存 ----------
+// 每次创建表面都从源码编译、链接着色器，在 Android 上暂停/恢复后要重复整套编译。
+// 这里把链接好的程序用 glGetProgramBinary 取出，存到缓存目录（fc_cachedir）下，
+// 文件名是源码、defines、属性绑定、GL_RENDERER 和 GL_VERSION 的 64 位 FNV-1a 哈希，
+// 驱动升级或源码改动后自然换成新文件。加载时用 glProgramBinary，
+// 格式不匹配（驱动拒绝、文件损坏）时删除该文件并回退到编译，编译结果再写回缓存。
+// ES 3.0 上使用核心函数，ES 2.0 上使用 GL_OES_get_program_binary，两者都不可用时只编译。
+// 纯 C 实现，供 main.cpp 与 GLFM 示例（typing.c）共用。
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROGRAM_CACHE_PATH_MAX 512
+
+typedef void (GL_APIENTRYP ProgramCacheGetBinaryFn)(GLuint program, GLsizei bufSize, GLsizei *length,
+                                                     GLenum *binaryFormat, void *binary);
+typedef void (GL_APIENTRYP ProgramCacheBinaryFn)(GLuint program, GLenum binaryFormat, const void *binary,
+                                                  GLsizei length);
+
+typedef struct ProgramCache {
+    char dir[PROGRAM_CACHE_PATH_MAX];  // 缓存目录（含结尾的 /），空串时只编译、不读写文件
+    int supported;                     // 上下文支持程序二进制且至少有一种格式
+    int core;                          // 1 为 ES 3.0 核心函数，0 为 OES 扩展
+    uint64_t driverHash;               // GL_RENDERER 与 GL_VERSION 的哈希
+    ProgramCacheGetBinaryFn getBinary;
+    ProgramCacheBinaryFn programBinary;
+    int hits;                          // 从缓存加载成功
+    int misses;                        // 没有缓存文件，编译
+    int rejected;                      // 有缓存文件但驱动拒绝，编译并覆盖
+    int stored;                        // 写入的缓存文件数
+    double warmMs;                     // 加载成功的累计耗时
+    double coldMs;                     // 编译链接的累计耗时（不含写文件）
+} ProgramCache;
+
+// 在当前上下文中初始化，dir 为缓存目录（fc_cachedir 的结果，可为 NULL 或空串）。
+// 上下文不支持程序二进制时返回 -1，此后 program_cache_link 退化为普通编译。
+int program_cache_init(ProgramCache *cache, const char *dir);
+
+// 取得链接好的程序：先查缓存，失败时编译。defines 插在 #version 行之后（可为 NULL），
+// attributes[i] 在链接前绑定到位置 i（可为 NULL）。name 只用于日志。失败返回 0
+GLuint program_cache_link(ProgramCache *cache, const char *name, const char *vertexSource,
+                          const char *fragmentSource, const char *defines,
+                          const char *const *attributes, int attributeCount);
+
+// 输出命中/编译次数和冷、热两种路径的平均耗时
+void program_cache_log(const ProgramCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //NATIVE_ACTIVITY_PROGRAM_CACHE_H
@@ -0,0 +1,15 @@
+#ifndef NATIVE_ACTIVITY_RENDER_LOG_H
+#define NATIVE_ACTIVITY_RENDER_LOG_H
+
+// render/ 下的模块在 Android 上写 logcat，在宿主机（基准/校验程序）上写 stderr
+#if defined(__ANDROID__)
+#include <android/log.h>
+#define RENDER_LOGI(...) ((void)__android_log_print(ANDROID_LOG_INFO, "native-activity", __VA_ARGS__))
+#define RENDER_LOGW(...) ((void)__android_log_print(ANDROID_LOG_WARN, "native-activity", __VA_ARGS__))
+#else
+#include <stdio.h>
+#define RENDER_LOGI(...) ((void)fprintf(stderr, __VA_ARGS__), (void)fputc('\n', stderr))
+#define RENDER_LOGW(...) ((void)fprintf(stderr, __VA_ARGS__), (void)fputc('\n', stderr))
+#endif
+
+#endif //NATIVE_ACTIVITY_RENDER_LOG_H
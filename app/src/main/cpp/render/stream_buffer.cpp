@@ -0,0 +1,118 @@
+#include "stream_buffer.h"
+
+#include <cstring>
+
+#include "render_log.h"
+
+// 等待 fence 的上限（纳秒），避免驱动异常时永久阻塞
+#define STREAM_FENCE_TIMEOUT_NS 1000000000ull
+
+static GLsizeiptr align_up(GLsizeiptr value, GLsizeiptr alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static void delete_fences(StreamBuffer *stream) {
+    for (int i = 0; i < STREAM_BUFFER_REGIONS; i++) {
+        if (stream->fences[i] != nullptr) {
+            glDeleteSync(stream->fences[i]);
+            stream->fences[i] = nullptr;
+        }
+    }
+}
+
+static void allocate_storage(StreamBuffer *stream) {
+    glBufferData(stream->target, stream->regionSize * STREAM_BUFFER_REGIONS, nullptr, GL_STREAM_DRAW);
+}
+
+int stream_buffer_init(StreamBuffer *stream, GLenum target, GLsizeiptr regionSize,
+                       GLsizeiptr alignment, int mode) {
+    memset(stream, 0, sizeof(*stream));
+    if (alignment <= 0) {
+        alignment = 1;
+    }
+    stream->target = target;
+    stream->mode = mode;
+    stream->alignment = alignment;
+    stream->regionSize = align_up(regionSize > 0 ? regionSize : alignment, alignment);
+    glGenBuffers(1, &stream->buffer);
+    if (stream->buffer == 0) {
+        return -1;
+    }
+    glBindBuffer(target, stream->buffer);
+    allocate_storage(stream);
+    return 0;
+}
+
+void stream_buffer_free(StreamBuffer *stream) {
+    if (stream->buffer != 0) {
+        delete_fences(stream);
+        glDeleteBuffers(1, &stream->buffer);
+    }
+    memset(stream, 0, sizeof(*stream));
+}
+
+void *stream_buffer_map(StreamBuffer *stream, GLsizeiptr bytes, GLintptr *offset) {
+    if (stream->buffer == 0 || bytes <= 0) {
+        return nullptr;
+    }
+    glBindBuffer(stream->target, stream->buffer);
+
+    if (bytes > stream->regionSize) {
+        // 扩容：重新分配存储（旧存储由驱动在 GPU 用完后回收），所有段重新开始
+        stream->regionSize = align_up(bytes + bytes / 2, stream->alignment);
+        delete_fences(stream);
+        allocate_storage(stream);
+        stream->region = 0;
+        stream->orphans++;
+    }
+
+    void *ptr = nullptr;
+    if (stream->mode == STREAM_BUFFER_UNSYNCHRONIZED) {
+        GLsync fence = stream->fences[stream->region];
+        if (fence != nullptr) {
+            // 先不等待地查询一次，只有 GPU 仍在读这一段时才算 stall
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED) {
+                stream->stalls++;
+                glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_FENCE_TIMEOUT_NS);
+            }
+            glDeleteSync(fence);
+            stream->fences[stream->region] = nullptr;
+        }
+        *offset = (GLintptr) stream->region * stream->regionSize;
+        ptr = glMapBufferRange(stream->target, *offset, bytes,
+                               GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        if (ptr == nullptr) {
+            RENDER_LOGW("unsynchronized map failed, falling back to orphaning");
+            delete_fences(stream);
+            stream->mode = STREAM_BUFFER_ORPHAN;
+        }
+    }
+    if (stream->mode == STREAM_BUFFER_ORPHAN) {
+        // 重新指定存储，驱动给出新内存，不必等待仍在使用旧内存的绘制
+        allocate_storage(stream);
+        stream->orphans++;
+        *offset = 0;
+        ptr = glMapBufferRange(stream->target, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    }
+    if (ptr != nullptr) {
+        stream->mapped = 1;
+        stream->bytesUploaded += (uint64_t) bytes;
+    }
+    return ptr;
+}
+
+void stream_buffer_unmap(StreamBuffer *stream) {
+    if (stream->mapped) {
+        glBindBuffer(stream->target, stream->buffer);
+        glUnmapBuffer(stream->target);
+        stream->mapped = 0;
+    }
+}
+
+void stream_buffer_advance(StreamBuffer *stream) {
+    if (stream->mode == STREAM_BUFFER_UNSYNCHRONIZED) {
+        stream->fences[stream->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        stream->region = (stream->region + 1) % STREAM_BUFFER_REGIONS;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef NATIVE_ACTIVITY_STREAM_BUFFER_H
+#define NATIVE_ACTIVITY_STREAM_BUFFER_H
+
+#include <GLES3/gl3.h>
+#include <stdint.h>
+
+// ---------- 流式顶点缓冲 ----------
+// 一个缓冲对象分成 STREAM_BUFFER_REGIONS 段，每帧写下一段：
+// 以 UNSYNCHRONIZED | INVALIDATE_RANGE 映射直接写入，画完后插入 fence，
+// 轮回到同一段时只有 fence 尚未完成才需要等待（计为一次 stall）。
+// 映射失败的驱动退回整块 orphan（glBufferData(NULL) 后再写入）。
+
+#define STREAM_BUFFER_REGIONS 3
+
+enum StreamBufferMode {
+    STREAM_BUFFER_UNSYNCHRONIZED,
+    STREAM_BUFFER_ORPHAN
+};
+
+typedef struct StreamBuffer {
+    GLenum target;
+    GLuint buffer;
+    int mode;
+    GLsizeiptr regionSize;      // 每段字节数，是 alignment 的整数倍
+    GLsizeiptr alignment;       // 段起点对齐（通常为顶点步长）
+    int region;                 // 当前写入的段
+    GLsync fences[STREAM_BUFFER_REGIONS];
+    int mapped;
+
+    // 统计
+    uint64_t bytesUploaded;
+    uint32_t stalls;            // 需要等待 GPU 释放段的次数
+    uint32_t orphans;           // orphan 次数（退回模式或扩容）
+} StreamBuffer;
+
+// 创建缓冲，regionSize 为每帧预计的最大字节数，成功返回 0
+int stream_buffer_init(StreamBuffer *stream, GLenum target, GLsizeiptr regionSize,
+                       GLsizeiptr alignment, int mode);
+void stream_buffer_free(StreamBuffer *stream);
+
+// 为本帧申请 bytes 字节并映射，*offset 返回在缓冲中的偏移（alignment 的整数倍）。
+// 返回的缓冲已绑定到 target。失败返回 NULL。
+void *stream_buffer_map(StreamBuffer *stream, GLsizeiptr bytes, GLintptr *offset);
+void stream_buffer_unmap(StreamBuffer *stream);
+
+// 使用本段的绘制命令提交之后调用：插入 fence 并切到下一段
+void stream_buffer_advance(StreamBuffer *stream);
+
+#endif //NATIVE_ACTIVITY_STREAM_BUFFER_H
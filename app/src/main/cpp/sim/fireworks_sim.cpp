@@ -0,0 +1,595 @@
+#include "fireworks_sim.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "particle_emitter.h"
+
+// ---------- 场景常量 ----------
+#define ROCKET_LIFETIME      1.8f
+#define EXPLOSION_COUNT      35
+#define TRAIL_COUNT          3     // 每个火箭每个模拟步产生尾迹粒子数
+#define FIREWORK_COOLDOWN    0.25f // 生成火箭的间隔
+#define TEXT_PARTICLE_COUNT  1200  // 文字爆炸粒子数
+#define JOB_GRAIN            1024  // 并行积分/打包时每块的粒子数（PARTICLE_SIMD_WIDTH 的倍数）
+#define TRAIL_SIZE_DECAY     0.046f // 尾迹每秒尺寸系数（原来每帧 *0.95，按 60Hz 折算 0.95^60）
+
+int fireworks_sim_init(FireworksSim *sim, int capacity, int maxCapacity, int spawnBudget,
+                       JobSystem *jobs, uint64_t seed) {
+    memset(sim, 0, sizeof(*sim));
+    sim->profileFrame = FRAME_PROFILER_CURRENT;
+    if (particle_pool_reserve(&sim->particles, capacity, maxCapacity, PARTICLE_ARENA_HUGE_PAGES) != 0 ||
+        particle_spawn_init(&sim->spawns, spawnBudget) != 0 ||
+        particle_spawn_init(&sim->gpuSpawns, spawnBudget) != 0) {
+        fireworks_sim_free(sim);
+        return -1;
+    }
+    sim->jobs = jobs;
+    sim->aspect = 1.0f;
+    sim->quality.emission = 1.0f;
+    sim->quality.cooldown = 1.0f;
+    sim->quality.size = 1.0f;
+    particle_random_seed(&sim->rng, seed, 0);
+    return 0;
+}
+
+void fireworks_sim_free(FireworksSim *sim) {
+    free(sim->cullVertices);
+    free(sim->cullTiny);
+    free(sim->cullChunkKept);
+    free(sim->cullChunkTiny);
+    free(sim->cullChunkStats);
+    particle_tile_merge_free(&sim->tileMerge);
+    particle_grid_free(&sim->grid);
+    particle_spawn_free(&sim->gpuSpawns);
+    particle_spawn_free(&sim->spawns);
+    particle_pool_free(&sim->particles);
+}
+
+void fireworks_sim_set_quality(FireworksSim *sim, const FireworksQuality *quality) {
+    sim->quality = *quality;
+}
+
+static void gpu_expiry_reset(FireworksSim *sim) {
+    sim->gpuLive = 0;
+    memset(sim->gpuExpiry, 0, sizeof(sim->gpuExpiry));
+    sim->gpuExpiryClock = 0.0f;
+    sim->gpuStepFirst = 0;
+}
+
+void fireworks_sim_set_gpu_resident(FireworksSim *sim, int resident) {
+    sim->gpuResident = resident;
+    particle_spawn_reset(&sim->gpuSpawns);
+    gpu_expiry_reset(sim);
+}
+
+void fireworks_sim_set_interaction(FireworksSim *sim, const FireworksInteraction *interaction) {
+    sim->interaction = *interaction;
+    if (sim->interaction.attractorCount > PARTICLE_MAX_ATTRACTORS) {
+        sim->interaction.attractorCount = PARTICLE_MAX_ATTRACTORS;
+    }
+}
+
+// 按画质系数缩放的粒子数，至少 1 个
+static int scaled_count(const FireworksSim *sim, int count) {
+    int scaled = (int) (count * sim->quality.emission + 0.5f);
+    return scaled > 1 ? scaled : 1;
+}
+
+void fireworks_sim_set_text_cloud(FireworksSim *sim, const GlyphCloud *cloud) {
+    if (cloud != nullptr) {
+        sim->textCloud = *cloud;
+    } else {
+        memset(&sim->textCloud, 0, sizeof(sim->textCloud));
+    }
+}
+
+// ---------- 发射 ----------
+
+// GPU 后端下除火箭外的粒子进入 gpuSpawns，由调用方上传
+static ParticleSpawnBuffer *spawn_buffer_for(FireworksSim *sim, int type) {
+    if (sim->gpuResident && type != PARTICLE_ROCKET) {
+        return &sim->gpuSpawns;
+    }
+    return &sim->spawns;
+}
+
+static void add_particle(FireworksSim *sim, const Particle *p) {
+    particle_spawn_push(spawn_buffer_for(sim, p->type), p);
+}
+
+// 生成一枚上升火箭
+static void spawn_rocket(FireworksSim *sim) {
+    Particle r;
+    float u[6];
+    particle_random_fill(&sim->rng, u, 6);
+    float aspect = sim->aspect;
+    r.x = u[0] * 2.0f * aspect - aspect; // 屏幕宽度范围
+    r.y = -1.0f; // 底部
+    r.vx = (u[1] - 0.5f) * 0.1f;
+    r.vy = u[2] * 0.8f + 0.8f; // 向上速度
+    r.ax = 0.0f;
+    r.ay = 0.2f; // 减速（模拟重力）
+    r.r = u[3] * 0.5f + 0.5f;
+    r.g = u[4] * 0.3f + 0.7f;
+    r.b = u[5] * 0.2f + 0.8f;
+    r.a = 1.0f;
+    r.size = 8.0f * sim->quality.size;
+    r.life = ROCKET_LIFETIME;
+    r.maxLife = ROCKET_LIFETIME;
+    r.alphaScale = 1.0f;
+    r.sizeDecay = 1.0f;
+    r.type = PARTICLE_ROCKET;
+    add_particle(sim, &r);
+}
+
+// 火箭爆炸，生成爆炸粒子（圆形爆发，批量写入发射缓冲）
+static void explode(FireworksSim *sim, float x, float y, float r, float g, float b) {
+    ParticleEmitter e;
+    e.x = x;
+    e.y = y;
+    e.jitter = 0.0f;
+    e.ax = 0.0f;
+    e.ay = 0.5f; // 重力
+    e.r = r;
+    e.g = g;
+    e.b = b;
+    e.a = 1.0f;
+    e.colorJitter = 0.0f;
+    e.sizeMin = 4.0f * sim->quality.size;
+    e.sizeMax = 10.0f * sim->quality.size;
+    e.lifeMin = 0.8f;
+    e.lifeMax = 2.3f;
+    e.alphaScale = 1.0f;
+    e.sizeDecay = 1.0f;
+    e.type = PARTICLE_EXPLOSION;
+    particle_emit_burst(spawn_buffer_for(sim, e.type), &e, 0.5f, 2.0f, scaled_count(sim, EXPLOSION_COUNT),
+                        &sim->rng);
+}
+
+// 生成尾迹粒子（火箭拖尾，发射点附近抖动）
+static void spawn_trail(FireworksSim *sim, float x, float y, float r, float g, float b) {
+    ParticleEmitter e;
+    e.x = x;
+    e.y = y;
+    e.jitter = 0.05f;
+    e.ax = 0.0f;
+    e.ay = 0.1f;
+    e.r = r;
+    e.g = g;
+    e.b = b;
+    e.a = 0.7f;
+    e.colorJitter = 0.0f;
+    e.sizeMin = 2.0f * sim->quality.size;
+    e.sizeMax = 6.0f * sim->quality.size;
+    e.lifeMin = 0.4f;
+    e.lifeMax = 0.4f;
+    e.alphaScale = 0.8f;   // 尾迹更淡
+    e.sizeDecay = TRAIL_SIZE_DECAY; // 尾迹逐步缩小
+    e.type = PARTICLE_TRAIL;
+    // 降画质时每步的尾迹数不是整数，小数部分累计到后面的步
+    sim->trailCarry += TRAIL_COUNT * sim->quality.emission;
+    int count = (int) sim->trailCarry;
+    sim->trailCarry -= (float) count;
+    if (count > 0) {
+        particle_emit_jitter(spawn_buffer_for(sim, e.type), &e, -0.05f, 0.05f, -0.1f, 0.1f,
+                             count, &sim->rng);
+    }
+}
+
+// 从点云整列拷贝出文字粒子：真实字形，发射开销只是几次 memcpy 和一遍随机属性
+static void spawn_text_cloud(FireworksSim *sim) {
+    ParticleEmitter e;
+    e.x = 0.0f;
+    e.y = 0.0f;
+    e.jitter = 0.0f;
+    e.ax = 0.0f;
+    e.ay = 0.2f; // 轻微重力
+    e.r = e.g = e.b = 1.0f;
+    e.a = 1.0f;
+    e.colorJitter = 0.8f; // 多彩颜色：每通道 [0.2, 1)
+    e.sizeMin = 6.0f * sim->quality.size;
+    e.sizeMax = 18.0f * sim->quality.size;
+    e.lifeMin = 1.0f;
+    e.lifeMax = 3.0f;
+    e.alphaScale = 1.0f;
+    e.sizeDecay = 1.0f;
+    e.type = PARTICLE_TEXT;
+    // 文字高 0.35，窄屏时缩小到屏幕宽度的 90% 以内
+    float scale = 0.35f;
+    if (scale * sim->textCloud.extentX > 0.9f * sim->aspect) {
+        scale = 0.9f * sim->aspect / sim->textCloud.extentX;
+    }
+    particle_emit_cloud(spawn_buffer_for(sim, e.type), &e, &sim->textCloud, scale, 0.15f, 0.65f,
+                        scaled_count(sim, TEXT_PARTICLE_COUNT), &sim->rng);
+}
+
+// ---------- 生成文字“新年快乐”的粒子（爆炸效果）----------
+static void spawn_text_particles(FireworksSim *sim) {
+    if (sim->textCloud.count > 0) {
+        spawn_text_cloud(sim);
+        return;
+    }
+
+    // 没有点云资源时的近似形状
+    // 简化：四个字“新年快乐”用点阵粗略表示
+    // 每个字大约 0.2x0.3，四个字横向排列
+    float aspect = sim->aspect;
+    // 每个粒子 9 个随机数，按 batch 个粒子一批生成
+    const int batch = 64;
+    float random[batch * 9];
+    const int count = scaled_count(sim, TEXT_PARTICLE_COUNT);
+    for (int i = 0; i < count; i++) {
+        if (i % batch == 0) {
+            particle_random_fill(&sim->rng, random, batch * 9);
+        }
+        const float *u = &random[(i % batch) * 9];
+        Particle p;
+        // 随机选择四个字中的一个
+        int charIdx = (int) (u[0] * 4.0f);
+        float baseX = -0.6f + charIdx * 0.4f; // 大致位置
+        float baseY = 0.0f;
+
+        // 在字的区域内随机偏移
+        float cx = u[1] * 0.25f - 0.125f;
+        float cy = u[2] * 0.35f - 0.175f;
+
+        // 为不同字添加简单轮廓形状
+        if (charIdx == 0) { // 新
+            cx = sinf(cx * 10) * 0.1f; // 简单装饰
+        } else if (charIdx == 1) { // 年
+            cy = cosf(cy * 8) * 0.08f;
+        } else if (charIdx == 2) { // 快
+            cx = fabsf(cx) - 0.05f;
+        } else { // 乐
+            cy = fabsf(cy) - 0.05f;
+        }
+
+        p.x = (baseX + cx) * aspect; // 考虑屏幕比例
+        p.y = baseY + cy;
+
+        // 爆炸速度向外
+        float angle = atan2f(p.y - baseY, p.x - baseX);
+        float speed = u[3] * 1.0f + 0.3f;
+        p.vx = cosf(angle) * speed * 0.5f;
+        p.vy = sinf(angle) * speed * 0.5f;
+        p.ax = 0.0f;
+        p.ay = 0.2f; // 轻微重力
+
+        // 多彩颜色
+        p.r = u[4] * 0.8f + 0.2f;
+        p.g = u[5] * 0.8f + 0.2f;
+        p.b = u[6] * 0.8f + 0.2f;
+        p.a = 1.0f;
+        p.size = (u[7] * 12.0f + 6.0f) * sim->quality.size;
+        p.life = u[8] * 2.0f + 1.0f;
+        p.maxLife = p.life;
+        p.alphaScale = 1.0f;
+        p.sizeDecay = 1.0f;
+        p.type = PARTICLE_TEXT;
+        add_particle(sim, &p);
+    }
+}
+
+int fireworks_sim_spawn(FireworksSim *sim, float dt) {
+    PROFILE_SCOPE_AT(sim->profiler, sim->profileFrame, PROFILE_SPAWN);
+    int events = 0;
+    sim->totalTime += dt;
+    sim->gpuStepFirst = sim->gpuSpawns.staged.count;
+
+    // 文字出现后 FIREWORKS_EXIT_DELAY 秒结束
+    if (sim->textSpawned) {
+        sim->exitTimer -= dt;
+        if (sim->exitTimer <= 0.0f && !sim->finished) {
+            sim->finished = 1;
+            events |= FIREWORKS_EVENT_FINISHED;
+        }
+    }
+
+    // 触发文字爆炸：清空其余粒子，只保留文字
+    if (!sim->textSpawned && sim->totalTime >= FIREWORKS_TEXT_TIME) {
+        particle_pool_clear(&sim->particles);
+        particle_spawn_reset(&sim->spawns);
+        particle_spawn_reset(&sim->gpuSpawns);
+        gpu_expiry_reset(sim);   // 调用方收到 FIREWORKS_EVENT_TEXT 后清空 GPU 粒子
+        spawn_text_particles(sim);
+        sim->textSpawned = 1;
+        sim->exitTimer = FIREWORKS_EXIT_DELAY;
+        events |= FIREWORKS_EVENT_TEXT;
+    }
+
+    // 生成新的火箭（如果不处于文字阶段）
+    if (!sim->textSpawned) {
+        sim->fireworkTimer -= dt;
+        while (sim->fireworkTimer <= 0.0f) {
+            spawn_rocket(sim);
+            sim->fireworkTimer += FIREWORK_COOLDOWN * sim->quality.cooldown;
+        }
+    }
+    return events;
+}
+
+// ---------- 分块并行任务 ----------
+struct integrate_job_ctx {
+    ParticlePool *pool;
+    float deltaTime;
+    float fieldX, fieldY;
+    const ParticleBounds *bounds;   // NULL 时不反弹
+};
+
+static void integrate_job(void *ctx, int begin, int end) {
+    auto *job = (struct integrate_job_ctx *) ctx;
+    particle_integrate_field_range(job->pool, begin, end, job->deltaTime, job->fieldX, job->fieldY);
+    if (job->bounds != nullptr) {
+        particle_bounce_range(job->pool, job->bounds, begin, end);
+    }
+}
+
+struct forces_job_ctx {
+    ParticlePool *pool;
+    const FireworksInteraction *interaction;
+    const ParticleGrid *grid;
+    ParticleCollision collision;
+    float deltaTime;
+};
+
+static void attract_job(void *ctx, int begin, int end) {
+    auto *job = (struct forces_job_ctx *) ctx;
+    particle_attract_range(job->pool, job->interaction->attractors, job->interaction->attractorCount,
+                           begin, end, job->deltaTime);
+}
+
+// 区间是网格排序后的下标
+static void collide_job(void *ctx, int begin, int end) {
+    auto *job = (struct forces_job_ctx *) ctx;
+    particle_collide_range(job->pool, job->grid, &job->collision, begin, end, job->deltaTime);
+}
+
+struct pack_job_ctx {
+    const ParticlePool *pool;
+    float alpha;
+    ParticleVertex *vertices;
+};
+
+static void pack_job(void *ctx, int begin, int end) {
+    auto *job = (struct pack_job_ctx *) ctx;
+    particle_pack_range(job->pool, begin, end, job->alpha, job->vertices);
+}
+
+// 打包到中间缓冲后就地剔除，按 JOB_GRAIN 分块压实（单线程时整个区间一次传进来，仍逐块处理）
+struct cull_job_ctx {
+    const ParticlePool *pool;
+    float alpha;
+    const ParticleCullParams *params;
+    ParticleVertex *vertices;
+    int32_t *tiny;
+    int *chunkKept;
+    int *chunkTiny;
+    ParticleCullStats *chunkStats;
+};
+
+static void cull_job(void *ctx, int begin, int end) {
+    auto *job = (struct cull_job_ctx *) ctx;
+    particle_pack_range(job->pool, begin, end, job->alpha, job->vertices);
+    for (int first = begin; first < end; first += JOB_GRAIN) {
+        int last = first + JOB_GRAIN < end ? first + JOB_GRAIN : end;
+        int chunk = first / JOB_GRAIN;
+        memset(&job->chunkStats[chunk], 0, sizeof(ParticleCullStats));
+        job->chunkKept[chunk] = particle_cull_range(job->pool, first, last, job->alpha, job->params,
+                                                    job->vertices, job->tiny, &job->chunkTiny[chunk],
+                                                    &job->chunkStats[chunk]);
+    }
+}
+
+// 按粒子数扩大剔除临时数组，失败返回 -1
+static int reserve_cull_scratch(FireworksSim *sim, int count) {
+    if (count > sim->cullTinyCapacity) {
+        int capacity = sim->particles.capacity > count ? sim->particles.capacity : count;
+        auto *tiny = (int32_t *) realloc(sim->cullTiny, (size_t) capacity * sizeof(int32_t));
+        if (tiny != nullptr) {
+            sim->cullTiny = tiny;
+        }
+        auto *vertices = (ParticleVertex *) realloc(sim->cullVertices, (size_t) capacity * sizeof(ParticleVertex));
+        if (vertices != nullptr) {
+            sim->cullVertices = vertices;
+        }
+        if (tiny == nullptr || vertices == nullptr) {
+            return -1;
+        }
+        sim->cullTinyCapacity = capacity;
+    }
+    int chunks = (sim->cullTinyCapacity + JOB_GRAIN - 1) / JOB_GRAIN;
+    if (chunks > sim->cullChunkCapacity) {
+        auto *kept = (int *) realloc(sim->cullChunkKept, (size_t) chunks * sizeof(int));
+        if (kept != nullptr) {
+            sim->cullChunkKept = kept;
+        }
+        auto *tinyCounts = (int *) realloc(sim->cullChunkTiny, (size_t) chunks * sizeof(int));
+        if (tinyCounts != nullptr) {
+            sim->cullChunkTiny = tinyCounts;
+        }
+        auto *stats = (ParticleCullStats *) realloc(sim->cullChunkStats, (size_t) chunks * sizeof(ParticleCullStats));
+        if (stats != nullptr) {
+            sim->cullChunkStats = stats;
+        }
+        if (kept == nullptr || tinyCounts == nullptr || stats == nullptr) {
+            return -1;
+        }
+        sim->cullChunkCapacity = chunks;
+    }
+    return 0;
+}
+
+// 丢弃 staged 中 first 之后超出 room 的请求，room 扣除保留的数量
+static void cap_spawns(FireworksSim *sim, ParticlePool *staged, int first, int *room) {
+    int added = staged->count - first;
+    if (added > *room) {
+        sim->cappedSpawns += added - *room;
+        staged->count = first + *room;
+        added = *room;
+    }
+    *room -= added;
+}
+
+// GPU 存活粒子数的估计：时间前进，到期的槽从存活数中扣除
+static void gpu_expiry_advance(FireworksSim *sim, float dt) {
+    sim->gpuExpiryClock += dt;
+    while (sim->gpuExpiryClock >= FIREWORKS_GPU_EXPIRY_STEP) {
+        sim->gpuExpiryClock -= FIREWORKS_GPU_EXPIRY_STEP;
+        sim->gpuExpiryCursor = (sim->gpuExpiryCursor + 1) % FIREWORKS_GPU_EXPIRY_SLOTS;
+        sim->gpuLive -= sim->gpuExpiry[sim->gpuExpiryCursor];
+        sim->gpuExpiry[sim->gpuExpiryCursor] = 0;
+    }
+}
+
+// 把 gpuSpawns 中 first 之后的请求按寿命记入到期的槽（向上取整，宁可多算）
+static void gpu_expiry_add(FireworksSim *sim, int first) {
+    const ParticlePool *staged = &sim->gpuSpawns.staged;
+    for (int i = first; i < staged->count; i++) {
+        int slots = (int) ceilf(staged->life[i] / FIREWORKS_GPU_EXPIRY_STEP);
+        slots = slots < 1 ? 1 : (slots > FIREWORKS_GPU_EXPIRY_SLOTS - 1 ? FIREWORKS_GPU_EXPIRY_SLOTS - 1 : slots);
+        sim->gpuExpiry[(sim->gpuExpiryCursor + slots) % FIREWORKS_GPU_EXPIRY_SLOTS]++;
+    }
+    sim->gpuLive += staged->count - first;
+}
+
+void fireworks_sim_update(FireworksSim *sim, float dt) {
+    PROFILE_SCOPE_AT(sim->profiler, sim->profileFrame, PROFILE_UPDATE);
+    ParticlePool *pool = &sim->particles;
+
+    // 交互力：吸引点逐粒子计算；碰撞按本步开始时的位置重建网格，再按格的顺序处理屏幕内的火花。
+    // 两遍都只读位置、写各自粒子的速度
+    const FireworksInteraction *interaction = &sim->interaction;
+    struct forces_job_ctx forces = { pool, interaction, &sim->grid,
+                                     { interaction->collisionRadius, interaction->collisionStiffness }, dt };
+    if (interaction->attractorCount > 0) {
+        job_system_parallel_for(sim->jobs, pool->count, JOB_GRAIN, attract_job, &forces);
+    }
+    if (interaction->collisionRadius > 0.0f &&
+        particle_grid_build(&sim->grid, pool, -sim->aspect, -1.0f, sim->aspect, 1.0f, interaction->collisionRadius,
+                            1u << PARTICLE_EXPLOSION) == 0) {
+        job_system_parallel_for(sim->jobs, sim->grid.count, JOB_GRAIN, collide_job, &forces);
+    }
+
+    // 物理积分与淡出（SIMD 内核，按块分给各工作线程，每块只写自己的区间），需要时随后在同一块里反弹
+    ParticleBounds bounds = { -sim->aspect, sim->aspect, -1.0f, interaction->restitution };
+    struct integrate_job_ctx integrate = { pool, dt, sim->fieldX, sim->fieldY,
+                                           interaction->bounce ? &bounds : nullptr };
+    job_system_parallel_for(sim->jobs, pool->count, JOB_GRAIN, integrate_job, &integrate);
+    particle_pool_advance(pool, dt);
+
+    for (int i = pool->count - 1; i >= 0; i--) {
+        // 火箭特殊处理：到达顶部或生命周期结束时爆炸（新粒子只进入发射缓冲）
+        if (pool->type[i] == PARTICLE_ROCKET && pool->life[i] > 0.0f) {
+            float x = pool->x[i], y = pool->y[i];
+            float r = pool->r[i], g = pool->g[i], b = pool->b[i];
+            // 产生尾迹
+            spawn_trail(sim, x, y, r, g, b);
+            // 如果超出顶部或生命快结束，爆炸
+            if (y > 1.2f || pool->life[i] < 0.2f) {
+                explode(sim, x, y, r, g, b);
+                pool->life[i] = 0.0f; // 标记删除
+            }
+        }
+
+        if (pool->life[i] <= 0.0f) {
+            // 移除粒子
+            particle_pool_remove(pool, i);
+        }
+    }
+
+    // 存活粒子上限：超出部分从最后发射的请求（尾迹、爆炸）开始丢弃，本步的火箭最先写入。
+    // GPU 常驻时剩余的名额再分给本步新增的 gpuSpawns
+    gpu_expiry_advance(sim, dt);
+    ParticlePool *gpuStaged = &sim->gpuSpawns.staged;
+    int gpuFirst = sim->gpuStepFirst < gpuStaged->count ? sim->gpuStepFirst : gpuStaged->count;
+    if (sim->quality.maxParticles > 0) {
+        int live = pool->count + sim->gpuLive;
+        int room = sim->quality.maxParticles > live ? sim->quality.maxParticles - live : 0;
+        cap_spawns(sim, &sim->spawns.staged, 0, &room);
+        cap_spawns(sim, gpuStaged, gpuFirst, &room);
+    }
+    gpu_expiry_add(sim, gpuFirst);
+    sim->gpuStepFirst = gpuStaged->count;
+
+    // 批量写入本步产生的新粒子
+    particle_spawn_apply(pool, &sim->spawns);
+}
+
+int fireworks_sim_step(FireworksSim *sim, float dt) {
+    int events = fireworks_sim_spawn(sim, dt);
+    fireworks_sim_update(sim, dt);
+    return events;
+}
+
+int fireworks_sim_pack(FireworksSim *sim, float alpha, const ParticleCullParams *cull,
+                       ParticleVertex *out, ParticleCullStats *stats) {
+    const int count = sim->particles.count;
+    if (cull == nullptr || reserve_cull_scratch(sim, count) != 0) {
+        PROFILE_SCOPE_AT(sim->profiler, sim->profileFrame, PROFILE_PACK);
+        struct pack_job_ctx pack = { &sim->particles, alpha, out };
+        job_system_parallel_for(sim->jobs, count, JOB_GRAIN, pack_job, &pack);
+        return count;
+    }
+
+    {
+        PROFILE_SCOPE_AT(sim->profiler, sim->profileFrame, PROFILE_PACK);
+        struct cull_job_ctx job = {
+            &sim->particles, alpha, cull, sim->cullVertices, sim->cullTiny,
+            sim->cullChunkKept, sim->cullChunkTiny, sim->cullChunkStats
+        };
+        job_system_parallel_for(sim->jobs, count, JOB_GRAIN, cull_job, &job);
+    }
+
+    PROFILE_SCOPE_AT(sim->profiler, sim->profileFrame, PROFILE_CULL);
+    // 各块保留的顶点顺序写入 out（映射的 GL 缓冲只写不读），过小粒子下标前移拼成连续区间
+    ParticleCullStats total = {};
+    int written = 0, tinyCount = 0;
+    const int chunks = (count + JOB_GRAIN - 1) / JOB_GRAIN;
+    for (int c = 0; c < chunks; c++) {
+        const int begin = c * JOB_GRAIN;
+        memcpy(out + written, sim->cullVertices + begin, (size_t) sim->cullChunkKept[c] * sizeof(ParticleVertex));
+        if (tinyCount != begin) {
+            memmove(sim->cullTiny + tinyCount, sim->cullTiny + begin, (size_t) sim->cullChunkTiny[c] * sizeof(int32_t));
+        }
+        written += sim->cullChunkKept[c];
+        tinyCount += sim->cullChunkTiny[c];
+        particle_cull_stats_add(&total, &sim->cullChunkStats[c]);
+    }
+
+    // 过小粒子按瓦片合并，聚合点接在后面（个数不超过被剔除的粒子数，不会越界）
+    int aggregates = particle_tile_merge(&sim->tileMerge, &sim->particles, alpha, cull,
+                                         sim->cullTiny, tinyCount, out + written);
+    if (aggregates > 0) {
+        written += aggregates;
+        total.aggregates += aggregates;
+        total.output += aggregates;
+    }
+    if (stats != nullptr) {
+        particle_cull_stats_add(stats, &total);
+    }
+    return written;
+}
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+    const auto *bytes = (const unsigned char *) data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+uint64_t fireworks_sim_checksum(const FireworksSim *sim) {
+    const ParticlePool *pool = &sim->particles;
+    const float *columns[] = {
+        pool->x, pool->y, pool->px, pool->py, pool->vx, pool->vy, pool->ax, pool->ay,
+        pool->r, pool->g, pool->b, pool->a, pool->size, pool->life, pool->fade, pool->shrink
+    };
+    const size_t bytes = (size_t) pool->count * sizeof(float);
+    uint64_t hash = fnv1a(0xCBF29CE484222325ULL, &pool->count, sizeof(pool->count));
+    for (const float *column : columns) {
+        hash = fnv1a(hash, column, bytes);
+    }
+    return fnv1a(hash, pool->type, (size_t) pool->count * sizeof(int32_t));
+}
@@ -0,0 +1,129 @@
+#ifndef NATIVE_ACTIVITY_FIREWORKS_SIM_H
+#define NATIVE_ACTIVITY_FIREWORKS_SIM_H
+
+#include <stdint.h>
+
+#include "frame_profiler.h"
+#include "glyph_cloud.h"
+#include "job_system.h"
+#include "particle_cull.h"
+#include "particle_forces.h"
+#include "particle_grid.h"
+#include "particle_pack.h"
+#include "particle_pool.h"
+#include "particle_random.h"
+#include "particle_spawn.h"
+
+// ---------- 烟花场景模拟 ----------
+// 火箭发射、尾迹、爆炸和 10 秒时的文字爆炸，只依赖粒子库和任务系统，不涉及 Android / EGL，
+// 设备上由 main.cpp 驱动，宿主机上由 bench/bench_fireworks 驱动。
+// 同一种子、同一步长序列下结果逐位一致（与工作线程数无关）。
+
+#define FIREWORKS_TEXT_TIME    10.0f  // 开始后多少秒触发文字爆炸
+#define FIREWORKS_EXIT_DELAY   2.0f   // 文字出现后多少秒结束
+
+// fireworks_sim_step 返回的事件位
+#define FIREWORKS_EVENT_TEXT     1   // 本步触发了文字爆炸（粒子池和发射缓冲已清空）
+#define FIREWORKS_EVENT_FINISHED 2   // 文字阶段结束，只报告一次
+
+// GPU 常驻粒子数的估计：按发射时的寿命把粒子数记到到期的时间槽（覆盖最长寿命 3 秒）
+#define FIREWORKS_GPU_EXPIRY_SLOTS 64
+#define FIREWORKS_GPU_EXPIRY_STEP  0.0625f  // 每槽秒数
+
+// 画质参数，由调用方（画质调节器）逐帧设置，默认全画质（各项为 1）
+typedef struct FireworksQuality {
+    float emission;   // 尾迹、爆炸、文字粒子数的系数
+    float cooldown;   // 火箭发射间隔的系数（大于 1 时火箭更稀疏）
+    float size;       // 新发射粒子大小的系数（影响填充）
+    int maxParticles; // 存活粒子上限（CPU 粒子池 + GPU 常驻粒子的估计），超出的发射请求丢弃；0 不限
+} FireworksQuality;
+
+// 交互：触摸点的吸引/排斥、火花（爆炸粒子）之间的碰撞、屏幕边缘反弹，默认全部关闭。
+// 碰撞需要每步重建一次均匀网格；只有吸引点时逐粒子遍历吸引点即可，不建网格
+typedef struct FireworksInteraction {
+    ParticleAttractor attractors[PARTICLE_MAX_ATTRACTORS];
+    int attractorCount;
+    float collisionRadius;     // 世界单位，0 关闭碰撞
+    float collisionStiffness;  // 完全重叠时的分离加速度
+    int bounce;                // 左右边缘和底部反弹
+    float restitution;         // 反弹后保留的法向速度比例
+} FireworksInteraction;
+
+typedef struct FireworksSim {
+    ParticlePool particles;
+    ParticleSpawnBuffer spawns;     // 本步发射请求，更新结束后统一写入粒子池
+    ParticleSpawnBuffer gpuSpawns;  // gpuResident 时除火箭外的发射请求，由调用方上传
+    JobSystem *jobs;                // 积分和顶点打包的分块并行（不归模拟所有）
+    FrameProfiler *profiler;        // 分阶段计时（发射、更新、打包、剔除），NULL 时不计时
+    int64_t profileFrame;           // 计时计入的帧号，FRAME_PROFILER_CURRENT 为当前帧（流水线模式下由 produce 设置）
+    ParticleRandom rng;             // 发射器随机数（仅调用线程使用）
+    GlyphCloud textCloud;           // 文字点云，count 为 0 时使用近似形状
+    float aspect;                   // 屏幕宽高比，决定火箭横向范围和文字缩放
+    int gpuResident;                // 非 0 时爆炸/尾迹/文字粒子写入 gpuSpawns（用 fireworks_sim_set_gpu_resident 切换）
+
+    float fireworkTimer;            // 火箭发射计时器
+    float totalTime;                // 总模拟时间
+    int   textSpawned;              // 文字是否已生成
+    float exitTimer;                // 文字阶段剩余时间
+    int   finished;                 // 是否已报告 FIREWORKS_EVENT_FINISHED
+
+    FireworksQuality quality;
+    float fieldX, fieldY;           // 全局加速度（倾斜重力/风），每步统一叠加到全部粒子，由调用方逐帧设置
+    FireworksInteraction interaction;
+    ParticleGrid grid;              // 火花碰撞的均匀网格，每步重建
+    float trailCarry;               // 尾迹数按系数缩放后的小数部分，逐步累计
+    int   cappedSpawns;             // 因存活粒子上限丢弃的发射请求数
+
+    // GPU 常驻粒子的寿命在 GPU 上，CPU 只按发射时的寿命估计存活数，供存活粒子上限使用
+    int   gpuLive;
+    int   gpuExpiry[FIREWORKS_GPU_EXPIRY_SLOTS];
+    int   gpuExpiryCursor;
+    float gpuExpiryClock;
+    int   gpuStepFirst;             // 本步开始时 gpuSpawns 中已有（尚未上传）的请求数
+
+    // 剔除阶段的临时数据（按需扩大，不随粒子逐个分配）
+    ParticleVertex *cullVertices;   // 分块打包、压实的中间顶点（不从映射的 GL 缓冲回读）
+    int32_t *cullTiny;              // 过小粒子下标，按块存放
+    int cullTinyCapacity;
+    int *cullChunkKept;             // 每块保留的顶点数
+    int *cullChunkTiny;             // 每块过小粒子数
+    ParticleCullStats *cullChunkStats;
+    int cullChunkCapacity;
+    ParticleTileMerge tileMerge;
+} FireworksSim;
+
+// 粒子池初始容量 capacity、最多扩容到 maxCapacity（大页内存区），发射缓冲预算 spawnBudget，
+// 成功返回 0，失败返回 -1
+int fireworks_sim_init(FireworksSim *sim, int capacity, int maxCapacity, int spawnBudget,
+                       JobSystem *jobs, uint64_t seed);
+void fireworks_sim_free(FireworksSim *sim);
+
+// 设置画质参数，从下一步的发射开始生效（已存在的粒子不受影响）
+void fireworks_sim_set_quality(FireworksSim *sim, const FireworksQuality *quality);
+
+// 切换 GPU 常驻模式：清空 gpuSpawns 和 GPU 存活粒子数的估计（调用方同时清空或重建 GPU 上的粒子）
+void fireworks_sim_set_gpu_resident(FireworksSim *sim, int resident);
+
+// 设置交互参数（吸引点、碰撞、反弹），从下一步开始生效
+void fireworks_sim_set_interaction(FireworksSim *sim, const FireworksInteraction *interaction);
+
+// 设置文字点云（视图需在模拟期间保持有效），传 NULL 恢复近似形状
+void fireworks_sim_set_text_cloud(FireworksSim *sim, const GlyphCloud *cloud);
+
+// 推进 dt 秒，等价于依次调用 fireworks_sim_spawn 和 fireworks_sim_update，返回事件位
+int fireworks_sim_step(FireworksSim *sim, float dt);
+// 场景时钟：计时、火箭发射和文字触发（只写发射缓冲），返回事件位
+int fireworks_sim_spawn(FireworksSim *sim, float dt);
+// 粒子积分、火箭尾迹/爆炸、移除死亡粒子，最后把发射缓冲写入粒子池
+void fireworks_sim_update(FireworksSim *sim, float dt);
+
+// 把粒子池打包成顶点（out 至少 particles.count 个），alpha 为相邻两步之间的插值比例，返回顶点数。
+// cull 非空时在打包后剔除屏幕外、过淡、过小的粒子（可选瓦片合并），顶点压实到 out 开头，
+// 本帧统计累加到 stats（可为 NULL）。临时内存分配失败时不剔除。
+int fireworks_sim_pack(FireworksSim *sim, float alpha, const ParticleCullParams *cull,
+                       ParticleVertex *out, ParticleCullStats *stats);
+
+// 粒子池当前状态的 64 位 FNV-1a 校验和（按列逐位计算，用于回归比较）
+uint64_t fireworks_sim_checksum(const FireworksSim *sim);
+
+#endif //NATIVE_ACTIVITY_FIREWORKS_SIM_H
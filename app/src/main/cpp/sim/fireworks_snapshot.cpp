@@ -0,0 +1,181 @@
+#include "fireworks_snapshot.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#if FIREWORKS_SNAPSHOT_LZ4
+#include <lz4.h>
+#endif
+
+// 场景状态，紧跟在文件头之后
+struct SnapshotState {
+    float fireworkTimer;
+    float totalTime;
+    float exitTimer;
+    float trailCarry;
+    int32_t textSpawned;
+    int32_t finished;
+    int32_t count;
+    int32_t reserved;
+    double now;
+    ParticleRandom rng;
+    int32_t expiryHeads[PARTICLE_EXPIRY_BUCKETS];
+};
+
+#define SNAPSHOT_COLUMNS 18
+
+// 快照里的列顺序，元素都是 4 字节
+static void pool_columns(const ParticlePool *pool, void *columns[SNAPSHOT_COLUMNS]) {
+    void *list[SNAPSHOT_COLUMNS] = {
+        pool->x, pool->y, pool->vx, pool->vy, pool->ax, pool->ay,
+        pool->r, pool->g, pool->b, pool->a, pool->size, pool->life, pool->fade, pool->shrink,
+        pool->type, pool->expiryNext, pool->expiryPrev, pool->expiryBucket
+    };
+    memcpy(columns, list, sizeof(list));
+}
+
+static size_t raw_size(int count) {
+    return sizeof(SnapshotState) + (size_t) count * SNAPSHOT_COLUMNS * sizeof(int32_t);
+}
+
+static uint64_t fnv1a(const void *data, size_t size) {
+    const auto *bytes = (const unsigned char *) data;
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// 场景状态和粒子列依次写入 out（raw_size 字节）
+static void write_raw(const FireworksSim *sim, unsigned char *out) {
+    const ParticlePool *pool = &sim->particles;
+    SnapshotState state;
+    memset(&state, 0, sizeof(state));
+    state.fireworkTimer = sim->fireworkTimer;
+    state.totalTime = sim->totalTime;
+    state.exitTimer = sim->exitTimer;
+    state.trailCarry = sim->trailCarry;
+    state.textSpawned = sim->textSpawned;
+    state.finished = sim->finished;
+    state.count = pool->count;
+    state.now = pool->now;
+    state.rng = sim->rng;
+    memcpy(state.expiryHeads, pool->expiryHeads, sizeof(state.expiryHeads));
+    memcpy(out, &state, sizeof(state));
+    out += sizeof(state);
+
+    void *columns[SNAPSHOT_COLUMNS];
+    pool_columns(pool, columns);
+    const size_t bytes = (size_t) pool->count * sizeof(int32_t);
+    for (void *column : columns) {
+        memcpy(out, column, bytes);
+        out += bytes;
+    }
+}
+
+size_t fireworks_snapshot_bound(const FireworksSim *sim) {
+    return sizeof(FireworksSnapshotHeader) + raw_size(sim->particles.count);
+}
+
+size_t fireworks_snapshot_save(const FireworksSim *sim, void *out, size_t capacity) {
+    const size_t rawSize = raw_size(sim->particles.count);
+    if (capacity < sizeof(FireworksSnapshotHeader) + rawSize) {
+        return 0;
+    }
+    FireworksSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = FIREWORKS_SNAPSHOT_MAGIC;
+    header.version = FIREWORKS_SNAPSHOT_VERSION;
+    header.rawSize = (uint32_t) rawSize;
+    header.storedSize = (uint32_t) rawSize;
+    unsigned char *payload = (unsigned char *) out + sizeof(header);
+
+#if FIREWORKS_SNAPSHOT_LZ4
+    // 先写到临时缓冲再压缩进 out；压缩后反而变大时按不压缩存放
+    auto *raw = (unsigned char *) malloc(rawSize);
+    if (raw == nullptr) {
+        return 0;
+    }
+    write_raw(sim, raw);
+    header.checksum = fnv1a(raw, rawSize);
+    int compressed = LZ4_compress_default((const char *) raw, (char *) payload, (int) rawSize, (int) rawSize);
+    if (compressed > 0) {
+        header.flags = FIREWORKS_SNAPSHOT_LZ4_FLAG;
+        header.storedSize = (uint32_t) compressed;
+    } else {
+        memcpy(payload, raw, rawSize);
+    }
+    free(raw);
+#else
+    write_raw(sim, payload);
+    header.checksum = fnv1a(payload, rawSize);
+#endif
+    memcpy(out, &header, sizeof(header));
+    return sizeof(header) + header.storedSize;
+}
+
+int fireworks_snapshot_load(FireworksSim *sim, const void *data, size_t size) {
+    FireworksSnapshotHeader header;
+    if (size < sizeof(header)) {
+        return -1;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != FIREWORKS_SNAPSHOT_MAGIC || header.version != FIREWORKS_SNAPSHOT_VERSION ||
+        header.storedSize > size - sizeof(header) || header.rawSize < sizeof(SnapshotState)) {
+        return -1;
+    }
+    const unsigned char *raw = (const unsigned char *) data + sizeof(header);
+    unsigned char *decompressed = nullptr;
+    if (header.flags & FIREWORKS_SNAPSHOT_LZ4_FLAG) {
+#if FIREWORKS_SNAPSHOT_LZ4
+        decompressed = (unsigned char *) malloc(header.rawSize);
+        if (decompressed == nullptr ||
+            LZ4_decompress_safe((const char *) raw, (char *) decompressed, (int) header.storedSize,
+                                (int) header.rawSize) != (int) header.rawSize) {
+            free(decompressed);
+            return -1;
+        }
+        raw = decompressed;
+#else
+        return -1;
+#endif
+    } else if (header.storedSize != header.rawSize) {
+        return -1;
+    }
+
+    int result = -1;
+    SnapshotState state;
+    memcpy(&state, raw, sizeof(state));
+    ParticlePool *pool = &sim->particles;
+    if (fnv1a(raw, header.rawSize) == header.checksum && state.count >= 0 &&
+        raw_size(state.count) == header.rawSize &&
+        particle_pool_grow(pool, state.count) >= state.count) {
+        sim->fireworkTimer = state.fireworkTimer;
+        sim->totalTime = state.totalTime;
+        sim->exitTimer = state.exitTimer;
+        sim->trailCarry = state.trailCarry;
+        sim->textSpawned = state.textSpawned;
+        sim->finished = state.finished;
+        sim->rng = state.rng;
+        pool->count = state.count;
+        pool->now = state.now;
+        memcpy(pool->expiryHeads, state.expiryHeads, sizeof(pool->expiryHeads));
+
+        void *columns[SNAPSHOT_COLUMNS];
+        pool_columns(pool, columns);
+        const size_t bytes = (size_t) state.count * sizeof(int32_t);
+        const unsigned char *in = raw + sizeof(state);
+        for (void *column : columns) {
+            memcpy(column, in, bytes);
+            in += bytes;
+        }
+        memcpy(pool->px, pool->x, bytes);
+        memcpy(pool->py, pool->y, bytes);
+        particle_spawn_reset(&sim->spawns);
+        particle_spawn_reset(&sim->gpuSpawns);
+        result = 0;
+    }
+    free(decompressed);
+    return result;
+}
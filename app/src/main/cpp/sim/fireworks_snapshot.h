@@ -0,0 +1,52 @@
+#ifndef NATIVE_ACTIVITY_FIREWORKS_SNAPSHOT_H
+#define NATIVE_ACTIVITY_FIREWORKS_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fireworks_sim.h"
+
+// ---------- 模拟快照 ----------
+// 把场景计时器、发射器随机数和粒子池的存活部分写成一段带版本号的二进制，
+// 进程重启后直接恢复，不必重新发射。格式：
+//   FireworksSnapshotHeader
+//   场景状态（计时器、随机数、粒子池时钟和过期桶头）
+//   粒子列：x y vx vy ax ay r g b a size life fade shrink type expiryNext expiryPrev expiryBucket，
+//           每列 count 个 4 字节元素，与粒子池的内存布局相同
+// 恢复时各列整段 memcpy 回粒子池（过期索引也一起恢复，之后的模拟与保存前逐位一致），
+// px/py 取当前位置，恢复后的第一帧不插值。发射缓冲不保存：快照总是在两步之间取得，此时缓冲为空。
+// gpuResident 时粒子池里只有火箭，GPU 上的粒子不在快照里。
+// 数据按本机字节序存放，只用于同一设备上的恢复。
+//
+// 编译时定义 FIREWORKS_SNAPSHOT_LZ4=1（并链接 liblz4）时对场景状态和粒子列整体做 LZ4 压缩；
+// 未开启时读到压缩快照返回失败，调用方按冷启动处理。
+
+#ifndef FIREWORKS_SNAPSHOT_LZ4
+#define FIREWORKS_SNAPSHOT_LZ4 0
+#endif
+
+#define FIREWORKS_SNAPSHOT_MAGIC   0x53535746u  // "FWSS"
+#define FIREWORKS_SNAPSHOT_VERSION 1
+
+#define FIREWORKS_SNAPSHOT_LZ4_FLAG 1
+
+typedef struct FireworksSnapshotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;        // FIREWORKS_SNAPSHOT_LZ4_FLAG
+    uint32_t rawSize;      // 解压后的数据字节数
+    uint32_t storedSize;   // 头之后实际存放的字节数
+    uint64_t checksum;     // 解压后数据的 FNV-1a
+} FireworksSnapshotHeader;
+
+// 保存 sim 所需的最大字节数（含头，按不压缩计算）
+size_t fireworks_snapshot_bound(const FireworksSim *sim);
+
+// 写入 out（至少 fireworks_snapshot_bound 字节），返回实际字节数，失败返回 0
+size_t fireworks_snapshot_save(const FireworksSim *sim, void *out, size_t capacity);
+
+// 从快照恢复到已初始化的 sim（粒子池按需扩容，存活粒子数超过最大容量时失败）。
+// 头、版本、校验和不符或压缩格式不支持时返回 -1，sim 保持不变
+int fireworks_snapshot_load(FireworksSim *sim, const void *data, size_t size);
+
+#endif //NATIVE_ACTIVITY_FIREWORKS_SNAPSHOT_H
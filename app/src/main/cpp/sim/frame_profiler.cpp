@@ -0,0 +1,89 @@
+#include "frame_profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const char *kPhaseNames[PROFILE_PHASE_COUNT] = {
+        "spawn", "update", "cull", "pack", "upload", "draw", "swap"
+};
+
+void frame_profiler_init(FrameProfiler *profiler) {
+    memset(profiler, 0, sizeof(*profiler));
+}
+
+void frame_profiler_end_frame(FrameProfiler *profiler) {
+    // 只有调用线程写帧号，读自己写的值不需要同步；其他线程的读取见 frame_profiler_add / report
+    uint32_t next = __atomic_load_n(&profiler->frame, __ATOMIC_RELAXED) + 1;
+    uint32_t *slot = profiler->ns[next & (FRAME_PROFILER_FRAMES - 1)];
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        __atomic_store_n(&slot[phase], 0u, __ATOMIC_RELAXED);
+    }
+    // 读者看到新的帧号时，本帧的数据和下一帧槽位的清零都已可见
+    __atomic_store_n(&profiler->frame, next, __ATOMIC_RELEASE);
+}
+
+const char *frame_profiler_phase_name(int phase) {
+    return phase >= 0 && phase < PROFILE_PHASE_COUNT ? kPhaseNames[phase] : "?";
+}
+
+// 升序样本的分位数（与 bench_fireworks 的取法相同：最近的秩）
+static float percentile(const uint32_t *sorted, int count, float p) {
+    int index = (int) (p * (float) (count - 1) + 0.5f);
+    return (float) sorted[index] * 1e-3f;
+}
+
+static void fill_stats(uint32_t *samples, int count, FrameProfilerStats *stats) {
+    uint64_t sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    std::sort(samples, samples + count);
+    stats->mean = (float) ((double) sum / count * 1e-3);
+    stats->p50 = percentile(samples, count, 0.50f);
+    stats->p95 = percentile(samples, count, 0.95f);
+    stats->p99 = percentile(samples, count, 0.99f);
+}
+
+int frame_profiler_report(const FrameProfiler *profiler, FrameProfilerReport *report) {
+    memset(report, 0, sizeof(*report));
+    uint32_t samples[PROFILE_PHASE_COUNT + 1][FRAME_PROFILER_FRAMES];
+
+    // 先读帧号再拷贝已完成的帧。正在累计的帧、下一次 end_frame 会清零的槽位，以及刚完成的一帧
+    // （流水线模式下模拟线程按 submit 时的帧号记账，可能还在写）不读，因此最多取 FRAME_PROFILER_FRAMES - 3 帧
+    const uint32_t first = __atomic_load_n(&profiler->frame, __ATOMIC_ACQUIRE);
+    const uint32_t completed = first > 0 ? first - 1 : 0;
+    const uint32_t available = completed < FRAME_PROFILER_FRAMES - 3 ? completed : FRAME_PROFILER_FRAMES - 3;
+    uint32_t copied[FRAME_PROFILER_FRAMES][PROFILE_PHASE_COUNT];
+    for (uint32_t k = 0; k < available; k++) {
+        const uint32_t *slot = profiler->ns[(first - 2 - k) & (FRAME_PROFILER_FRAMES - 1)];
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            copied[k][phase] = __atomic_load_n(&slot[phase], __ATOMIC_RELAXED);
+        }
+    }
+    // 拷贝期间写者又完成了若干帧时，最旧的几个槽位可能已被新帧覆盖，丢弃
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    const uint32_t last = __atomic_load_n(&profiler->frame, __ATOMIC_RELAXED);
+    const uint32_t overwritten = last - first;
+    if (overwritten >= available) {
+        return 0;
+    }
+    const int count = (int) (available - overwritten);
+    if (count == 0) {
+        return 0;
+    }
+
+    for (int k = 0; k < count; k++) {
+        uint64_t total = 0;
+        for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+            samples[phase][k] = copied[k][phase];
+            total += copied[k][phase];
+        }
+        samples[PROFILE_PHASE_COUNT][k] = total < UINT32_MAX ? (uint32_t) total : UINT32_MAX;
+    }
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        fill_stats(samples[phase], count, &report->phases[phase]);
+    }
+    fill_stats(samples[PROFILE_PHASE_COUNT], count, &report->total);
+    report->frames = count;
+    return count;
+}
@@ -0,0 +1,125 @@
+#ifndef NATIVE_ACTIVITY_FRAME_PROFILER_H
+#define NATIVE_ACTIVITY_FRAME_PROFILER_H
+
+#include <stdint.h>
+#include <time.h>
+
+// ---------- 分阶段帧耗时 ----------
+// 每帧按阶段累计 CPU 耗时（单调时钟，纳秒），帧结束时写入最近 FRAME_PROFILER_FRAMES 帧的环形缓冲。
+// 一个阶段在一帧里可以进入多次（如一帧跑两个模拟步），耗时相加。
+// 每个阶段只有一个写者线程（流水线模式下 spawn/update/cull/pack 由模拟线程写入，计入 submit 时渲染线程的帧号，
+// 即这些工作所属的那一帧；其余阶段和帧结束由渲染线程写入），读取可以在任意线程：读者拷贝后根据前后两次读到的帧号
+// 丢弃期间可能被覆盖的槽位，不加锁也不阻塞写者。
+// 每个计时区间只多两次 clock_gettime（vDSO，几十纳秒），发布版本也可以常开；
+// 编译时定义 FRAME_PROFILER_ENABLED=0 时 PROFILE_* 宏展开为空，计时代码整体去掉。
+
+#ifndef FRAME_PROFILER_ENABLED
+#define FRAME_PROFILER_ENABLED 1
+#endif
+
+#define FRAME_PROFILER_FRAMES 256  // 2 的幂
+#define FRAME_PROFILER_CURRENT (-1) // frame_profiler_add_at 等的帧号：计入当前帧
+
+enum FrameProfilerPhase {
+    PROFILE_SPAWN,    // 场景时钟与发射
+    PROFILE_UPDATE,   // 粒子积分、火箭爆炸、发射缓冲写入粒子池
+    PROFILE_CULL,     // 剔除后的顶点压实与瓦片合并（逐块的剔除判断与打包融合，计入 pack）
+    PROFILE_PACK,     // 顶点打包（含逐块剔除）
+    PROFILE_UPLOAD,   // 流式缓冲映射、解除映射
+    PROFILE_DRAW,     // 绘制调用与降分辨率合成的提交
+    PROFILE_SWAP,     // eglSwapBuffers
+    PROFILE_PHASE_COUNT
+};
+
+typedef struct FrameProfiler {
+    uint32_t ns[FRAME_PROFILER_FRAMES][PROFILE_PHASE_COUNT];  // 每帧各阶段耗时，超过 4 秒饱和
+    uint32_t frame;       // 已完成的帧数；槽位 frame % FRAME_PROFILER_FRAMES 是正在累计的帧
+} FrameProfiler;
+
+typedef struct FrameProfilerStats {
+    float mean, p50, p95, p99;  // 微秒
+} FrameProfilerStats;
+
+typedef struct FrameProfilerReport {
+    int frames;                                   // 参与统计的帧数
+    FrameProfilerStats phases[PROFILE_PHASE_COUNT];
+    FrameProfilerStats total;                     // 各阶段之和
+} FrameProfilerReport;
+
+void frame_profiler_init(FrameProfiler *profiler);
+
+static inline int64_t frame_profiler_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// 正在累计的帧号，profiler 为 NULL 时返回 0。只在调用 frame_profiler_end_frame 的线程上有意义
+static inline uint32_t frame_profiler_frame(const FrameProfiler *profiler) {
+    return profiler != NULL ? __atomic_load_n(&profiler->frame, __ATOMIC_RELAXED) : 0;
+}
+
+// 把一段耗时累加到指定帧的某个阶段（只在该阶段的写者线程调用）。frame 只能是正在累计的帧或刚完成的一帧：
+// 流水线模式下模拟线程按 submit 时的帧号记账，它的工作可能持续到渲染线程结束这一帧之后
+static inline void frame_profiler_add_at(FrameProfiler *profiler, uint32_t frame, int phase, int64_t ns) {
+    uint32_t *slot = &profiler->ns[frame & (FRAME_PROFILER_FRAMES - 1)][phase];
+    uint64_t sum = (uint64_t) __atomic_load_n(slot, __ATOMIC_RELAXED) + (uint64_t) (ns > 0 ? ns : 0);
+    __atomic_store_n(slot, sum < UINT32_MAX ? (uint32_t) sum : UINT32_MAX, __ATOMIC_RELAXED);
+}
+
+// 累加到当前帧。帧号可能由 frame_profiler_end_frame 在另一个线程发布，原子读取
+static inline void frame_profiler_add(FrameProfiler *profiler, int phase, int64_t ns) {
+    frame_profiler_add_at(profiler, __atomic_load_n(&profiler->frame, __ATOMIC_ACQUIRE), phase, ns);
+}
+
+// 结束当前帧：发布本帧数据并清空下一帧的槽位。
+// 帧号只有这一个写者：必须始终由同一个线程调用（设备上是渲染线程）
+void frame_profiler_end_frame(FrameProfiler *profiler);
+
+// 统计最近最多 FRAME_PROFILER_FRAMES - 3 帧的均值和分位数（不含刚完成、模拟线程可能仍在记账的一帧），
+// 可在任意线程调用，返回帧数
+int frame_profiler_report(const FrameProfiler *profiler, FrameProfilerReport *report);
+
+const char *frame_profiler_phase_name(int phase);
+
+#ifdef __cplusplus
+// 作用域计时：构造时取时间，析构时累加到 frame 帧（FRAME_PROFILER_CURRENT 为当前帧）的 phase。
+// profiler 为 NULL 时不计时
+struct FrameProfileScope {
+    FrameProfiler *profiler;
+    int64_t frame;
+    int phase;
+    int64_t start;
+    FrameProfileScope(FrameProfiler *p, int64_t f, int ph)
+            : profiler(p), frame(f), phase(ph), start(p != nullptr ? frame_profiler_now_ns() : 0) {}
+    ~FrameProfileScope() {
+        if (profiler == nullptr) {
+            return;
+        }
+        int64_t ns = frame_profiler_now_ns() - start;
+        if (frame == FRAME_PROFILER_CURRENT) {
+            frame_profiler_add(profiler, phase, ns);
+        } else {
+            frame_profiler_add_at(profiler, (uint32_t) frame, phase, ns);
+        }
+    }
+    FrameProfileScope(const FrameProfileScope &) = delete;
+    FrameProfileScope &operator=(const FrameProfileScope &) = delete;
+};
+#endif
+
+#define FRAME_PROFILER_CONCAT2(a, b) a##b
+#define FRAME_PROFILER_CONCAT(a, b) FRAME_PROFILER_CONCAT2(a, b)
+
+#if FRAME_PROFILER_ENABLED
+#define PROFILE_SCOPE(profiler, phase) PROFILE_SCOPE_AT(profiler, FRAME_PROFILER_CURRENT, phase)
+#define PROFILE_SCOPE_AT(profiler, frame, phase) \
+    FrameProfileScope FRAME_PROFILER_CONCAT(profileScope, __LINE__)((profiler), (frame), (phase))
+#define PROFILE_END_FRAME(profiler) frame_profiler_end_frame(profiler)
+#else
+#define PROFILE_SCOPE(profiler, phase) ((void) 0)
+#define PROFILE_SCOPE_AT(profiler, frame, phase) ((void) 0)
+#define PROFILE_END_FRAME(profiler) ((void) 0)
+#endif
+
+#endif //NATIVE_ACTIVITY_FRAME_PROFILER_H
@@ -0,0 +1,90 @@
+#include "motion_field.h"
+
+#include <cmath>
+#include <cstring>
+
+#define MOTION_MAX_GAP 0.1f  // 两个样本间隔超过此值（秒）时按此值计算，暂停后不会一步跳到新值
+
+void motion_field_init(MotionField *field, float cutoffHz, float scale, float limit) {
+    memset(field, 0, sizeof(*field));
+    field->cutoffHz = cutoffHz;
+    field->scale = scale;
+    field->limit = limit;
+}
+
+void motion_field_reset(MotionField *field) {
+    field->tail = field->head;
+    field->lastTimestamp = 0;
+    field->ax = 0.0f;
+    field->ay = 0.0f;
+}
+
+void motion_field_set_rotation(MotionField *field, int rotation) {
+    field->rotation = rotation & 3;
+}
+
+void motion_field_push(MotionField *field, const MotionSample *samples, int count) {
+    if (count <= 0) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        field->ring[field->head & (MOTION_FIELD_RING - 1)] = samples[i];
+        field->head++;
+    }
+    if (field->head - field->tail > MOTION_FIELD_RING) {
+        field->overruns += field->head - field->tail - MOTION_FIELD_RING;
+        field->tail = field->head - MOTION_FIELD_RING;
+    }
+    field->batches++;
+    if ((uint32_t) count > field->maxBatch) {
+        field->maxBatch = (uint32_t) count;
+    }
+}
+
+int motion_field_update(MotionField *field) {
+    const int consumed = (int) (field->head - field->tail);
+    if (consumed == 0) {
+        return 0;
+    }
+    const float tau = 1.0f / (2.0f * (float) M_PI * field->cutoffHz);
+    for (; field->tail != field->head; field->tail++) {
+        const MotionSample *s = &field->ring[field->tail & (MOTION_FIELD_RING - 1)];
+        if (field->lastTimestamp == 0) {
+            field->filtered[0] = s->x;
+            field->filtered[1] = s->y;
+            field->filtered[2] = s->z;
+            field->lastTimestamp = s->timestamp;
+            continue;
+        }
+        if (s->timestamp <= field->lastTimestamp) {
+            continue;
+        }
+        float dt = (float) ((s->timestamp - field->lastTimestamp) * 1e-9);
+        dt = dt < MOTION_MAX_GAP ? dt : MOTION_MAX_GAP;
+        const float k = dt / (tau + dt);
+        field->filtered[0] += (s->x - field->filtered[0]) * k;
+        field->filtered[1] += (s->y - field->filtered[1]) * k;
+        field->filtered[2] += (s->z - field->filtered[2]) * k;
+        field->lastTimestamp = s->timestamp;
+    }
+
+    // 加速度计读数是支撑力方向（静止竖直时 y = +g），重力方向取反。
+    // 设备坐标换到屏幕坐标：屏幕逆时针转 90° 时屏幕 x 是设备 -y、屏幕 y 是设备 x
+    float gx = -field->filtered[0], gy = -field->filtered[1];
+    for (int r = 0; r < field->rotation; r++) {
+        float t = gx;
+        gx = -gy;
+        gy = t;
+    }
+    // 相对竖直手持（重力为 (0, -g)）的偏移
+    float ax = gx * field->scale;
+    float ay = (gy + MOTION_FIELD_GRAVITY) * field->scale;
+    float length = sqrtf(ax * ax + ay * ay);
+    if (length > field->limit) {
+        ax *= field->limit / length;
+        ay *= field->limit / length;
+    }
+    field->ax = ax;
+    field->ay = ay;
+    return consumed;
+}
@@ -0,0 +1,56 @@
+#ifndef NATIVE_ACTIVITY_MOTION_FIELD_H
+#define NATIVE_ACTIVITY_MOTION_FIELD_H
+
+#include <stdint.h>
+
+// ---------- 加速度计驱动的全局力场 ----------
+// 传感器事件在主循环里成批取出、原样写入带时间戳的环形缓冲（不做计算）；
+// 每帧调用一次 motion_field_update，按时间戳顺序消费新样本，做一阶低通（截止频率 cutoffHz，
+// 系数按相邻样本的时间间隔计算，与事件频率无关），滤掉抖动和手晃，只留下倾斜和缓慢的摆动。
+// 输出是世界坐标（y 向上）里重力相对“竖直手持”姿态的变化量：竖直拿着时为 0，
+// 向左右倾斜时粒子向低的一侧飘（同时带一点向上的分量），平放时整体向上。模拟每步把它作为一个统一的加速度
+// 叠加到全部粒子上（CPU 积分内核和 GPU 着色器都是一个 uniform，逐粒子没有分支）。
+// 缓冲满了还没消费时丢弃最旧的样本（只影响滤波的输入，不影响输出的连续性）。
+
+#define MOTION_FIELD_RING 64  // 2 的幂，约 1 秒的 60 Hz 事件
+
+#define MOTION_FIELD_GRAVITY 9.80665f
+
+typedef struct MotionSample {
+    int64_t timestamp;  // 纳秒（传感器事件时间戳）
+    float x, y, z;      // 设备坐标系下的加速度（m/s²，含重力）
+} MotionSample;
+
+typedef struct MotionField {
+    MotionSample ring[MOTION_FIELD_RING];
+    uint32_t head;          // 写入的样本总数
+    uint32_t tail;          // 已消费的样本总数
+    int64_t lastTimestamp;  // 最近消费的样本时间戳，0 表示滤波器尚未初始化
+    float filtered[3];      // 低通后的设备坐标加速度
+    float cutoffHz;
+    float scale;            // 每 m/s² 对应的场景加速度
+    float limit;            // 输出幅值上限（场景单位）
+    int rotation;           // 屏幕相对设备自然方向逆时针旋转的 90° 次数
+    float ax, ay;           // 本帧输出（世界坐标）
+
+    uint32_t batches;       // motion_field_push 的调用次数（非空批）
+    uint32_t maxBatch;      // 单批最多样本数
+    uint32_t overruns;      // 未消费就被覆盖的样本数
+} MotionField;
+
+// cutoffHz 为低通截止频率，scale 为每 m/s² 对应的场景加速度，limit 为输出幅值上限
+void motion_field_init(MotionField *field, float cutoffHz, float scale, float limit);
+
+// 丢弃未消费的样本和滤波状态，输出归零（传感器停用后再启用时调用）
+void motion_field_reset(MotionField *field);
+
+// 设置屏幕旋转（0..3，逆时针 90° 的次数），下一次 motion_field_update 生效
+void motion_field_set_rotation(MotionField *field, int rotation);
+
+// 追加一批样本（时间戳须递增，不递增的样本在消费时跳过）
+void motion_field_push(MotionField *field, const MotionSample *samples, int count);
+
+// 消费缓冲中的全部新样本，更新 ax/ay，返回消费的样本数
+int motion_field_update(MotionField *field);
+
+#endif //NATIVE_ACTIVITY_MOTION_FIELD_H
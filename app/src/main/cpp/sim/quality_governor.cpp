@@ -0,0 +1,83 @@
+#include "quality_governor.h"
+
+#include <cstring>
+
+#define QUALITY_SMOOTHING    0.1f   // 帧耗时的指数平滑系数
+#define QUALITY_DOWN_LOAD    0.9f   // 负载高于此值开始计数降档
+#define QUALITY_UP_LOAD      0.6f   // 负载低于此值开始计数升档
+#define QUALITY_DOWN_FRAMES  20
+#define QUALITY_UP_FRAMES    180
+#define QUALITY_HOLD_FRAMES  120  // 约为爆炸粒子寿命，降档的效果要等旧粒子消亡才完全体现
+#define QUALITY_BLEND        0.05f  // 每帧向目标参数靠近的比例（约 1 秒完成过渡）
+
+// 从最低档到全画质：发射数、火箭间隔、粒子大小、存活粒子上限。
+// 上限按场景的实际粒子数定（全画质时火箭阶段约 700、文字阶段峰值 1200，见 bench_fireworks），
+// 各档都略低于该档发射系数下的文字峰值，削掉爆发时的尖峰；与粒子池的内存预算无关
+static const FireworksQuality kLevels[QUALITY_LEVELS] = {
+        {0.3f,  2.0f,  0.8f,  300},
+        {0.45f, 1.6f,  0.85f, 450},
+        {0.6f,  1.35f, 0.9f,  600},
+        {0.8f,  1.15f, 0.95f, 900},
+        {1.0f,  1.0f,  1.0f,  0},
+};
+
+void quality_level_settings(int level, FireworksQuality *quality) {
+    level = level < 0 ? 0 : (level > QUALITY_LEVEL_FULL ? QUALITY_LEVEL_FULL : level);
+    *quality = kLevels[level];
+}
+
+void quality_governor_init(QualityGovernor *governor, float refreshHz, int level) {
+    memset(governor, 0, sizeof(*governor));
+    governor->budgetMs = 1000.0f / (refreshHz > 0.0f ? refreshHz : 60.0f);
+    governor->gpuMs = -1.0f;
+    governor->holdFrames = QUALITY_HOLD_FRAMES;
+    quality_level_settings(level, &governor->current);
+    governor->level = level < 0 ? 0 : (level > QUALITY_LEVEL_FULL ? QUALITY_LEVEL_FULL : level);
+}
+
+static float blend(float current, float target) {
+    float next = current + (target - current) * QUALITY_BLEND;
+    // 足够接近时直接落到目标上，全画质时各项恰好为 1
+    float diff = next - target;
+    return diff < 1e-3f && diff > -1e-3f ? target : next;
+}
+
+int quality_governor_update(QualityGovernor *governor, float cpuMs, float gpuMs) {
+    governor->cpuMs += (cpuMs - governor->cpuMs) * QUALITY_SMOOTHING;
+    if (gpuMs >= 0.0f) {
+        governor->gpuMs = governor->gpuMs < 0.0f ? gpuMs : governor->gpuMs + (gpuMs - governor->gpuMs) * QUALITY_SMOOTHING;
+    }
+    float frameMs = governor->cpuMs > governor->gpuMs ? governor->cpuMs : governor->gpuMs;
+    governor->load = frameMs / governor->budgetMs;
+
+    int change = 0;
+    if (governor->holdFrames > 0) {
+        governor->holdFrames--;
+        governor->overFrames = 0;
+        governor->underFrames = 0;
+    } else {
+        governor->overFrames = governor->load > QUALITY_DOWN_LOAD ? governor->overFrames + 1 : 0;
+        governor->underFrames = governor->load < QUALITY_UP_LOAD ? governor->underFrames + 1 : 0;
+        if (governor->overFrames >= QUALITY_DOWN_FRAMES && governor->level > 0) {
+            change = -1;
+        } else if (governor->underFrames >= QUALITY_UP_FRAMES && governor->level < QUALITY_LEVEL_FULL) {
+            change = 1;
+        }
+        if (change != 0) {
+            governor->level += change;
+            governor->changes++;
+            governor->holdFrames = QUALITY_HOLD_FRAMES;
+            governor->overFrames = 0;
+            governor->underFrames = 0;
+        }
+    }
+
+    const FireworksQuality *target = &kLevels[governor->level];
+    FireworksQuality *current = &governor->current;
+    current->emission = blend(current->emission, target->emission);
+    current->cooldown = blend(current->cooldown, target->cooldown);
+    // 上限直接取目标档位：它只拦新的发射，已存活的粒子自然消亡，本身就是渐变的
+    current->maxParticles = target->maxParticles;
+    current->size = blend(current->size, target->size);
+    return change;
+}
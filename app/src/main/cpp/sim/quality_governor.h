@@ -0,0 +1,40 @@
+#ifndef NATIVE_ACTIVITY_QUALITY_GOVERNOR_H
+#define NATIVE_ACTIVITY_QUALITY_GOVERNOR_H
+
+#include "fireworks_sim.h"
+
+// ---------- 画质调节器 ----------
+// 闭环控制：每帧输入 CPU 和 GPU 耗时，指数平滑后取较大者与刷新周期之比作为负载。
+//   - 负载连续 QUALITY_DOWN_FRAMES 帧高于 QUALITY_DOWN_LOAD：降一档
+//   - 负载连续 QUALITY_UP_FRAMES 帧低于 QUALITY_UP_LOAD：升一档
+//   - 切换后 QUALITY_HOLD_FRAMES 帧内不再切换，等新设置产生的粒子反映到耗时上
+// 升档阈值远低于降档阈值、升档需要的持续时间更长（滞回），负载在两者之间时保持当前档位。
+// 各档对应一组 FireworksQuality，实际输出每帧向目标档位插值，粒子数和大小平滑变化。
+
+#define QUALITY_LEVELS      5
+#define QUALITY_LEVEL_FULL  (QUALITY_LEVELS - 1)
+
+typedef struct QualityGovernor {
+    float budgetMs;            // 刷新周期（毫秒）
+    float cpuMs;               // 平滑后的 CPU 帧耗时
+    float gpuMs;               // 平滑后的 GPU 帧耗时，< 0 表示没有 GPU 计时
+    float load;                // max(cpuMs, gpuMs) / budgetMs
+    int level;                 // 当前保持的档位，0 最低，QUALITY_LEVEL_FULL 为全画质
+    int overFrames;            // 连续超出降档阈值的帧数
+    int underFrames;           // 连续低于升档阈值的帧数
+    int holdFrames;            // 剩余的冷却帧数
+    int changes;               // 档位切换次数
+    FireworksQuality current;  // 本帧输出（向目标档位插值中）
+} QualityGovernor;
+
+// refreshHz 为显示刷新率，level 为起始档位。初始化后先冷却一段时间（着色器编译等启动开销不计入）
+void quality_governor_init(QualityGovernor *governor, float refreshHz, int level);
+
+// 输入本帧 CPU 耗时和 GPU 耗时（毫秒，gpuMs < 0 表示未知），更新 current。
+// 返回档位变化：-1 降档、1 升档、0 不变
+int quality_governor_update(QualityGovernor *governor, float cpuMs, float gpuMs);
+
+// 档位对应的画质参数（不插值）
+void quality_level_settings(int level, FireworksQuality *quality);
+
+#endif //NATIVE_ACTIVITY_QUALITY_GOVERNOR_H
@@ -0,0 +1,138 @@
+#include "sim_pipeline.h"
+
+#include <time.h>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <thread>
+
+struct SimPipeline {
+    SimPipelineProduce produce;
+    void *ctx;
+    SimFrame frames[2];
+    int back;            // 模拟线程正在写的一份
+    int ready;           // 最近做完的一份，-1 表示还没有
+    bool busy;           // 模拟线程手上有帧
+    bool quit;
+    std::mutex mutex;
+    std::condition_variable start;
+    std::condition_variable done;
+    std::thread thread;
+};
+
+static int64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void pipeline_main(SimPipeline *pipeline) {
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    for (;;) {
+        pipeline->start.wait(lock, [pipeline] { return pipeline->busy || pipeline->quit; });
+        if (pipeline->quit) {
+            return;
+        }
+        SimFrame *frame = &pipeline->frames[pipeline->back];
+        lock.unlock();
+        int64_t start = now_ns();
+        frame->events = 0;
+        pipeline->produce(pipeline->ctx, frame);
+        frame->produceNs = now_ns() - start;
+        lock.lock();
+        pipeline->ready = pipeline->back;
+        pipeline->busy = false;
+        pipeline->done.notify_one();
+    }
+}
+
+SimPipeline *sim_pipeline_create(SimPipelineProduce produce, void *ctx) {
+    auto *pipeline = new (std::nothrow) SimPipeline();
+    if (pipeline == nullptr) {
+        return nullptr;
+    }
+    pipeline->produce = produce;
+    pipeline->ctx = ctx;
+    pipeline->ready = -1;
+    pipeline->thread = std::thread(pipeline_main, pipeline);
+    return pipeline;
+}
+
+void sim_pipeline_destroy(SimPipeline *pipeline) {
+    if (pipeline == nullptr) {
+        return;
+    }
+    sim_pipeline_acquire(pipeline);
+    {
+        std::lock_guard<std::mutex> lock(pipeline->mutex);
+        pipeline->quit = true;
+    }
+    pipeline->start.notify_one();
+    pipeline->thread.join();
+    for (SimFrame &frame : pipeline->frames) {
+        free(frame.vertices);
+    }
+    delete pipeline;
+}
+
+int64_t sim_pipeline_acquire(SimPipeline *pipeline) {
+    int64_t start = now_ns();
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    pipeline->done.wait(lock, [pipeline] { return !pipeline->busy; });
+    return now_ns() - start;
+}
+
+void sim_pipeline_reset(SimPipeline *pipeline) {
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    pipeline->done.wait(lock, [pipeline] { return !pipeline->busy; });
+    pipeline->ready = -1;
+}
+
+const SimFrame *sim_pipeline_submit(SimPipeline *pipeline, int64_t nowNs, uint32_t frameNumber) {
+    std::unique_lock<std::mutex> lock(pipeline->mutex);
+    pipeline->done.wait(lock, [pipeline] { return !pipeline->busy; });
+    // 模拟线程改写最近做完的那一份以外的一份，做完的交给渲染线程
+    pipeline->back = pipeline->ready < 0 ? 0 : pipeline->ready ^ 1;
+    pipeline->frames[pipeline->back].inputNs = nowNs;
+    pipeline->frames[pipeline->back].frameNumber = frameNumber;
+    pipeline->busy = true;
+    pipeline->start.notify_one();
+    if (pipeline->ready < 0) {
+        // 第一帧没有可以重叠的帧，同步等它做完；下一帧开始流水（期间重复画这一帧）
+        pipeline->done.wait(lock, [pipeline] { return !pipeline->busy; });
+    }
+    return &pipeline->frames[pipeline->ready];
+}
+
+int sim_frame_reserve(SimFrame *frame, int count) {
+    if (count <= frame->vertexCapacity) {
+        return 0;
+    }
+    int capacity = frame->vertexCapacity > 0 ? frame->vertexCapacity : 1024;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    auto *vertices = (ParticleVertex *) realloc(frame->vertices, (size_t) capacity * sizeof(ParticleVertex));
+    if (vertices == nullptr) {
+        return -1;
+    }
+    frame->vertices = vertices;
+    frame->vertexCapacity = capacity;
+    return 0;
+}
+
+void sim_pipeline_stats_present(SimPipelineStats *stats, int64_t inputNs, int64_t presentNs) {
+    int64_t latency = presentNs - inputNs;
+    if (stats->frames == 0) {
+        stats->firstPresentNs = presentNs;
+    }
+    stats->frames++;
+    stats->latencyNs += latency;
+    if (latency > stats->maxLatencyNs) {
+        stats->maxLatencyNs = latency;
+    }
+    stats->lastPresentNs = presentNs;
+}
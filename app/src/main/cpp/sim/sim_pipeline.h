@@ -0,0 +1,63 @@
+#ifndef NATIVE_ACTIVITY_SIM_PIPELINE_H
+#define NATIVE_ACTIVITY_SIM_PIPELINE_H
+
+#include <stdint.h>
+
+#include "particle_pack.h"
+
+// ---------- 模拟与渲染流水线 ----------
+// 模拟线程推进第 N+1 帧（固定步长积分 + 打包顶点）的同时，渲染线程上传并绘制第 N 帧。
+// 打包结果放在两份顶点缓冲里轮换：模拟线程写一份，渲染线程读另一份，粒子池只由模拟线程访问。
+// 每帧只在一处交接：
+//   sim_pipeline_acquire  等模拟线程做完手上的帧（之后到 submit 之前，调用方可以修改模拟状态）
+//   sim_pipeline_submit   让模拟线程开始下一帧，返回上一次做完的帧供本帧绘制
+// 代价是多一帧延迟：本帧采样的输入（触摸、加速度计、经过的时间）在下一帧才画出来。
+//
+// 模拟线程接手任务系统的 0 号线程（fork/join 由它发起），渲染线程在流水线期间不再使用任务系统。
+
+typedef struct SimFrame {
+    ParticleVertex *vertices;   // 打包好的顶点（由 produce 写入，容量不足时用 sim_frame_reserve 扩大）
+    int vertexCount;
+    int vertexCapacity;
+    int events;                 // produce 自定义的事件位（如场景的 FIREWORKS_EVENT_*）
+    int64_t inputNs;            // submit 的时间：本帧输入的采样时刻
+    uint32_t frameNumber;       // submit 时渲染线程的帧号（frame_profiler），produce 的分阶段耗时计入这一帧
+    int64_t produceNs;          // produce 的耗时
+} SimFrame;
+
+// 产出一帧：在模拟线程上调用，只能访问模拟状态和 frame
+typedef void (*SimPipelineProduce)(void *ctx, SimFrame *frame);
+
+typedef struct SimPipeline SimPipeline;
+
+// 启动模拟线程，失败返回 NULL
+SimPipeline *sim_pipeline_create(SimPipelineProduce produce, void *ctx);
+// 等待手上的帧做完后停止线程并释放两份顶点缓冲
+void sim_pipeline_destroy(SimPipeline *pipeline);
+
+// 等模拟线程空闲，返回等待的纳秒数。可重复调用，没有进行中的帧时立即返回
+int64_t sim_pipeline_acquire(SimPipeline *pipeline);
+// 等模拟线程空闲并丢弃做完的帧（模拟状态在流水线之外被推进或替换过），下一次 submit 同步做一帧
+void sim_pipeline_reset(SimPipeline *pipeline);
+// 开始下一帧并返回上一次做完的帧，直到下一次 submit 之前有效。frameNumber 原样交给 produce（SimFrame::frameNumber）。
+// 第一次调用（或 reset 之后）还没有做完的帧，先同步等这一帧做完
+const SimFrame *sim_pipeline_submit(SimPipeline *pipeline, int64_t nowNs, uint32_t frameNumber);
+
+// 保证 frame 至少能放 count 个顶点，内存不足返回 -1
+int sim_frame_reserve(SimFrame *frame, int count);
+
+// ---------- 延迟与吞吐统计 ----------
+// 串行和流水线两种模式共用，便于对比
+typedef struct SimPipelineStats {
+    int64_t frames;
+    int64_t latencyNs;      // 输入采样到交换缓冲完成，累计
+    int64_t maxLatencyNs;
+    int64_t waitNs;         // 渲染线程等模拟的时间（串行模式下即模拟 + 打包本身），累计
+    int64_t produceNs;      // 模拟 + 打包的耗时，累计
+    int64_t firstPresentNs; // 第一帧和最近一帧交换完成的时刻，算帧率
+    int64_t lastPresentNs;
+} SimPipelineStats;
+
+void sim_pipeline_stats_present(SimPipelineStats *stats, int64_t inputNs, int64_t presentNs);
+
+#endif //NATIVE_ACTIVITY_SIM_PIPELINE_H
@@ -0,0 +1,195 @@
+// 把字符串光栅化成文字点云资源（.gpc，格式见 particles/glyph_cloud.h）
+// 用法：glyph_cloud_tool <字体文件> <UTF-8 文字> <输出.gpc> [点数=1200] [像素大小=128] [种子=1]
+// 每个覆盖像素按覆盖率加权，独立采样 点数 次（像素内再均匀抖动），
+// 方向取从所属字形包围盒中心指向采样点的单位向量。
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "glyph_cloud.h"
+
+struct CoveredPixel {
+    int x, y;        // y 向上
+    float weight;
+    int glyph;
+};
+
+struct GlyphBox {
+    int minX, minY, maxX, maxY;
+};
+
+static uint64_t rng_state;
+
+static float next_float() {
+    // splitmix64
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (float) (z >> 40) * (1.0f / 16777216.0f);
+}
+
+static std::vector<uint32_t> decode_utf8(const char *text) {
+    std::vector<uint32_t> codepoints;
+    const auto *s = (const unsigned char *) text;
+    while (*s) {
+        uint32_t cp;
+        int extra;
+        if (*s < 0x80) {
+            cp = *s;
+            extra = 0;
+        } else if ((*s & 0xE0) == 0xC0) {
+            cp = *s & 0x1F;
+            extra = 1;
+        } else if ((*s & 0xF0) == 0xE0) {
+            cp = *s & 0x0F;
+            extra = 2;
+        } else {
+            cp = *s & 0x07;
+            extra = 3;
+        }
+        s++;
+        for (int i = 0; i < extra && (*s & 0xC0) == 0x80; i++, s++) {
+            cp = (cp << 6) | (*s & 0x3F);
+        }
+        codepoints.push_back(cp);
+    }
+    return codepoints;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <font> <text> <out.gpc> [points=1200] [pixel size=128] [seed=1]\n", argv[0]);
+        return 1;
+    }
+    const char *fontPath = argv[1];
+    const char *outPath = argv[3];
+    int points = argc > 4 ? atoi(argv[4]) : 1200;
+    int pixelSize = argc > 5 ? atoi(argv[5]) : 128;
+    rng_state = argc > 6 ? strtoull(argv[6], nullptr, 10) : 1;
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library) != 0 || FT_New_Face(library, fontPath, 0, &face) != 0) {
+        fprintf(stderr, "cannot load font %s\n", fontPath);
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(face, 0, pixelSize);
+
+    // 逐字排版并收集覆盖像素
+    std::vector<CoveredPixel> pixels;
+    std::vector<GlyphBox> boxes;
+    int penX = 0;
+    for (uint32_t cp : decode_utf8(argv[2])) {
+        if (FT_Get_Char_Index(face, cp) == 0) {
+            fprintf(stderr, "warning: U+%04X not in font\n", cp);
+        }
+        if (FT_Load_Char(face, cp, FT_LOAD_RENDER) != 0) {
+            continue;
+        }
+        const FT_GlyphSlot slot = face->glyph;
+        const FT_Bitmap &bitmap = slot->bitmap;
+        GlyphBox box = {1 << 30, 1 << 30, -(1 << 30), -(1 << 30)};
+        int glyph = (int) boxes.size();
+        for (unsigned row = 0; row < bitmap.rows; row++) {
+            for (unsigned col = 0; col < bitmap.width; col++) {
+                unsigned char coverage = bitmap.buffer[row * bitmap.pitch + col];
+                if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+                    coverage = (bitmap.buffer[row * bitmap.pitch + col / 8] & (0x80 >> (col % 8))) ? 255 : 0;
+                }
+                if (coverage == 0) {
+                    continue;
+                }
+                int x = penX + slot->bitmap_left + (int) col;
+                int y = slot->bitmap_top - (int) row;
+                pixels.push_back({x, y, coverage / 255.0f, glyph});
+                box.minX = x < box.minX ? x : box.minX;
+                box.minY = y < box.minY ? y : box.minY;
+                box.maxX = x > box.maxX ? x : box.maxX;
+                box.maxY = y > box.maxY ? y : box.maxY;
+            }
+        }
+        boxes.push_back(box);
+        penX += (int) (slot->advance.x >> 6);
+    }
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+    if (pixels.empty() || points <= 0) {
+        fprintf(stderr, "nothing to sample\n");
+        return 1;
+    }
+
+    // 整段文字包围盒：高度归一化为 1，中心移到原点
+    int minX = pixels[0].x, maxX = minX, minY = pixels[0].y, maxY = minY;
+    std::vector<double> cumulative(pixels.size());
+    double total = 0.0;
+    for (size_t i = 0; i < pixels.size(); i++) {
+        const CoveredPixel &p = pixels[i];
+        minX = p.x < minX ? p.x : minX;
+        maxX = p.x > maxX ? p.x : maxX;
+        minY = p.y < minY ? p.y : minY;
+        maxY = p.y > maxY ? p.y : maxY;
+        total += p.weight;
+        cumulative[i] = total;
+    }
+    const float centerX = (minX + maxX + 1) * 0.5f;
+    const float centerY = (minY + maxY + 1) * 0.5f;
+    const float scale = 1.0f / (float) (maxY - minY + 1);
+
+    std::vector<float> columns((size_t) points * 5);
+    float *x = columns.data(), *y = x + points, *dx = y + points, *dy = dx + points, *weight = dy + points;
+    for (int i = 0; i < points; i++) {
+        double target = next_float() * total;
+        size_t lo = 0, hi = pixels.size() - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (cumulative[mid] <= target) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        const CoveredPixel &p = pixels[lo];
+        const GlyphBox &box = boxes[p.glyph];
+        float px = p.x + next_float();
+        float py = p.y + next_float();
+        float ox = px - (box.minX + box.maxX + 1) * 0.5f;
+        float oy = py - (box.minY + box.maxY + 1) * 0.5f;
+        float length = sqrtf(ox * ox + oy * oy);
+        if (length < 1e-3f) {
+            float angle = next_float() * 6.2831853f;
+            ox = cosf(angle);
+            oy = sinf(angle);
+            length = 1.0f;
+        }
+        x[i] = (px - centerX) * scale;
+        y[i] = (py - centerY) * scale;
+        dx[i] = ox / length;
+        dy[i] = oy / length;
+        weight[i] = p.weight;
+    }
+
+    GlyphCloudHeader header = {};
+    header.magic = GLYPH_CLOUD_MAGIC;
+    header.version = GLYPH_CLOUD_VERSION;
+    header.headerSize = sizeof(GlyphCloudHeader);
+    header.count = (uint32_t) points;
+    header.extentX = (maxX - minX + 1) * 0.5f * scale;
+    header.extentY = 0.5f;
+
+    FILE *out = fopen(outPath, "wb");
+    if (out == nullptr || fwrite(&header, sizeof(header), 1, out) != 1 ||
+        fwrite(columns.data(), sizeof(float), columns.size(), out) != columns.size()) {
+        fprintf(stderr, "cannot write %s\n", outPath);
+        return 1;
+    }
+    fclose(out);
+    printf("%s: %zu glyphs, %zu covered pixels, %d points, extent %.3f x %.3f, %zu bytes\n", outPath,
+           boxes.size(), pixels.size(), points, header.extentX * 2.0f, header.extentY * 2.0f,
+           sizeof(header) + columns.size() * sizeof(float));
+    return 0;
+}
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include "glfm.h"
 #include "file_compat.h"
+#include "render/program_cache.h"
 
 #define FILE_COMPAT_ANDROID_ACTIVITY glfmGetAndroidActivity(display)
 
@@ -265,6 +266,7 @@ static const uint8_t FONT_DATA[FONT_CHAR_COUNT][FONT_CHAR_HEIGHT] = {
 };
 
 typedef struct {
+    ProgramCache programCache;
     GLuint program;
     GLuint vertexArray;
     GLuint positionBuffer;
@@ -279,6 +281,12 @@ typedef struct {
     size_t consoleLineCount;
     size_t consoleCol;
 
+    // Screen lines whose texCoords are stale. Only these are rebuilt and uploaded in onDraw.
+    bool lineDirty[CONSOLE_MAX_LINES];
+    size_t drawnCursorCol;
+    bool drawnCursorVisible;
+    double shownSafeBottom;
+
     size_t bottomSpacingRequested;
     size_t bottomSpacingActual;
 
@@ -345,11 +353,31 @@ static size_t convertCodePointToUTF8(uint32_t codePoint, char *utf8) {
     }
 }
 
+// Marks console lines [first, end) as dirty. Line 0 is the line with the cursor, which is drawn
+// bottomSpacingActual lines above the bottom of the screen.
+static void consoleMarkLinesDirty(TypingApp *app, size_t first, size_t end) {
+    for (size_t line = first; line < end; line++) {
+        size_t screenLine = line + app->bottomSpacingActual;
+        if (screenLine >= CONSOLE_MAX_LINES) {
+            break;
+        }
+        app->lineDirty[screenLine] = true;
+    }
+}
+
+static void consoleMarkAllDirty(TypingApp *app) {
+    for (size_t screenLine = 0; screenLine < CONSOLE_MAX_LINES; screenLine++) {
+        app->lineDirty[screenLine] = true;
+    }
+}
+
 static void consoleNewline(TypingApp *app) {
     app->cursorBlinkStartTime = glfmGetTime();
     if (app->consoleLineCount < CONSOLE_MAX_LINES) {
         app->consoleLineCount++;
     }
+    // Scroll: every visible line moves up one
+    consoleMarkLinesDirty(app, 0, app->consoleLineCount);
     app->consoleLineFirst = (app->consoleLineFirst + CONSOLE_MAX_LINES - 1) % CONSOLE_MAX_LINES;
     app->consoleCol = 0;
     memset(app->console[app->consoleLineFirst], 0, CONSOLE_COLS * sizeof(app->console[0][0]));
@@ -360,7 +388,10 @@ static void consoleBackspace(TypingApp *app) {
     if (app->consoleLineCount > 0) {
         if (app->consoleCol > 0) {
             app->console[app->consoleLineFirst][--app->consoleCol] = 0;
+            consoleMarkLinesDirty(app, 0, 1);
         } else if (app->consoleLineCount > 1) {
+            // Scroll back: every visible line moves down one
+            consoleMarkLinesDirty(app, 0, app->consoleLineCount);
             app->consoleLineFirst = (app->consoleLineFirst + 1) % CONSOLE_MAX_LINES;
             app->consoleLineCount--;
             app->consoleCol = CONSOLE_COLS - 1;
@@ -379,6 +410,7 @@ static void consolePrint(TypingApp *app, const char *utf8) {
         app->consoleCol = 0;
         memset(app->console[app->consoleLineFirst], 0, CONSOLE_COLS * sizeof(app->console[0][0]));
     }
+    consoleMarkLinesDirty(app, 0, 1);
     size_t bytesRead;
     uint32_t codePoint;
     while ((bytesRead = convertUTF8ToCodePoint(utf8, &codePoint)) != 0) {
@@ -427,6 +459,7 @@ static void consoleCopy(TypingApp *app, char *buffer, size_t bufferSize) {
 }
 
 static void consoleClear(TypingApp *app) {
+    consoleMarkLinesDirty(app, 0, app->consoleLineCount);
     app->consoleLineCount = 0;
     consolePrint(app, "");
 }
@@ -539,12 +572,12 @@ static bool onKey(GLFMDisplay *display, GLFMKeyCode keyCode, GLFMKeyAction actio
     }
 }
 
-static GLuint compileShader(GLFMDisplay *display, GLenum type, const char *shaderName) {
+// Returns the shader source from the resources directory. The caller frees it.
+static char *readShader(GLFMDisplay *display, const char *shaderName) {
     char fullPath[PATH_MAX];
     fc_resdir(fullPath, sizeof(fullPath));
     strncat(fullPath, shaderName, sizeof(fullPath) - strlen(fullPath) - 1);
 
-    // Get shader string
     char *shaderString = NULL;
     FILE *shaderFile = fopen(fullPath, "rb");
     if (shaderFile) {
@@ -561,35 +594,8 @@ static GLuint compileShader(GLFMDisplay *display, GLenum type, const char *shade
     }
     if (!shaderString) {
         printf("Couldn't read file: %s\n", fullPath);
-        return 0;
     }
-
-    // Compile
-    const char *constShaderString = shaderString;
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &constShaderString, NULL);
-    glCompileShader(shader);
-    free(shaderString);
-
-    // Check compile status
-    GLint status;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
-    if (status == 0) {
-        printf("Couldn't compile shader: %s\n", shaderName);
-        GLint logLength;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
-        if (logLength > 0) {
-            GLchar *log = malloc(logLength);
-            glGetShaderInfoLog(shader, logLength, &logLength, log);
-            if (log[0] != 0) {
-                printf("Shader log: %s\n", log);
-            }
-            free(log);
-        }
-        glDeleteShader(shader);
-        shader = 0;
-    }
-    return shader;
+    return shaderString;
 }
 
 static void onFocus(GLFMDisplay *display, bool focused) {
@@ -617,25 +623,24 @@ static void onSurfaceCreatedOrResized(GLFMDisplay *display, int width, int heigh
         }
     }
 
-    // Create shader
+    // Create shader. The linked program is cached, so recreating the surface skips compiling.
     if (app->program == 0) {
-        GLuint vertShader = compileShader(display, GL_VERTEX_SHADER, "texture.vert");
-        GLuint fragShader = compileShader(display, GL_FRAGMENT_SHADER, "texture.frag");
-        if (vertShader == 0 || fragShader == 0) {
+        static const char *const attributes[] = { "position", "texCoord" };
+        char cacheDir[PATH_MAX];
+        fc_cachedir("glfm_typing", cacheDir, sizeof(cacheDir));
+        program_cache_init(&app->programCache, cacheDir);
+
+        char *vertSource = readShader(display, "texture.vert");
+        char *fragSource = readShader(display, "texture.frag");
+        if (vertSource && fragSource) {
+            app->program = program_cache_link(&app->programCache, "texture", vertSource, fragSource,
+                                              NULL, attributes, 2);
+        }
+        free(vertSource);
+        free(fragSource);
+        if (app->program == 0) {
             return;
         }
-        app->program = glCreateProgram();
-
-        glAttachShader(app->program, vertShader);
-        glAttachShader(app->program, fragShader);
-
-        glBindAttribLocation(app->program, 0, "position");
-        glBindAttribLocation(app->program, 1, "texCoord");
-
-        glLinkProgram(app->program);
-
-        glDeleteShader(vertShader);
-        glDeleteShader(fragShader);
     }
 
     // Create font texture
@@ -737,6 +742,7 @@ static void onSurfaceCreatedOrResized(GLFMDisplay *display, int width, int heigh
 
 static void onSurfaceDestroyed(GLFMDisplay *display) {
     TypingApp *app = glfmGetUserData(display);
+    program_cache_log(&app->programCache);
     app->program = 0;
     app->vertexArray = 0;
     app->positionBuffer = 0;
@@ -745,63 +751,100 @@ static void onSurfaceDestroyed(GLFMDisplay *display) {
     app->texture = 0;
 }
 
+// Writes the texCoords of one screen line from the console model.
+static void consoleBuildLine(TypingApp *app, size_t screenLine, bool cursorVisible) {
+    GLfloat *texCoords = app->texCoords + screenLine * CONSOLE_COLS * 4 * 2;
+    size_t i = 0;
+    for (size_t col = 0; col < CONSOLE_COLS; col++) {
+        uint32_t codePoint = ' ';
+        if (screenLine >= app->bottomSpacingActual) {
+            size_t line = screenLine - app->bottomSpacingActual;
+            if (line < app->consoleLineCount) {
+                if (line == 0 && col == app->consoleCol) {
+                    codePoint = cursorVisible ? '_' : ' ';
+                } else {
+                    codePoint = app->console[(app->consoleLineFirst + line) % CONSOLE_MAX_LINES][col];
+                    if (codePoint < FONT_CHAR_FIRST || codePoint >= FONT_CHAR_FIRST + FONT_CHAR_COUNT) {
+                        codePoint = ' ';
+                    }
+                }
+            }
+        }
+        size_t charIndex = codePoint - FONT_CHAR_FIRST;
+        size_t charX = charIndex % TEXTURE_CHARS_X;
+        size_t charY = charIndex / TEXTURE_CHARS_X;
+        float spaceU = 1.0f / (TEXTURE_CHARS_X * (FONT_CHAR_WIDTH + TEXTURE_SPACING));
+        float spaceV = 1.0f / (TEXTURE_CHARS_Y * (FONT_CHAR_HEIGHT + TEXTURE_SPACING));
+        float u0 = (float)(charX + 0) / TEXTURE_CHARS_X;
+        float v0 = (float)(charY + 0) / TEXTURE_CHARS_Y;
+        float u1 = (float)(charX + 1) / TEXTURE_CHARS_X - spaceU;
+        float v1 = (float)(charY + 1) / TEXTURE_CHARS_Y - spaceV;
+        texCoords[i++] = u0; texCoords[i++] = v0;
+        texCoords[i++] = u1; texCoords[i++] = v0;
+        texCoords[i++] = u0; texCoords[i++] = v1;
+        texCoords[i++] = u1; texCoords[i++] = v1;
+    }
+}
+
 static void onDraw(GLFMDisplay *display) {
     TypingApp *app = glfmGetUserData(display);
     double frameTime = glfmGetTime();
 
-    char buffy[128];
+    // Show the bottom inset. Reprinted only when it changes, so idle frames leave the console clean.
     double bottom = 0.0;
     glfmGetDisplayChromeInsets(display, NULL, NULL, &bottom, NULL);
-    snprintf(buffy, sizeof(buffy), "safeBottom %g", bottom);
-    consoleClear(app);
-    consolePrint(app, buffy);
+    if (bottom != app->shownSafeBottom) {
+        char buffy[128];
+        snprintf(buffy, sizeof(buffy), "safeBottom %g", bottom);
+        consoleClear(app);
+        consolePrint(app, buffy);
+        app->shownSafeBottom = bottom;
+    }
 
     // Animate hidden lines
     if (app->bottomSpacingActual != app->bottomSpacingRequested) {
         app->bottomSpacingActual += (app->bottomSpacingRequested > app->bottomSpacingActual) ? 1 : -1;
         app->cursorBlinkStartTime = frameTime;
+        consoleMarkAllDirty(app);
     }
 
-    // Create texCoord buffer
-    size_t i = 0;
-    for (size_t screenLine = 0; screenLine < CONSOLE_MAX_LINES; screenLine++) {
-        for (size_t col = 0; col < CONSOLE_COLS; col++) {
-            uint32_t codePoint = ' ';
-            if (screenLine >= app->bottomSpacingActual) {
-                size_t line = screenLine - app->bottomSpacingActual;
-                if (line < app->consoleLineCount) {
-                    if (line == 0 && col == app->consoleCol) {
-                        const double cursorBlinkDuration = 0.5;
-                        double blink = fmod(frameTime - app->cursorBlinkStartTime, cursorBlinkDuration * 2);
-                        codePoint = (app->focused && blink <= cursorBlinkDuration) ? '_' : ' ';
-                    } else {
-                        codePoint = app->console[(app->consoleLineFirst + line) % CONSOLE_MAX_LINES][col];
-                        if (codePoint < FONT_CHAR_FIRST || codePoint >= FONT_CHAR_FIRST + FONT_CHAR_COUNT) {
-                            codePoint = ' ';
-                        }
-                    }
-                }
-            }
-            size_t charIndex = codePoint - FONT_CHAR_FIRST;
-            size_t charX = charIndex % TEXTURE_CHARS_X;
-            size_t charY = charIndex / TEXTURE_CHARS_X;
-            float spaceU = 1.0f / (TEXTURE_CHARS_X * (FONT_CHAR_WIDTH + TEXTURE_SPACING));
-            float spaceV = 1.0f / (TEXTURE_CHARS_Y * (FONT_CHAR_HEIGHT + TEXTURE_SPACING));
-            float u0 = (float)(charX + 0) / TEXTURE_CHARS_X;
-            float v0 = (float)(charY + 0) / TEXTURE_CHARS_Y;
-            float u1 = (float)(charX + 1) / TEXTURE_CHARS_X - spaceU;
-            float v1 = (float)(charY + 1) / TEXTURE_CHARS_Y - spaceV;
-            app->texCoords[i++] = u0; app->texCoords[i++] = v0;
-            app->texCoords[i++] = u1; app->texCoords[i++] = v0;
-            app->texCoords[i++] = u0; app->texCoords[i++] = v1;
-            app->texCoords[i++] = u1; app->texCoords[i++] = v1;
-        }
+    // Cursor blink only touches the cursor line
+    const double cursorBlinkDuration = 0.5;
+    double blink = fmod(frameTime - app->cursorBlinkStartTime, cursorBlinkDuration * 2);
+    bool cursorVisible = app->focused && blink <= cursorBlinkDuration;
+    if (cursorVisible != app->drawnCursorVisible || app->consoleCol != app->drawnCursorCol) {
+        consoleMarkLinesDirty(app, 0, 1);
+        app->drawnCursorVisible = cursorVisible;
+        app->drawnCursorCol = app->consoleCol;
     }
+
+    // Create texCoord buffer (contents are uploaded below, so every line starts dirty)
     if (app->texCoordBuffer == 0) {
         glGenBuffers(1, &app->texCoordBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, app->texCoordBuffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(app->texCoords), NULL, GL_DYNAMIC_DRAW);
+        consoleMarkAllDirty(app);
+    }
+
+    // Rebuild dirty lines and upload each run of adjacent dirty lines with one glBufferSubData.
+    // Nothing is rebuilt or uploaded when no line changed.
+    const size_t lineFloats = CONSOLE_COLS * 4 * 2;
+    size_t screenLine = 0;
+    while (screenLine < CONSOLE_MAX_LINES) {
+        if (!app->lineDirty[screenLine]) {
+            screenLine++;
+            continue;
+        }
+        size_t runFirst = screenLine;
+        for (; screenLine < CONSOLE_MAX_LINES && app->lineDirty[screenLine]; screenLine++) {
+            consoleBuildLine(app, screenLine, cursorVisible);
+            app->lineDirty[screenLine] = false;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, app->texCoordBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(GLfloat) * lineFloats * runFirst,
+                        sizeof(GLfloat) * lineFloats * (screenLine - runFirst),
+                        app->texCoords + lineFloats * runFirst);
     }
-    glBindBuffer(GL_ARRAY_BUFFER, app->texCoordBuffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(app->texCoords), app->texCoords, GL_DYNAMIC_DRAW);
 
     // Draw background
     int width, height;
@@ -839,6 +882,7 @@ void glfmMain(GLFMDisplay *display) {
                          GLFMDepthFormatNone,
                          GLFMStencilFormatNone,
                          GLFMMultisampleNone);
+    app->shownSafeBottom = -1.0;
     glfmSetUserData(display, app);
     glfmSetAppFocusFunc(display, onFocus);
     glfmSetSurfaceCreatedFunc(display, onSurfaceCreatedOrResized);